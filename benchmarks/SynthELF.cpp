@@ -0,0 +1,695 @@
+//===- SynthELF.cpp -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// mcld-synth writes synthetic ELF64 relocatable objects (and optionally a GNU
+// archive of them) whose size is controlled by a handful of knobs: the number
+// of objects, functions per object, call relocations per function, duplicated
+// COMDAT groups and .eh_frame entries. The output is deterministic for a given
+// set of options, so the same workload can be regenerated on every commit.
+//
+//===----------------------------------------------------------------------===//
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/ELF.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+using namespace llvm;
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Command line options
+//===----------------------------------------------------------------------===//
+cl::opt<std::string> OptArch("arch",
+                             cl::desc("Target: x86_64 or aarch64"),
+                             cl::init("x86_64"));
+
+cl::opt<unsigned> OptObjects("objects",
+                             cl::desc("Number of objects"),
+                             cl::init(16));
+
+cl::opt<unsigned> OptFunctions("functions",
+                               cl::desc("Functions per object"),
+                               cl::init(64));
+
+cl::opt<unsigned> OptRelocs("relocs",
+                            cl::desc("Call relocations per function"),
+                            cl::init(4));
+
+cl::opt<unsigned> OptComdats(
+    "comdats",
+    cl::desc("COMDAT groups duplicated in each object"),
+    cl::init(0));
+
+cl::opt<bool> OptEhFrame("eh-frame",
+                         cl::desc("Emit one .eh_frame FDE per function"),
+                         cl::init(false));
+
+cl::opt<unsigned> OptNameLength("name-length",
+                                cl::desc("Minimum length of symbol names"),
+                                cl::init(24));
+
+cl::opt<std::string> OptPrefix("prefix",
+                               cl::desc("Prefix of file and symbol names"),
+                               cl::init("synth"));
+
+cl::opt<std::string> OptArchive("archive",
+                                cl::desc("Pack the objects into this archive "
+                                         "instead of writing them one by one"),
+                                cl::init(""));
+
+cl::opt<std::string> OptOutputDir("output-dir",
+                                  cl::desc("Directory of the outputs"),
+                                  cl::init("."));
+
+cl::opt<unsigned> OptSeed("seed",
+                          cl::desc("Seed of the call graph"),
+                          cl::init(1));
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+/// Random - a small deterministic generator (xorshift), independent of libc.
+class Random {
+ public:
+  explicit Random(uint32_t pSeed) : m_State(pSeed * 2654435761U + 1) {}
+
+  uint32_t next(uint32_t pBound) {
+    m_State ^= m_State << 13;
+    m_State ^= m_State >> 17;
+    m_State ^= m_State << 5;
+    return m_State % pBound;
+  }
+
+ private:
+  uint32_t m_State;
+};
+
+/// ByteBuffer - little-endian serialization.
+class ByteBuffer {
+ public:
+  void append8(uint8_t pValue) { m_Data.push_back(pValue); }
+
+  void append16(uint16_t pValue) {
+    append8(pValue);
+    append8(pValue >> 8);
+  }
+
+  void append32(uint32_t pValue) {
+    append16(pValue);
+    append16(pValue >> 16);
+  }
+
+  void append64(uint64_t pValue) {
+    append32(pValue);
+    append32(pValue >> 32);
+  }
+
+  void append(const void* pData, size_t pSize) {
+    const uint8_t* data = static_cast<const uint8_t*>(pData);
+    m_Data.insert(m_Data.end(), data, data + pSize);
+  }
+
+  void append(const ByteBuffer& pOther) {
+    m_Data.insert(m_Data.end(), pOther.m_Data.begin(), pOther.m_Data.end());
+  }
+
+  void align(size_t pAlign, uint8_t pFill = 0) {
+    while (m_Data.size() % pAlign != 0)
+      m_Data.push_back(pFill);
+  }
+
+  void put32(size_t pOffset, uint32_t pValue) {
+    for (int i = 0; i < 4; ++i)
+      m_Data[pOffset + i] = (pValue >> (8 * i)) & 0xff;
+  }
+
+  size_t size() const { return m_Data.size(); }
+
+  const uint8_t* data() const { return m_Data.data(); }
+
+ private:
+  std::vector<uint8_t> m_Data;
+};
+
+struct Target {
+  uint16_t machine;
+  uint32_t call_reloc;    ///< call to a global function
+  int64_t call_addend;
+  uint32_t call_size;     ///< size of the call instruction
+  uint32_t call_offset;   ///< offset of the relocated field in the call
+  uint32_t abs64_reloc;
+  uint32_t prel32_reloc;
+  uint8_t ra_register;    ///< DWARF return address register
+};
+
+const Target& getTarget(StringRef pArch) {
+  static const Target x86_64 = {
+    ELF::EM_X86_64, ELF::R_X86_64_PLT32, -4, 5, 1,
+    ELF::R_X86_64_64, ELF::R_X86_64_PC32, 16
+  };
+  static const Target aarch64 = {
+    ELF::EM_AARCH64, ELF::R_AARCH64_CALL26, 0, 4, 0,
+    ELF::R_AARCH64_ABS64, ELF::R_AARCH64_PREL32, 30
+  };
+  return (pArch == "aarch64") ? aarch64 : x86_64;
+}
+
+//===----------------------------------------------------------------------===//
+// ObjectFile - an ELF64 relocatable object under construction
+//===----------------------------------------------------------------------===//
+class ObjectFile {
+ public:
+  struct Section {
+    std::string name;
+    uint32_t type;
+    uint64_t flags;
+    uint32_t link;
+    uint32_t info;
+    uint64_t align;
+    uint64_t entsize;
+    ByteBuffer data;
+  };
+
+ public:
+  explicit ObjectFile(const Target& pTarget)
+      : m_Target(pTarget), m_NumSymbols(0), m_FirstGlobal(1) {
+    addSection("", ELF::SHT_NULL, 0, 0);
+    m_StrTab.append8(0);
+    // the null symbol
+    addSymbol("", 0, 0, 0, 0);
+  }
+
+  unsigned int addSection(const std::string& pName,
+                          uint32_t pType,
+                          uint64_t pFlags,
+                          uint64_t pAlign,
+                          uint64_t pEntSize = 0) {
+    Section section;
+    section.name = pName;
+    section.type = pType;
+    section.flags = pFlags;
+    section.link = 0;
+    section.info = 0;
+    section.align = pAlign;
+    section.entsize = pEntSize;
+    m_Sections.push_back(section);
+    return m_Sections.size() - 1;
+  }
+
+  Section& section(unsigned int pIndex) { return m_Sections[pIndex]; }
+
+  /// addSymbol - local symbols must be added before all the global ones.
+  unsigned int addSymbol(const std::string& pName,
+                         uint8_t pInfo,
+                         uint16_t pShndx,
+                         uint64_t pValue,
+                         uint64_t pSize) {
+    uint32_t name = 0;
+    if (!pName.empty()) {
+      name = m_StrTab.size();
+      m_StrTab.append(pName.data(), pName.size());
+      m_StrTab.append8(0);
+    }
+    m_SymTab.append32(name);
+    m_SymTab.append8(pInfo);
+    m_SymTab.append8(0);
+    m_SymTab.append16(pShndx);
+    m_SymTab.append64(pValue);
+    m_SymTab.append64(pSize);
+    if ((pInfo >> 4) == ELF::STB_LOCAL)
+      m_FirstGlobal = m_NumSymbols + 1;
+    return m_NumSymbols++;
+  }
+
+  void addRela(unsigned int pRelaSection,
+               uint64_t pOffset,
+               unsigned int pSymbol,
+               uint32_t pType,
+               int64_t pAddend) {
+    ByteBuffer& data = m_Sections[pRelaSection].data;
+    data.append64(pOffset);
+    data.append64((static_cast<uint64_t>(pSymbol) << 32) | pType);
+    data.append64(pAddend);
+  }
+
+  void write(ByteBuffer& pOut) {
+    unsigned int symtab = addSection(".symtab", ELF::SHT_SYMTAB, 0, 8, 24);
+    unsigned int strtab = addSection(".strtab", ELF::SHT_STRTAB, 0, 1);
+    unsigned int shstrtab = addSection(".shstrtab", ELF::SHT_STRTAB, 0, 1);
+    m_Sections[symtab].data.append(m_SymTab);
+    m_Sections[symtab].link = strtab;
+    m_Sections[symtab].info = m_FirstGlobal;
+    m_Sections[strtab].data.append(m_StrTab);
+
+    std::vector<uint32_t> names;
+    ByteBuffer& shstr = m_Sections[shstrtab].data;
+    std::map<std::string, uint32_t> name_offsets;
+    for (size_t i = 0; i < m_Sections.size(); ++i) {
+      const std::string& name = m_Sections[i].name;
+      if (name.empty()) {
+        if (shstr.size() == 0)
+          shstr.append8(0);
+        names.push_back(0);
+        continue;
+      }
+      std::map<std::string, uint32_t>::iterator it = name_offsets.find(name);
+      if (it == name_offsets.end()) {
+        it = name_offsets.insert(std::make_pair(name, shstr.size())).first;
+        shstr.append(name.data(), name.size());
+        shstr.append8(0);
+      }
+      names.push_back(it->second);
+    }
+
+    // relocation and group sections refer to the symbol table
+    for (size_t i = 0; i < m_Sections.size(); ++i) {
+      if (m_Sections[i].type == ELF::SHT_RELA ||
+          m_Sections[i].type == ELF::SHT_GROUP)
+        m_Sections[i].link = symtab;
+    }
+
+    // layout: header, section contents, section header table
+    ByteBuffer body;
+    std::vector<uint64_t> offsets(m_Sections.size(), 0);
+    for (size_t i = 1; i < m_Sections.size(); ++i) {
+      body.align(m_Sections[i].align == 0 ? 1 : m_Sections[i].align);
+      offsets[i] = sizeof(ELF::Elf64_Ehdr) + body.size();
+      body.append(m_Sections[i].data);
+    }
+    body.align(8);
+    uint64_t shoff = sizeof(ELF::Elf64_Ehdr) + body.size();
+
+    static const uint8_t ident[ELF::EI_NIDENT] = {
+      0x7f, 'E', 'L', 'F', ELF::ELFCLASS64, ELF::ELFDATA2LSB, ELF::EV_CURRENT
+    };
+    pOut.append(ident, sizeof(ident));
+    pOut.append16(ELF::ET_REL);
+    pOut.append16(m_Target.machine);
+    pOut.append32(ELF::EV_CURRENT);
+    pOut.append64(0);      // e_entry
+    pOut.append64(0);      // e_phoff
+    pOut.append64(shoff);  // e_shoff
+    pOut.append32(0);      // e_flags
+    pOut.append16(sizeof(ELF::Elf64_Ehdr));
+    pOut.append16(0);      // e_phentsize
+    pOut.append16(0);      // e_phnum
+    pOut.append16(sizeof(ELF::Elf64_Shdr));
+    pOut.append16(m_Sections.size());
+    pOut.append16(shstrtab);
+    pOut.append(body);
+
+    for (size_t i = 0; i < m_Sections.size(); ++i) {
+      const Section& sect = m_Sections[i];
+      pOut.append32(names[i]);
+      pOut.append32(sect.type);
+      pOut.append64(sect.flags);
+      pOut.append64(0);  // sh_addr
+      pOut.append64(offsets[i]);
+      pOut.append64(sect.data.size());
+      pOut.append32(sect.link);
+      pOut.append32(sect.info);
+      pOut.append64(sect.align);
+      pOut.append64(sect.entsize);
+    }
+  }
+
+ private:
+  const Target& m_Target;
+  std::vector<Section> m_Sections;
+  ByteBuffer m_SymTab;
+  ByteBuffer m_StrTab;
+  unsigned int m_NumSymbols;
+  unsigned int m_FirstGlobal;
+};
+
+//===----------------------------------------------------------------------===//
+// Workload
+//===----------------------------------------------------------------------===//
+std::string functionName(unsigned int pObject, unsigned int pFunction) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%s_o%u_f%u_",
+                OptPrefix.c_str(), pObject, pFunction);
+  std::string name(buf);
+  // pad like a mangled C++ name; the tail keeps names of equal length
+  // distinct in their last bytes, which is where hash functions differ
+  while (name.size() < OptNameLength)
+    name += static_cast<char>('a' + (name.size() + pObject + pFunction) % 26);
+  return name;
+}
+
+std::string comdatName(unsigned int pGroup) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%s_inline%u", OptPrefix.c_str(), pGroup);
+  return buf;
+}
+
+uint32_t functionSize(const Target& pTarget, unsigned int pCalls) {
+  uint32_t size = pCalls * pTarget.call_size + 4;
+  return (size + 15) & ~15U;
+}
+
+void emitCall(const Target& pTarget, ByteBuffer& pText) {
+  if (pTarget.machine == ELF::EM_X86_64) {
+    pText.append8(0xe8);  // call rel32
+    pText.append32(0);
+  } else {
+    pText.append32(0x94000000);  // bl
+  }
+}
+
+void emitReturn(const Target& pTarget, ByteBuffer& pText, uint32_t pEnd) {
+  if (pTarget.machine == ELF::EM_X86_64) {
+    pText.append8(0xc3);  // ret
+    while (pText.size() < pEnd)
+      pText.append8(0x90);  // nop
+  } else {
+    pText.append32(0xd65f03c0);  // ret
+    while (pText.size() < pEnd)
+      pText.append32(0xd503201f);  // nop
+  }
+}
+
+/// emitCIE - a CIE with 'zR' augmentation and pc-relative sdata4 pointers.
+void emitCIE(const Target& pTarget, ByteBuffer& pEh) {
+  size_t start = pEh.size();
+  pEh.append32(0);  // length, patched below
+  pEh.append32(0);  // CIE id
+  pEh.append8(1);   // version
+  pEh.append("zR", 3);
+  pEh.append8(1);     // code alignment factor
+  pEh.append8(0x78);  // data alignment factor (-8)
+  pEh.append8(pTarget.ra_register);
+  pEh.append8(1);     // augmentation data length
+  pEh.append8(0x1b);  // DW_EH_PE_pcrel | DW_EH_PE_sdata4
+  if (pTarget.machine == ELF::EM_X86_64) {
+    pEh.append8(0x0c);  // DW_CFA_def_cfa: rsp + 8
+    pEh.append8(7);
+    pEh.append8(8);
+    pEh.append8(0x90);  // DW_CFA_offset: rip at cfa - 8
+    pEh.append8(1);
+  } else {
+    pEh.append8(0x0c);  // DW_CFA_def_cfa: sp + 0
+    pEh.append8(31);
+    pEh.append8(0);
+  }
+  pEh.align(8);  // DW_CFA_nop
+  pEh.put32(start, pEh.size() - start - 4);
+}
+
+/// buildObject - build object pIndex of the workload.
+void buildObject(const Target& pTarget,
+                 unsigned int pIndex,
+                 ByteBuffer& pOut,
+                 std::vector<std::string>& pDefined) {
+  ObjectFile obj(pTarget);
+  Random random(OptSeed * 7919 + pIndex);
+
+  unsigned int text = obj.addSection(".text",
+                                     ELF::SHT_PROGBITS,
+                                     ELF::SHF_ALLOC | ELF::SHF_EXECINSTR,
+                                     16);
+  unsigned int rela_text =
+      obj.addSection(".rela.text", ELF::SHT_RELA, 0, 8, 24);
+  obj.section(rela_text).info = text;
+
+  unsigned int data = obj.addSection(".data",
+                                     ELF::SHT_PROGBITS,
+                                     ELF::SHF_ALLOC | ELF::SHF_WRITE,
+                                     8);
+  unsigned int rela_data =
+      obj.addSection(".rela.data", ELF::SHT_RELA, 0, 8, 24);
+  obj.section(rela_data).info = data;
+
+  unsigned int eh_frame = 0, rela_eh_frame = 0;
+  if (OptEhFrame) {
+    eh_frame = obj.addSection(".eh_frame", ELF::SHT_PROGBITS, ELF::SHF_ALLOC,
+                              8);
+    rela_eh_frame = obj.addSection(".rela.eh_frame", ELF::SHT_RELA, 0, 8, 24);
+    obj.section(rela_eh_frame).info = eh_frame;
+  }
+
+  // COMDAT groups: the same inline functions appear in every object
+  std::vector<unsigned int> comdat_sections;
+  for (unsigned int g = 0; g < OptComdats; ++g) {
+    unsigned int group =
+        obj.addSection(".group", ELF::SHT_GROUP, 0, 4, 4);
+    unsigned int member = obj.addSection(
+        ".text." + comdatName(g),
+        ELF::SHT_PROGBITS,
+        ELF::SHF_ALLOC | ELF::SHF_EXECINSTR | ELF::SHF_GROUP,
+        16);
+    obj.section(group).data.append32(ELF::GRP_COMDAT);
+    obj.section(group).data.append32(member);
+    emitReturn(pTarget, obj.section(member).data, 16);
+    comdat_sections.push_back(group);
+    comdat_sections.push_back(member);
+  }
+
+  // local symbols
+  unsigned int text_sym =
+      obj.addSymbol("", ELF::STT_SECTION, text, 0, 0);
+
+  // defined functions
+  uint32_t fn_size = functionSize(pTarget, OptRelocs);
+  std::vector<unsigned int> fn_syms;
+  for (unsigned int f = 0; f < OptFunctions; ++f) {
+    std::string name = functionName(pIndex, f);
+    fn_syms.push_back(obj.addSymbol(name,
+                                    (ELF::STB_GLOBAL << 4) | ELF::STT_FUNC,
+                                    text,
+                                    f * fn_size,
+                                    fn_size));
+    pDefined.push_back(name);
+  }
+
+  std::vector<unsigned int> comdat_syms;
+  for (unsigned int g = 0; g < OptComdats; ++g) {
+    unsigned int member = comdat_sections[2 * g + 1];
+    unsigned int sym = obj.addSymbol(comdatName(g),
+                                     (ELF::STB_WEAK << 4) | ELF::STT_FUNC,
+                                     member,
+                                     0,
+                                     16);
+    obj.section(comdat_sections[2 * g]).info = sym;
+    comdat_syms.push_back(sym);
+    pDefined.push_back(comdatName(g));
+  }
+
+  // function bodies: calls into random functions of the workload
+  std::map<std::string, unsigned int> undefs;
+  ByteBuffer& code = obj.section(text).data;
+  for (unsigned int f = 0; f < OptFunctions; ++f) {
+    for (unsigned int c = 0; c < OptRelocs; ++c) {
+      unsigned int sym;
+      if (c == 0 && !comdat_syms.empty()) {
+        sym = comdat_syms[f % comdat_syms.size()];
+      } else {
+        unsigned int to_obj = random.next(OptObjects);
+        unsigned int to_fn = random.next(OptFunctions);
+        if (to_obj == pIndex) {
+          sym = fn_syms[to_fn];
+        } else {
+          std::string name = functionName(to_obj, to_fn);
+          std::map<std::string, unsigned int>::iterator it = undefs.find(name);
+          if (it == undefs.end()) {
+            unsigned int idx = obj.addSymbol(name, ELF::STB_GLOBAL << 4,
+                                             ELF::SHN_UNDEF, 0, 0);
+            it = undefs.insert(std::make_pair(name, idx)).first;
+          }
+          sym = it->second;
+        }
+      }
+      obj.addRela(rela_text, code.size() + pTarget.call_offset, sym,
+                  pTarget.call_reloc, pTarget.call_addend);
+      emitCall(pTarget, code);
+    }
+    emitReturn(pTarget, code, (f + 1) * fn_size);
+  }
+
+  // a table of function pointers
+  for (unsigned int f = 0; f < OptFunctions; ++f) {
+    obj.addRela(rela_data, obj.section(data).data.size(), fn_syms[f],
+                pTarget.abs64_reloc, 0);
+    obj.section(data).data.append64(0);
+  }
+
+  // one FDE per function
+  if (OptEhFrame) {
+    ByteBuffer& eh = obj.section(eh_frame).data;
+    emitCIE(pTarget, eh);
+    for (unsigned int f = 0; f < OptFunctions; ++f) {
+      eh.append32(20);               // length
+      eh.append32(eh.size());        // CIE pointer, back to offset 0
+      obj.addRela(rela_eh_frame, eh.size(), text_sym, pTarget.prel32_reloc,
+                  f * fn_size);
+      eh.append32(0);                // pc begin
+      eh.append32(fn_size);          // pc range
+      eh.append8(0);                 // augmentation data length
+      eh.align(8);
+    }
+  }
+
+  obj.write(pOut);
+}
+
+/// buildStart - the entry object: _start calls the first function of the
+/// first object, and the rest of the workload is reached from there.
+void buildStart(const Target& pTarget, ByteBuffer& pOut) {
+  ObjectFile obj(pTarget);
+  unsigned int text = obj.addSection(".text",
+                                     ELF::SHT_PROGBITS,
+                                     ELF::SHF_ALLOC | ELF::SHF_EXECINSTR,
+                                     16);
+  unsigned int rela_text =
+      obj.addSection(".rela.text", ELF::SHT_RELA, 0, 8, 24);
+  obj.section(rela_text).info = text;
+
+  uint32_t size = functionSize(pTarget, 1);
+  obj.addSymbol("_start", (ELF::STB_GLOBAL << 4) | ELF::STT_FUNC, text, 0,
+                size);
+  unsigned int callee = obj.addSymbol(functionName(0, 0),
+                                      ELF::STB_GLOBAL << 4,
+                                      ELF::SHN_UNDEF, 0, 0);
+  ByteBuffer& code = obj.section(text).data;
+  obj.addRela(rela_text, pTarget.call_offset, callee, pTarget.call_reloc,
+              pTarget.call_addend);
+  emitCall(pTarget, code);
+  emitReturn(pTarget, code, size);
+  obj.write(pOut);
+}
+
+//===----------------------------------------------------------------------===//
+// Archive - a GNU archive with a symbol table
+//===----------------------------------------------------------------------===//
+void appendMemberHeader(ByteBuffer& pOut,
+                        const std::string& pName,
+                        size_t pSize) {
+  char header[61];
+  std::snprintf(header, sizeof(header), "%-16s%-12u%-6u%-6u%-8o%-10zu`\n",
+                pName.c_str(), 0U, 0U, 0U, 0644U, pSize);
+  pOut.append(header, 60);
+}
+
+void appendBE32(ByteBuffer& pOut, uint32_t pValue) {
+  pOut.append8(pValue >> 24);
+  pOut.append8(pValue >> 16);
+  pOut.append8(pValue >> 8);
+  pOut.append8(pValue);
+}
+
+struct Member {
+  std::string name;
+  ByteBuffer data;
+  std::vector<std::string> symbols;
+};
+
+void buildArchive(const std::vector<Member>& pMembers, ByteBuffer& pOut) {
+  size_t num_symbols = 0, names_size = 0;
+  for (size_t i = 0; i < pMembers.size(); ++i) {
+    num_symbols += pMembers[i].symbols.size();
+    for (size_t s = 0; s < pMembers[i].symbols.size(); ++s)
+      names_size += pMembers[i].symbols[s].size() + 1;
+  }
+
+  size_t symtab_size = 4 + 4 * num_symbols + names_size;
+  size_t first_member = 8 + 60 + symtab_size + (symtab_size & 1);
+
+  // offsets of the member headers
+  std::vector<uint32_t> offsets;
+  size_t offset = first_member;
+  for (size_t i = 0; i < pMembers.size(); ++i) {
+    offsets.push_back(offset);
+    offset += 60 + pMembers[i].data.size();
+    offset += offset & 1;
+  }
+
+  pOut.append("!<arch>\n", 8);
+  appendMemberHeader(pOut, "/", symtab_size);
+  appendBE32(pOut, num_symbols);
+  for (size_t i = 0; i < pMembers.size(); ++i) {
+    for (size_t s = 0; s < pMembers[i].symbols.size(); ++s)
+      appendBE32(pOut, offsets[i]);
+  }
+  for (size_t i = 0; i < pMembers.size(); ++i) {
+    for (size_t s = 0; s < pMembers[i].symbols.size(); ++s) {
+      const std::string& name = pMembers[i].symbols[s];
+      pOut.append(name.c_str(), name.size() + 1);
+    }
+  }
+  pOut.align(2, '\n');
+
+  for (size_t i = 0; i < pMembers.size(); ++i) {
+    appendMemberHeader(pOut, pMembers[i].name + "/", pMembers[i].data.size());
+    pOut.append(pMembers[i].data);
+    pOut.align(2, '\n');
+  }
+}
+
+bool writeFile(const std::string& pPath, const ByteBuffer& pData) {
+  FILE* file = std::fopen(pPath.c_str(), "wb");
+  if (file == NULL) {
+    std::fprintf(stderr, "mcld-synth: cannot open `%s'\n", pPath.c_str());
+    return false;
+  }
+  size_t written = std::fwrite(pData.data(), 1, pData.size(), file);
+  std::fclose(file);
+  return written == pData.size();
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  cl::ParseCommandLineOptions(argc, argv, "MCLinker synthetic ELF workloads\n");
+
+  if (OptArch != "x86_64" && OptArch != "aarch64") {
+    std::fprintf(stderr, "mcld-synth: unsupported arch `%s'\n",
+                 OptArch.c_str());
+    return 1;
+  }
+  if (OptObjects == 0 || OptFunctions == 0) {
+    std::fprintf(stderr, "mcld-synth: --objects and --functions must be "
+                         "positive\n");
+    return 1;
+  }
+
+  const Target& target = getTarget(OptArch);
+  const std::string dir = OptOutputDir + "/";
+
+  ByteBuffer start;
+  buildStart(target, start);
+  if (!writeFile(dir + OptPrefix + "_start.o", start))
+    return 1;
+
+  std::vector<Member> members(OptObjects);
+  for (unsigned int i = 0; i < OptObjects; ++i) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%u.o", i);
+    // archive member names must fit in the 16 bytes of the header
+    members[i].name = name;
+    buildObject(target, i, members[i].data, members[i].symbols);
+    if (OptArchive.empty() &&
+        !writeFile(dir + OptPrefix + "_" + members[i].name, members[i].data))
+      return 1;
+  }
+
+  if (!OptArchive.empty()) {
+    ByteBuffer archive;
+    buildArchive(members, archive);
+    if (!writeFile(dir + OptArchive, archive))
+      return 1;
+  }
+  return 0;
+}
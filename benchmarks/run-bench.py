@@ -0,0 +1,264 @@
+#!/usr/bin/env python
+#===- run-bench.py ---------------------------------------------------------===#
+#
+#                     The MCLinker Project
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generate synthetic workloads with mcld-synth, link them with ld.mcld
+# --time-trace, and report the median time of the interesting phases.
+#
+# Results can be appended to a JSON-lines history file (--record) and compared
+# against an earlier record (--baseline) to spot regressions across commits.
+#
+#===------------------------------------------------------------------------===#
+from __future__ import print_function
+
+import argparse
+import datetime
+import glob
+import json
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+TRIPLES = {
+    'x86_64': 'x86_64-linux-gnu',
+    'aarch64': 'aarch64-linux-gnu',
+}
+
+# report label -> names of the --time-trace events summed into it
+PHASES = [
+    ('namepool', ['readSymbols', 'internNames']),
+    ('archive', ['readArchive', 'readArchives']),
+    ('merge', ['mergeSections']),
+    ('scan', ['scanRelocations']),
+    ('apply', ['relocation']),
+    ('gnuhash', ['emitGNUHashTab']),
+    ('write', ['writeObject']),
+    ('total', ['Linker::emulate', 'Linker::normalize', 'Linker::resolve',
+               'Linker::layout', 'Linker::emit']),
+]
+
+
+class Workload(object):
+    """A set of mcld-synth inputs and the links that are timed on them."""
+
+    def __init__(self, name, synth_args, links):
+        self.name = name
+        self.synth_args = synth_args
+        # [(link name, output kind, inputs as glob patterns)]
+        self.links = links
+
+
+def make_workloads(scale):
+    n = lambda base: str(base * scale)
+    return [
+        Workload('objects',
+                 ['--objects=' + n(64), '--functions=256', '--relocs=8'],
+                 [('exec', 'exec', ['synth_start.o', 'synth_[0-9]*.o'])]),
+        Workload('archive',
+                 ['--objects=' + n(256), '--functions=64', '--relocs=4',
+                  '--archive=libsynth.a'],
+                 [('exec', 'exec', ['synth_start.o', 'libsynth.a'])]),
+        Workload('shared',
+                 ['--objects=' + n(64), '--functions=512', '--relocs=4',
+                  '--name-length=48'],
+                 [('dso', 'shared', ['synth_[0-9]*.o']),
+                  ('exec', 'exec', ['synth_start.o', 'libsynth.so'])]),
+        Workload('comdat',
+                 ['--objects=' + n(64), '--functions=64', '--relocs=4',
+                  '--comdats=256'],
+                 [('exec', 'exec', ['synth_start.o', 'synth_[0-9]*.o'])]),
+        Workload('ehframe',
+                 ['--objects=' + n(64), '--functions=256', '--relocs=4',
+                  '--eh-frame'],
+                 [('exec', 'exec', ['synth_start.o', 'synth_[0-9]*.o'])]),
+    ]
+
+
+def expand(directory, patterns):
+    files = []
+    for pattern in patterns:
+        matched = sorted(glob.glob(os.path.join(directory, pattern)))
+        if not matched:
+            # produced by an earlier link of the same workload
+            matched = [os.path.join(directory, pattern)]
+        files.extend(matched)
+    return files
+
+
+def phase_times(trace_file):
+    with open(trace_file) as f:
+        events = json.load(f)['traceEvents']
+    result = {}
+    for label, names in PHASES:
+        result[label] = sum(e['dur'] for e in events
+                            if e['name'] in names) / 1000.0
+    return result
+
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2:
+        return values[mid]
+    return (values[mid - 1] + values[mid]) / 2.0
+
+
+def run_link(args, arch, workdir, kind, inputs, output, threads):
+    trace = output + '.time-trace.json'
+    cmd = [args.linker, '-mtriple=' + TRIPLES[arch], '-o', output,
+           '--time-trace-file=' + trace, '--threads=%d' % threads,
+           '--hash-style=gnu']
+    if kind == 'shared':
+        cmd.append('-shared')
+    cmd.extend(inputs)
+
+    start = time.time()
+    with open(os.devnull, 'w') as devnull:
+        status = subprocess.call(cmd, cwd=workdir, stderr=devnull)
+    elapsed = (time.time() - start) * 1000.0
+    if status != 0:
+        raise RuntimeError('link failed: ' + ' '.join(cmd))
+
+    times = phase_times(trace)
+    times['process'] = elapsed
+    return times
+
+
+def run(args):
+    results = []
+    for arch in args.arch:
+        for workload in make_workloads(args.scale):
+            if args.workloads and workload.name not in args.workloads:
+                continue
+            # start afresh so that no input of an earlier scale is picked up
+            workdir = os.path.join(args.work_dir, arch, workload.name)
+            if os.path.isdir(workdir):
+                shutil.rmtree(workdir)
+            os.makedirs(workdir)
+            subprocess.check_call([args.synth, '--arch=' + arch,
+                                   '--output-dir=' + workdir] +
+                                  workload.synth_args)
+
+            for link, kind, patterns in workload.links:
+                inputs = expand(workdir, patterns)
+                output = os.path.join(workdir,
+                                      'libsynth.so' if kind == 'shared'
+                                      else 'a.out')
+                for threads in args.threads:
+                    samples = [run_link(args, arch, workdir, kind, inputs,
+                                        output, threads)
+                               for _ in range(args.repeat)]
+                    row = {'arch': arch,
+                           'workload': workload.name + '/' + link,
+                           'threads': threads}
+                    for label in samples[0]:
+                        row[label] = median([s[label] for s in samples])
+                    results.append(row)
+                    print_row(row)
+    return results
+
+
+def key_of(row):
+    return (row['arch'], row['workload'], row['threads'])
+
+
+COLUMNS = [label for label, _ in PHASES] + ['process']
+
+
+def print_header():
+    print('%-8s %-16s %3s ' % ('arch', 'workload', 'thr') +
+          ' '.join('%9s' % c for c in COLUMNS))
+
+
+def print_row(row, baseline=None):
+    cells = []
+    for c in COLUMNS:
+        cell = '%9.1f' % row[c]
+        if baseline is not None and baseline.get(c):
+            delta = (row[c] - baseline[c]) * 100.0 / baseline[c]
+            cell = '%+8.1f%%' % delta
+        cells.append(cell)
+    print('%-8s %-16s %3d ' % (row['arch'], row['workload'],
+                               row['threads']) + ' '.join(cells))
+
+
+def load_baseline(path):
+    with open(path) as f:
+        lines = [l for l in f if l.strip()]
+    if not lines:
+        return {}
+    record = json.loads(lines[-1])
+    return dict((key_of(row), row) for row in record['results'])
+
+
+def git_revision():
+    try:
+        here = os.path.dirname(os.path.abspath(__file__))
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'],
+                                       cwd=here).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Time the link phases of ld.mcld on synthetic inputs.")
+    parser.add_argument('--linker', required=True, help='path to ld.mcld')
+    parser.add_argument('--synth', required=True, help='path to mcld-synth')
+    parser.add_argument('--work-dir', default='bench-work',
+                        help='where the workloads are generated')
+    parser.add_argument('--arch', default='x86_64,aarch64',
+                        type=lambda s: s.split(','),
+                        help='comma separated targets')
+    parser.add_argument('--workloads', default='',
+                        type=lambda s: [w for w in s.split(',') if w],
+                        help='comma separated subset of the workloads')
+    parser.add_argument('--threads', default='1',
+                        type=lambda s: [int(t) for t in s.split(',')],
+                        help='comma separated --threads values')
+    parser.add_argument('--scale', default=1, type=int,
+                        help='multiplier of the number of objects')
+    parser.add_argument('--repeat', default=3, type=int,
+                        help='links per measurement; the median is reported')
+    parser.add_argument('--record', help='append the results to this '
+                        'JSON-lines history file')
+    parser.add_argument('--baseline', help='compare against the last record '
+                        'of this history file')
+    args = parser.parse_args()
+
+    for arch in args.arch:
+        if arch not in TRIPLES:
+            parser.error('unsupported arch: ' + arch)
+
+    print('times in ms (median of %d)' % args.repeat)
+    print_header()
+    results = run(args)
+
+    if args.baseline:
+        baseline = load_baseline(args.baseline)
+        print('\nchange against ' + args.baseline)
+        print_header()
+        for row in results:
+            if key_of(row) in baseline:
+                print_row(row, baseline[key_of(row)])
+
+    if args.record:
+        record = {'revision': git_revision(),
+                  'date': datetime.datetime.utcnow().isoformat(),
+                  'scale': args.scale,
+                  'results': results}
+        with open(args.record, 'a') as f:
+            f.write(json.dumps(record, sort_keys=True) + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -9,9 +9,14 @@
 #ifndef MCLD_ADT_HASHBASE_H_
 #define MCLD_ADT_HASHBASE_H_
 
+#include "mcld/ADT/HashGroup.h"
+
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
 
+#include <cassert>
 #include <cstdlib>
+#include <cstring>
 
 namespace mcld {
 
@@ -44,7 +49,13 @@ class HashBucket {
  *
  *  HashTableImpl uses open-addressing, linear probing hash table.
  *  linear probing hash table obviously has high performance when the
- *  load factor is less than 0.7.
+ *  load factor is less than 0.7. The number of buckets is always a power of
+ *  two and doubles when the table grows.
+ *
+ *  Besides the buckets, HashTableImpl keeps a control byte per bucket, see
+ *  HashGroup. Lookups probe the control bytes a group at a time, so that
+ *  most of the occupied buckets are skipped without reading the bucket or
+ *  dereferencing its entry.
  *  The drawback is that the number of the stored items can notbe more
  *  than the size of the hash table.
  *
@@ -93,23 +104,53 @@ class HashTableImpl {
   /// initialize the hash table.
   void init(unsigned int pInitSize);
 
+  /// allocate - allocate pNumOfBuckets empty buckets
+  void allocate(unsigned int pNumOfBuckets);
+
+  /// setControl - set the control byte of bucket pIndex
+  void setControl(unsigned int pIndex, uint8_t pByte);
+
   void clear();
 
   /// lookUpBucketFor - search the index of bucket whose key is p>ey
-  //  @return the index of the found bucket
-  unsigned int lookUpBucketFor(const key_type& pKey);
+  //  @return the index of the found bucket. If pKey is not in the table, the
+  //  returned free bucket is claimed for pKey and the caller must fill it.
+  unsigned int lookUpBucketFor(const key_type& pKey) {
+    return lookUpBucketFor(pKey, m_Hasher(pKey));
+  }
+
+  /// lookUpBucketFor - the same, with pFullHash, the hash value of pKey
+  unsigned int lookUpBucketFor(const key_type& pKey, unsigned int pFullHash);
 
   /// findKey - finds an element with key pKey
   //  return the index of the element, or -1 when the element does not exist.
-  int findKey(const key_type& pKey) const;
+  int findKey(const key_type& pKey) const {
+    return findKey(pKey, m_Hasher(pKey));
+  }
+
+  /// findKey - the same, with pFullHash, the hash value of pKey
+  int findKey(const key_type& pKey, unsigned int pFullHash) const;
+
+  /// markDeleted - turn the bucket pIndex into a tombstone. The caller
+  /// destroys its entry.
+  void markDeleted(unsigned int pIndex);
 
   /// mayRehash - check the load_factor, compute the new size, and then doRehash
   void mayRehash();
 
+  /// reserve - grow the table to hold pNumOfEntries entries without
+  /// rehashing.
+  void reserve(unsigned int pNumOfEntries);
+
   /// doRehash - re-new the hash table, and rehash all elements into the new
-  /// buckets
+  /// buckets. pNewSize must be a power of two.
   void doRehash(unsigned int pNewSize);
 
+  /// bucketIndex - the home bucket of the hash value pFullHash
+  unsigned int bucketIndex(unsigned int pFullHash) const {
+    return pFullHash & (m_NumOfBuckets - 1);
+  }
+
   friend class ChainIteratorBase<Self>;
   friend class ChainIteratorBase<const Self>;
   friend class EntryIteratorBase<Self>;
@@ -118,6 +159,9 @@ class HashTableImpl {
  protected:
   // Array of Buckets
   bucket_type* m_Buckets;
+  // Control bytes of the buckets, followed by a copy of the first
+  // HashGroup::Width - 1 of them
+  uint8_t* m_Control;
   unsigned int m_NumOfBuckets;
   unsigned int m_NumOfEntries;
   unsigned int m_NumOfTombstones;
@@ -10,23 +10,19 @@
 //===----------------------------------------------------------------------===//
 // internal non-member functions
 //===----------------------------------------------------------------------===//
+/// compute_bucket_count - the smallest power of two greater than
+/// pNumOfBuckets, and at least a HashGroup wide. Growing by a factor keeps the
+/// total cost of rehashing linear in the number of entries, and lets the index
+/// of a hash value be computed by masking instead of division.
 inline static unsigned int compute_bucket_count(unsigned int pNumOfBuckets) {
-  static const unsigned int bucket_size[] = {
-      1,     3,     17,    37,    67,    97,     197,
-      419,   977,   2593,  4099,  8209,  12289,  16411,
-      20483, 32771, 49157, 65537, 98317, 131101, 196613};
-
-  const unsigned int buckets_count =
-      sizeof(bucket_size) / sizeof(bucket_size[0]);
-  unsigned int idx = 0;
-  do {
-    if (pNumOfBuckets < bucket_size[idx]) {
-      return bucket_size[idx];
-    }
-    ++idx;
-  } while (idx < buckets_count);
-
-  return (pNumOfBuckets + 131101);  // rare case. increase constantly
+  const unsigned int max_bucket_count = 1U << 31;
+  if (pNumOfBuckets >= max_bucket_count)
+    return max_bucket_count;
+
+  unsigned int result = HashGroup::Width;
+  while (result <= pNumOfBuckets)
+    result <<= 1;
+  return result;
 }
 
 //===----------------------------------------------------------------------===//
@@ -52,6 +48,7 @@ HashBucket<DataType>::getTombstone() {
 template <typename HashEntryTy, typename HashFunctionTy>
 HashTableImpl<HashEntryTy, HashFunctionTy>::HashTableImpl()
     : m_Buckets(0),
+      m_Control(0),
       m_NumOfBuckets(0),
       m_NumOfEntries(0),
       m_NumOfTombstones(0),
@@ -68,6 +65,7 @@ HashTableImpl<HashEntryTy, HashFunctionTy>::HashTableImpl(
   }
 
   m_Buckets = 0;
+  m_Control = 0;
   m_NumOfBuckets = 0;
   m_NumOfEntries = 0;
   m_NumOfTombstones = 0;
@@ -87,103 +85,148 @@ bool HashTableImpl<HashEntryTy, HashFunctionTy>::empty() const {
 /// init - initialize the hash table.
 template <typename HashEntryTy, typename HashFunctionTy>
 void HashTableImpl<HashEntryTy, HashFunctionTy>::init(unsigned int pInitSize) {
-  m_NumOfBuckets =
-      pInitSize ? compute_bucket_count(pInitSize) : NumOfInitBuckets;
+  allocate(pInitSize ? compute_bucket_count(pInitSize) : NumOfInitBuckets);
+}
 
+/// allocate - allocate pNumOfBuckets empty buckets and their control bytes.
+template <typename HashEntryTy, typename HashFunctionTy>
+void HashTableImpl<HashEntryTy, HashFunctionTy>::allocate(
+    unsigned int pNumOfBuckets) {
+  m_NumOfBuckets = pNumOfBuckets;
   m_NumOfEntries = 0;
   m_NumOfTombstones = 0;
 
   /** calloc also set bucket.Item = bucket_type::getEmptyStone() **/
   m_Buckets = (bucket_type*)calloc(m_NumOfBuckets, sizeof(bucket_type));
+
+  // the first Width - 1 control bytes are cloned after the last one, so that
+  // a group starting at any bucket can be loaded without wrapping around.
+  const unsigned int control_size = m_NumOfBuckets + HashGroup::Width - 1;
+  m_Control = (uint8_t*)malloc(control_size);
+  memset(m_Control, HashGroup::Empty, control_size);
 }
 
 /// clear - clear the hash table.
 template <typename HashEntryTy, typename HashFunctionTy>
 void HashTableImpl<HashEntryTy, HashFunctionTy>::clear() {
   free(m_Buckets);
+  free(m_Control);
 
   m_Buckets = 0;
+  m_Control = 0;
   m_NumOfBuckets = 0;
   m_NumOfEntries = 0;
   m_NumOfTombstones = 0;
 }
 
+/// setControl - set the control byte of the bucket pIndex and its clone.
+template <typename HashEntryTy, typename HashFunctionTy>
+void HashTableImpl<HashEntryTy, HashFunctionTy>::setControl(unsigned int pIndex,
+                                                            uint8_t pByte) {
+  m_Control[pIndex] = pByte;
+  if (pIndex < HashGroup::Width - 1)
+    m_Control[m_NumOfBuckets + pIndex] = pByte;
+}
+
 /// lookUpBucketFor - look up the bucket whose key is pKey
 template <typename HashEntryTy, typename HashFunctionTy>
 unsigned int HashTableImpl<HashEntryTy, HashFunctionTy>::lookUpBucketFor(
-    const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey) {
+    const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey,
+    unsigned int pFullHash) {
   if (m_NumOfBuckets == 0) {
     // NumOfBuckets is changed after init(pInitSize)
     init(NumOfInitBuckets);
   }
 
-  unsigned int full_hash = m_Hasher(pKey);
-  unsigned int index = full_hash % m_NumOfBuckets;
-
-  const unsigned int probe = 1;
+  unsigned int full_hash = pFullHash;
+  uint8_t fragment = HashGroup::fragment(full_hash);
+  unsigned int index = bucketIndex(full_hash);
+  const unsigned int mask = m_NumOfBuckets - 1;
   int firstTombstone = -1;
 
-  // linear probing
+  // linear probing, a group of buckets at a time
   while (true) {
-    bucket_type& bucket = m_Buckets[index];
-    // If we found an empty bucket, this key isn't in the table yet, return it.
-    if (bucket_type::getEmptyBucket() == bucket.Entry) {
-      if (firstTombstone != -1) {
-        m_Buckets[firstTombstone].FullHashValue = full_hash;
-        return firstTombstone;
-      }
+    HashGroup group(m_Control + index);
+    HashGroup::BitMask empty = group.matchEmpty();
+    // the key can not be after the first empty bucket
+    unsigned int limit = empty.any() ? empty.lowest() : HashGroup::Width;
+
+    HashGroup::BitMask match = group.match(fragment).below(limit);
+    while (match.any()) {
+      unsigned int idx = (index + match.lowest()) & mask;
+      bucket_type& bucket = m_Buckets[idx];
+      if (bucket.FullHashValue == full_hash && bucket.Entry->compare(pKey))
+        return idx;
+      match.clearLowest();
+    }
 
-      bucket.FullHashValue = full_hash;
-      return index;
+    if (firstTombstone == -1) {
+      HashGroup::BitMask tombstone = group.matchDeleted().below(limit);
+      if (tombstone.any())
+        firstTombstone = (index + tombstone.lowest()) & mask;
     }
 
-    if (bucket_type::getTombstone() == bucket.Entry) {
-      if (firstTombstone == -1) {
-        firstTombstone = index;
-      }
-    } else if (bucket.FullHashValue == full_hash) {
-      if (bucket.Entry->compare(pKey)) {
-        return index;
-      }
+    // If we found an empty bucket, this key isn't in the table yet, return
+    // the first free bucket on the way. The caller fills it in.
+    if (empty.any()) {
+      unsigned int free_bucket = (firstTombstone != -1)
+                                     ? firstTombstone
+                                     : ((index + limit) & mask);
+      m_Buckets[free_bucket].FullHashValue = full_hash;
+      setControl(free_bucket, fragment);
+      return free_bucket;
     }
 
-    index += probe;
-    if (index == m_NumOfBuckets)
-      index = 0;
+    index = (index + HashGroup::Width) & mask;
   }
 }
 
 template <typename HashEntryTy, typename HashFunctionTy>
 int HashTableImpl<HashEntryTy, HashFunctionTy>::findKey(
-    const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey)
-    const {
+    const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey,
+    unsigned int pFullHash) const {
   if (m_NumOfBuckets == 0)
     return -1;
 
-  unsigned int full_hash = m_Hasher(pKey);
-  unsigned int index = full_hash % m_NumOfBuckets;
+  unsigned int full_hash = pFullHash;
+  uint8_t fragment = HashGroup::fragment(full_hash);
+  unsigned int index = bucketIndex(full_hash);
+  const unsigned int mask = m_NumOfBuckets - 1;
 
-  const unsigned int probe = 1;
-  // linear probing
+  // linear probing, a group of buckets at a time
   while (true) {
-    bucket_type& bucket = m_Buckets[index];
+    HashGroup group(m_Control + index);
+    HashGroup::BitMask empty = group.matchEmpty();
+    unsigned int limit = empty.any() ? empty.lowest() : HashGroup::Width;
+
+    // Tombstones never match a fragment, and most of the other buckets are
+    // rejected by their control byte without touching the bucket itself.
+    HashGroup::BitMask match = group.match(fragment).below(limit);
+    while (match.any()) {
+      unsigned int idx = (index + match.lowest()) & mask;
+      const bucket_type& bucket = m_Buckets[idx];
+      if (full_hash == bucket.FullHashValue && bucket.Entry->compare(pKey))
+        return idx;
+      match.clearLowest();
+    }
 
-    if (bucket_type::getEmptyBucket() == bucket.Entry)
+    if (empty.any())
       return -1;
 
-    if (bucket_type::getTombstone() == bucket.Entry) {
-      // Ignore tombstones.
-    } else if (full_hash == bucket.FullHashValue) {
-      // get string, compare, if match, return index
-      if (bucket.Entry->compare(pKey))
-        return index;
-    }
-    index += probe;
-    if (index == m_NumOfBuckets)
-      index = 0;
+    index = (index + HashGroup::Width) & mask;
   }
 }
 
+/// markDeleted - turn the bucket pIndex into a tombstone.
+template <typename HashEntryTy, typename HashFunctionTy>
+void HashTableImpl<HashEntryTy, HashFunctionTy>::markDeleted(
+    unsigned int pIndex) {
+  m_Buckets[pIndex].Entry = bucket_type::getTombstone();
+  setControl(pIndex, HashGroup::Deleted);
+  --m_NumOfEntries;
+  ++m_NumOfTombstones;
+}
+
 template <typename HashEntryTy, typename HashFunctionTy>
 void HashTableImpl<HashEntryTy, HashFunctionTy>::mayRehash() {
   unsigned int new_size;
@@ -201,43 +244,64 @@ void HashTableImpl<HashEntryTy, HashFunctionTy>::mayRehash() {
   doRehash(new_size);
 }
 
+/// reserve - make room for pNumOfEntries entries without exceeding the
+/// maximum load factor, so that the following insertions never rehash.
+template <typename HashEntryTy, typename HashFunctionTy>
+void HashTableImpl<HashEntryTy, HashFunctionTy>::reserve(
+    unsigned int pNumOfEntries) {
+  // keep the load factor under 3/4, see mayRehash()
+  unsigned int new_size = compute_bucket_count(
+      static_cast<unsigned int>((static_cast<uint64_t>(pNumOfEntries) << 2) /
+                                3));
+  if (new_size <= m_NumOfBuckets)
+    return;
+
+  if (m_NumOfBuckets == 0) {
+    allocate(new_size);
+    return;
+  }
+  doRehash(new_size);
+}
+
 template <typename HashEntryTy, typename HashFunctionTy>
 void HashTableImpl<HashEntryTy, HashFunctionTy>::doRehash(
     unsigned int pNewSize) {
-  bucket_type* new_table = (bucket_type*)calloc(pNewSize, sizeof(bucket_type));
+  assert((pNewSize & (pNewSize - 1)) == 0 && pNewSize >= HashGroup::Width &&
+         "the number of buckets must be a power of two");
+  assert(pNewSize > m_NumOfEntries && "too few buckets for the entries");
+  bucket_type* old_table = m_Buckets;
+  uint8_t* old_control = m_Control;
+  unsigned int old_size = m_NumOfBuckets;
+  unsigned int num_of_entries = m_NumOfEntries;
+  allocate(pNewSize);
 
   // Rehash all the items into their new buckets.  Luckily :) we already have
   // the hash values available, so we don't have to recall hash function again.
-  for (bucket_type* IB = m_Buckets, * E = m_Buckets + m_NumOfBuckets; IB != E;
-       ++IB) {
-    if (IB->Entry != bucket_type::getEmptyBucket() &&
-        IB->Entry != bucket_type::getTombstone()) {
-      // Fast case, bucket available.
-      unsigned full_hash = IB->FullHashValue;
-      unsigned new_bucket = full_hash % pNewSize;
-      if (bucket_type::getEmptyBucket() == new_table[new_bucket].Entry) {
-        new_table[new_bucket].Entry = IB->Entry;
-        new_table[new_bucket].FullHashValue = full_hash;
-        continue;
+  // There are neither tombstones nor duplicated keys in the new table, so an
+  // item goes to the first empty bucket of its probe sequence.
+  const unsigned int mask = pNewSize - 1;
+  for (unsigned int i = 0; i < old_size; ++i) {
+    if ((old_control[i] & HashGroup::Empty) != 0)  // Empty or Deleted
+      continue;
+
+    unsigned int full_hash = old_table[i].FullHashValue;
+    unsigned int new_bucket = bucketIndex(full_hash);
+    while (true) {
+      HashGroup::BitMask empty = HashGroup(m_Control + new_bucket).matchEmpty();
+      if (empty.any()) {
+        new_bucket = (new_bucket + empty.lowest()) & mask;
+        break;
       }
-
-      // Otherwise probe for a spot.
-      const unsigned int probe = 1;
-      do {
-        new_bucket += probe;
-        if (new_bucket == pNewSize)
-          new_bucket = 0;
-      } while (new_table[new_bucket].Entry != bucket_type::getEmptyBucket());
-
-      // Finally found a slot.  Fill it in.
-      new_table[new_bucket].Entry = IB->Entry;
-      new_table[new_bucket].FullHashValue = full_hash;
+      new_bucket = (new_bucket + HashGroup::Width) & mask;
     }
-  }
 
-  free(m_Buckets);
+    // Finally found a slot.  Fill it in.
+    m_Buckets[new_bucket].Entry = old_table[i].Entry;
+    m_Buckets[new_bucket].FullHashValue = full_hash;
+    setControl(new_bucket, HashGroup::fragment(full_hash));
+  }
 
-  m_Buckets = new_table;
-  m_NumOfBuckets = pNewSize;
-  m_NumOfTombstones = 0;
+  free(old_table);
+  free(old_control);
+  m_NumOfEntries = num_of_entries;
 }
@@ -0,0 +1,126 @@
+//===- HashGroup.h --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_ADT_HASHGROUP_H_
+#define MCLD_ADT_HASHGROUP_H_
+
+#include <llvm/Support/DataTypes.h>
+#include <llvm/Support/MathExtras.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace mcld {
+
+/** \class HashGroup
+ *  \brief HashGroup matches 16 consecutive control bytes of a HashTableImpl
+ *  at once.
+ *
+ *  Every bucket of a HashTableImpl has a control byte, which is Empty,
+ *  Deleted, or the 7-bit fragment of the hash value of its entry. A lookup
+ *  compares the fragment of the key against a whole group of control bytes,
+ *  and only looks at the buckets whose fragment matches. This is done with
+ *  SSE2 on x86 and NEON on AArch64, and byte by byte elsewhere.
+ */
+class HashGroup {
+ public:
+  static const unsigned int Width = 16;
+
+  static const uint8_t Empty = 0x80;
+  static const uint8_t Deleted = 0xFE;
+
+  /** \class BitMask
+   *  \brief BitMask has a bit set for each matched byte of a HashGroup.
+   */
+  class BitMask {
+   public:
+    explicit BitMask(uint32_t pMask) : m_Mask(pMask) {}
+
+    bool any() const { return (m_Mask != 0); }
+
+    /// lowest - the position of the first matched byte
+    unsigned int lowest() const { return llvm::countTrailingZeros(m_Mask); }
+
+    /// clearLowest - drop the first matched byte
+    void clearLowest() { m_Mask &= (m_Mask - 1); }
+
+    /// below - keep the matched bytes before the byte pPos
+    BitMask below(unsigned int pPos) const {
+      return BitMask(m_Mask & ((1U << pPos) - 1));
+    }
+
+   private:
+    uint32_t m_Mask;
+  };
+
+ public:
+  /// HashGroup - load the Width control bytes starting at pControl.
+  explicit HashGroup(const uint8_t* pControl) {
+#if defined(__SSE2__)
+    m_Control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pControl));
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    m_Control = vld1q_u8(pControl);
+#else
+    for (unsigned int i = 0; i < Width; ++i)
+      m_Control[i] = pControl[i];
+#endif
+  }
+
+  /// fragment - the 7-bit fragment of pHash kept in a control byte. The low
+  /// bits select the home bucket, so the fragment is taken from the high bits.
+  static uint8_t fragment(uint32_t pHash) { return (pHash >> 25); }
+
+  /// match - the bytes equal to pByte
+  BitMask match(uint8_t pByte) const {
+#if defined(__SSE2__)
+    __m128i bytes = _mm_set1_epi8(static_cast<char>(pByte));
+    return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, m_Control)));
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    return BitMask(movemask(vceqq_u8(vdupq_n_u8(pByte), m_Control)));
+#else
+    uint32_t mask = 0x0;
+    for (unsigned int i = 0; i < Width; ++i) {
+      if (m_Control[i] == pByte)
+        mask |= (1U << i);
+    }
+    return BitMask(mask);
+#endif
+  }
+
+  BitMask matchEmpty() const { return match(Empty); }
+
+  BitMask matchDeleted() const { return match(Deleted); }
+
+ private:
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(__SSE2__)
+  /// movemask - gather the top bit of each byte of pBytes
+  static uint32_t movemask(uint8x16_t pBytes) {
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                        1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(pBytes, vld1q_u8(weights));
+    return vaddv_u8(vget_low_u8(bits)) |
+           (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+  }
+#endif
+
+ private:
+#if defined(__SSE2__)
+  __m128i m_Control;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  uint8x16_t m_Control;
+#else
+  uint8_t m_Control[Width];
+#endif
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_ADT_HASHGROUP_H_
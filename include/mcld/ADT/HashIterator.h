@@ -31,7 +31,7 @@ class ChainIteratorBase {
   ChainIteratorBase(HashTableImplTy* pTable, const key_type& pKey)
       : m_pHashTable(pTable) {
     m_HashValue = pTable->hash()(pKey);
-    m_EndIndex = m_Index = m_HashValue % m_pHashTable->m_NumOfBuckets;
+    m_EndIndex = m_Index = m_pHashTable->bucketIndex(m_HashValue);
     const unsigned int probe = 1;
     while (true) {
       bucket_type& bucket = m_pHashTable->m_Buckets[m_Index];
@@ -70,6 +70,12 @@ class HashTable : public HashTableImpl<HashEntryTy, HashFunctionTy> {
   //  If the element already exists, return the element, and set pExist true.
   entry_type* insert(const key_type& pKey, bool& pExist);
 
+  /// insert - the same, with pFullHash, the hash value of pKey, which the
+  //  caller has computed
+  entry_type* insert(const key_type& pKey,
+                     unsigned int pFullHash,
+                     bool& pExist);
+
   /// erase - remove the element with the same key
   size_type erase(const key_type& pKey);
 
@@ -82,6 +88,10 @@ class HashTable : public HashTableImpl<HashEntryTy, HashFunctionTy> {
   //  If the element does not exist, return end()
   const_iterator find(const key_type& pKey) const;
 
+  /// find - the same, with pFullHash, the hash value of pKey
+  iterator find(const key_type& pKey, unsigned int pFullHash);
+  const_iterator find(const key_type& pKey, unsigned int pFullHash) const;
+
   size_type count(const key_type& pKey) const;
 
   // -----  hash policy  ----- //
@@ -91,10 +101,14 @@ class HashTable : public HashTableImpl<HashEntryTy, HashFunctionTy> {
   //  less than 12.5%, the rehash the hash table
   void rehash();
 
-  /// rehash - immediately re-new the hash table to the size pCount, and
-  //  rehash all elements.
+  /// rehash - immediately re-new the hash table to at least pCount buckets,
+  //  and rehash all elements.
   void rehash(size_type pCount);
 
+  /// reserve - make room for pCount entries, so that inserting them does not
+  //  rehash the table.
+  void reserve(size_type pCount);
+
   // -----  iterators  ----- //
   iterator begin();
   iterator end();
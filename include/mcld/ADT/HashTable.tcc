@@ -64,7 +64,20 @@ HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::insert(
                              HashFunctionTy,
                              EntryFactoryTy>::key_type& pKey,
     bool& pExist) {
-  unsigned int index = BaseTy::lookUpBucketFor(pKey);
+  return insert(pKey, BaseTy::hash()(pKey), pExist);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::entry_type*
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::insert(
+    const typename HashTable<HashEntryTy,
+                             HashFunctionTy,
+                             EntryFactoryTy>::key_type& pKey,
+    unsigned int pFullHash,
+    bool& pExist) {
+  unsigned int index = BaseTy::lookUpBucketFor(pKey, pFullHash);
   bucket_type& bucket = BaseTy::m_Buckets[index];
   entry_type* entry = bucket.Entry;
   if (bucket_type::getEmptyBucket() != entry &&
@@ -99,12 +112,8 @@ HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::erase(
   if ((index = BaseTy::findKey(pKey)) == -1)
     return 0;
 
-  bucket_type& bucket = BaseTy::m_Buckets[index];
-  m_EntryFactory.destroy(bucket.Entry);
-  bucket.Entry = bucket_type::getTombstone();
-
-  --BaseTy::m_NumOfEntries;
-  ++BaseTy::m_NumOfTombstones;
+  m_EntryFactory.destroy(BaseTy::m_Buckets[index].Entry);
+  BaseTy::markDeleted(index);
   BaseTy::mayRehash();
   return 1;
 }
@@ -137,6 +146,36 @@ HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
   return const_iterator(this, index);
 }
 
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::iterator
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+    const typename HashTable<HashEntryTy,
+                             HashFunctionTy,
+                             EntryFactoryTy>::key_type& pKey,
+    unsigned int pFullHash) {
+  int index;
+  if ((index = BaseTy::findKey(pKey, pFullHash)) == -1)
+    return end();
+  return iterator(this, index);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::const_iterator
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+    const typename HashTable<HashEntryTy,
+                             HashFunctionTy,
+                             EntryFactoryTy>::key_type& pKey,
+    unsigned int pFullHash) const {
+  int index;
+  if ((index = BaseTy::findKey(pKey, pFullHash)) == -1)
+    return end();
+  return const_iterator(this, index);
+}
+
 template <typename HashEntryTy,
           typename HashFunctionTy,
           typename EntryFactoryTy>
@@ -173,7 +212,21 @@ template <typename HashEntryTy,
 void HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::rehash(
     typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::size_type
         pCount) {
-  BaseTy::doRehash(pCount);
+  unsigned int new_size = HashGroup::Width;
+  while (new_size < pCount)
+    new_size <<= 1;
+  if (new_size <= BaseTy::m_NumOfEntries)
+    new_size = compute_bucket_count(BaseTy::m_NumOfEntries);
+  BaseTy::doRehash(new_size);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+void HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::reserve(
+    typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::size_type
+        pCount) {
+  BaseTy::reserve(pCount);
 }
 
 template <typename HashEntryTy,
@@ -11,6 +11,7 @@
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/DataTypes.h>
+#include <llvm/Support/Endian.h>
 
 #include <cassert>
 #include <cctype>
@@ -19,7 +20,7 @@
 namespace mcld {
 namespace hash {
 
-enum Type { RS, JS, PJW, ELF, BKDR, SDBM, DJB, DEK, BP, FNV, AP, ES };
+enum Type { RS, JS, PJW, ELF, BKDR, SDBM, DJB, DEK, BP, FNV, AP, ES, WY };
 
 /** \class template<uint32_t TYPE> StringHash
  *  \brief the template StringHash class, for specification
@@ -106,8 +107,9 @@ struct StringHash<ELF>
     uint32_t hash_val = 0;
     uint32_t x = 0;
 
+    // the bytes are unsigned, as in the hashes of the ELF dynamic linker
     for (unsigned int i = 0; i < pKey.size(); ++i) {
-      hash_val = (hash_val << 4) + pKey[i];
+      hash_val = (hash_val << 4) + static_cast<unsigned char>(pKey[i]);
       if ((x = hash_val & 0xF0000000L) != 0)
         hash_val ^= (x >> 24);
       hash_val &= ~x;
@@ -158,8 +160,10 @@ struct StringHash<DJB>
   uint32_t operator()(const llvm::StringRef pKey) const {
     uint32_t hash_val = 5381;
 
-    for (uint32_t i = 0; i < pKey.size(); ++i)
-      hash_val = ((hash_val << 5) + hash_val) + pKey[i];
+    for (uint32_t i = 0; i < pKey.size(); ++i) {
+      hash_val = ((hash_val << 5) + hash_val) +
+                 static_cast<unsigned char>(pKey[i]);
+    }
 
     return hash_val;
   }
@@ -310,6 +314,79 @@ struct StringHash<ES>
   }
 };
 
+/** \class StringHash<WY>
+ *  \brief A word-at-a-time hash function in the style of wyhash.
+ *
+ *  It consumes 16 bytes per step with two 64x64->128-bit multiplications, so
+ *  it is much faster than the byte-at-a-time functions above on the long
+ *  mangled names of C++ symbols, and all of its 32 bits are well mixed.
+ *  Words are read in little endian on every host, so the iteration order of
+ *  the tables using it, and hence the output, does not depend on the host.
+ */
+template <>
+struct StringHash<WY>
+    : public std::unary_function<const llvm::StringRef, uint32_t> {
+  uint32_t operator()(const llvm::StringRef pKey) const {
+    static const uint64_t p0 = 0xa0761d6478bd642fULL;
+    static const uint64_t p1 = 0xe7037ed1a0b428dbULL;
+    static const uint64_t p2 = 0x8ebc6af09c88c6e3ULL;
+
+    const char* data = pKey.data();
+    size_t size = pKey.size();
+    uint64_t seed = p0 ^ size;
+    while (size > 16) {
+      seed = mix(read64(data) ^ p1, read64(data + 8) ^ seed);
+      data += 16;
+      size -= 16;
+    }
+
+    // the tail is read with overlapping loads
+    uint64_t a = 0x0, b = 0x0;
+    if (size >= 8) {
+      a = read64(data);
+      b = read64(data + size - 8);
+    } else if (size >= 4) {
+      a = read32(data);
+      b = read32(data + size - 4);
+    } else if (size > 0) {
+      a = (static_cast<uint64_t>(static_cast<unsigned char>(data[0])) << 16) |
+          (static_cast<uint64_t>(static_cast<unsigned char>(data[size >> 1]))
+           << 8) |
+          static_cast<unsigned char>(data[size - 1]);
+    }
+
+    uint64_t hash_val = mix(p1 ^ pKey.size(), mix(a ^ p1, b ^ seed) ^ p2);
+    return static_cast<uint32_t>(hash_val ^ (hash_val >> 32));
+  }
+
+ private:
+  static uint64_t read64(const char* pData) {
+    return llvm::support::endian::read64le(pData);
+  }
+
+  static uint64_t read32(const char* pData) {
+    return llvm::support::endian::read32le(pData);
+  }
+
+  /// mix - fold the 128-bit product of pA and pB into 64 bits
+  static uint64_t mix(uint64_t pA, uint64_t pB) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = static_cast<__uint128_t>(pA) * pB;
+    return static_cast<uint64_t>(product) ^
+           static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t a_lo = pA & 0xFFFFFFFF, a_hi = pA >> 32;
+    uint64_t b_lo = pB & 0xFFFFFFFF, b_hi = pB >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    uint64_t upper = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    return lower ^ upper;
+#endif
+  }
+};
+
 /** \class template<uint32_t TYPE> StringCompare
  *  \brief the template StringCompare class, for specification
  */
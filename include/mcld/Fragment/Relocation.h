@@ -92,6 +92,8 @@ class Relocation : public llvm::ilist_node<Relocation> {
   const FragmentRef& targetRef() const { return m_TargetAddress; }
   FragmentRef& targetRef() { return m_TargetAddress; }
 
+  /// apply - apply the relocation by pRelocator and issue the diagnostic if
+  /// it fails.
   void apply(Relocator& pRelocator);
 
   /// updateAddend - A relocation with a section symbol must update addend
@@ -75,6 +75,16 @@ class GeneralOptions {
 
   bool trace() const { return m_bTrace; }
 
+  /// time-trace
+  void setTimeTrace(bool pEnable = true) { m_bTimeTrace = pEnable; }
+
+  bool timeTrace() const { return m_bTimeTrace; }
+
+  /// the file that receives the Chrome trace-event JSON of --time-trace
+  void setTimeTraceFile(const std::string& pFile) { m_TimeTraceFile = pFile; }
+
+  const std::string& timeTraceFile() const { return m_TimeTraceFile; }
+
   void setBsymbolic(bool pBsymbolic = true) { m_Bsymbolic = pBsymbolic; }
 
   bool Bsymbolic() const { return m_Bsymbolic; }
@@ -277,6 +287,39 @@ class GeneralOptions {
     m_bPrintICFSections = pPrintICFSections;
   }
 
+  // -----  mergeable strings  ----- //
+  /// tailMergeStrings - keep a string of the SHF_MERGE and SHF_STRINGS
+  /// sections, .debug_str and .strtab in the end of another string which
+  /// ends with it. .dynstr and .shstrtab are always tail merged.
+  bool tailMergeStrings() const { return m_bTailMergeStrings; }
+
+  void setTailMergeStrings(bool pEnable = true) {
+    m_bTailMergeStrings = pEnable;
+  }
+
+  // -----  concurrency  ----- //
+  /// numThreads - the number of worker threads. 1 means a serial link.
+  unsigned int numThreads() const { return m_NumThreads; }
+
+  void setNumThreads(unsigned int pNum) { m_NumThreads = pNum; }
+
+  // -----  shared objects  ----- //
+  /// lazyShlibSymbols - read the defined symbols of the shared objects only
+  /// when they are referred
+  bool lazyShlibSymbols() const { return m_bLazyShlibSymbols; }
+
+  void setLazyShlibSymbols(bool pEnable = true) {
+    m_bLazyShlibSymbols = pEnable;
+  }
+
+  /// shlibSymbolCache - the directory of the ShlibSymbolCache, or empty if
+  /// the symbols of the shared objects are not cached
+  const std::string& shlibSymbolCache() const { return m_ShlibSymbolCache; }
+
+  void setShlibSymbolCache(const std::string& pDir) {
+    m_ShlibSymbolCache = pDir;
+  }
+
   // -----  link-in rpath  ----- //
   const RpathList& getRpathList() const { return m_RpathList; }
   RpathList& getRpathList() { return m_RpathList; }
@@ -360,6 +403,7 @@ class GeneralOptions {
   bool m_bNow : 1;           // lazy, now
   bool m_bOrigin : 1;        // origin
   bool m_bTrace : 1;         // --trace
+  bool m_bTimeTrace : 1;     // --time-trace
   bool m_Bsymbolic : 1;      // --Bsymbolic
   bool m_Bgroup : 1;
   bool m_bPIE : 1;
@@ -381,14 +425,19 @@ class GeneralOptions {
   bool m_bPrintGCSections : 1;    // --print-gc-sections
   bool m_bGenUnwindInfo : 1;      // --ld-generated-unwind-info
   bool m_bPrintICFSections : 1;   // --print-icf-sections
+  bool m_bLazyShlibSymbols : 1;   // --lazy-shlib-symbols
+  bool m_bTailMergeStrings : 1;   // --tail-merge-strings
   ICF m_ICF;
   size_t m_ICFIterations;
+  unsigned int m_NumThreads;  // --threads=N
   StripSymbolMode m_StripSymbols;
   RpathList m_RpathList;
   ScriptList m_ScriptList;
   UndefSymList m_UndefSymList;  // -u [symbol], --undefined [symbol]
   HashStyle m_HashStyle;
   std::string m_Filter;
+  std::string m_TimeTraceFile;  // --time-trace-file=file
+  std::string m_ShlibSymbolCache;  // --shlib-symbol-cache=dir
   AuxiliaryList m_AuxiliaryList;
   ExcludeLIBS m_ExcludeLIBS;
 };
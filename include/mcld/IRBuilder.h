@@ -384,7 +384,7 @@ class IRBuilder {
   /// @return The added symbol. If the insertion fails due to the resoluction,
   /// return NULL.
   LDSymbol* AddSymbol(Input& pInput,
-                      const std::string& pName,
+                      const llvm::StringRef& pName,
                       ResolveInfo::Type pType,
                       ResolveInfo::Desc pDesc,
                       ResolveInfo::Binding pBind,
@@ -459,23 +459,25 @@ class IRBuilder {
   bool shouldForceLocal(const ResolveInfo& pInfo, const LinkerConfig& pConfig);
 
  private:
-  LDSymbol* addSymbolFromObject(const std::string& pName,
+  LDSymbol* addSymbolFromObject(const llvm::StringRef& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
                                 ResolveInfo::SizeType pSize,
                                 LDSymbol::ValueType pValue,
                                 FragmentRef* pFragmentRef,
-                                ResolveInfo::Visibility pVisibility);
+                                ResolveInfo::Visibility pVisibility,
+                                bool pReferName);
 
   LDSymbol* addSymbolFromDynObj(Input& pInput,
-                                const std::string& pName,
+                                const llvm::StringRef& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
                                 ResolveInfo::SizeType pSize,
                                 LDSymbol::ValueType pValue,
-                                ResolveInfo::Visibility pVisibility);
+                                ResolveInfo::Visibility pVisibility,
+                                bool pReferName);
 
  private:
   Module& m_Module;
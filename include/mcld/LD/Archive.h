@@ -15,6 +15,8 @@
 #include "mcld/ADT/StringHash.h"
 #include "mcld/Support/GCFactory.h"
 
+#include <llvm/ADT/StringRef.h>
+
 #include <string>
 #include <vector>
 
@@ -95,16 +97,20 @@ class Archive {
     enum Status { Include, Exclude, Unknown };
 
     Symbol(const char* pName, uint32_t pOffset, enum Status pStatus)
-        : name(pName), fileOffset(pOffset), status(pStatus) {}
+        : name(pName), fileOffset(pOffset), status(pStatus), next(NoSymbol) {}
 
     ~Symbol() {}
 
    public:
-    std::string name;
+    llvm::StringRef name;  ///< points into the mapped armap
     uint32_t fileOffset;
     enum Status status;
+    size_t next;  ///< the next symtab entry of the same name
   };
 
+  /// NoSymbol - the end of a chain of symtab entries of the same name
+  static const size_t NoSymbol = static_cast<size_t>(-1);
+
   typedef std::vector<Symbol*> SymTabType;
 
  public:
@@ -142,6 +148,11 @@ class Archive {
   /// @param pFileOffset - file offset in symtab represents a object file
   bool hasObjectMember(uint32_t pFileOffset) const;
 
+  /// getObjectMember - get the included object file, or NULL if it is not
+  /// included yet
+  /// @param pFileOffset - file offset in symtab represents a object file
+  Input* getObjectMember(uint32_t pFileOffset);
+
   /// getArchiveMemberMap - get the map that contains the included archive files
   ArchiveMemberMapType& getArchiveMemberMap();
 
@@ -180,14 +191,22 @@ class Archive {
   size_t numOfSymbols() const;
 
   /// addSymbol - add a symtab entry to symtab
-  /// @param pName - symbol name
+  /// @param pName - symbol name, which is referred and not copied
   /// @param pFileOffset - file offset in symtab represents a object file
   void addSymbol(const char* pName,
                  uint32_t pFileOffset,
                  enum Symbol::Status pStatus = Archive::Symbol::Unknown);
 
   /// getSymbolName - get the symbol name with the given index
-  const std::string& getSymbolName(size_t pSymIdx) const;
+  llvm::StringRef getSymbolName(size_t pSymIdx) const;
+
+  /// findSymbol - get the index of the first symtab entry named pName, or
+  /// NoSymbol if there is none
+  size_t findSymbol(const llvm::StringRef& pName) const;
+
+  /// getNextSymbol - get the index of the next symtab entry which has the
+  /// same name as the given index, or NoSymbol if there is none
+  size_t getNextSymbol(size_t pSymIdx) const;
 
   /// getObjFileOffset - get the file offset that represent a object file
   uint32_t getObjFileOffset(size_t pSymIdx) const;
@@ -222,6 +241,20 @@ class Archive {
  private:
   typedef GCFactory<Symbol, 0> SymbolFactory;
 
+  /// SymbolChain - the first and the last symtab entries of a name
+  struct SymbolChain {
+    size_t first;
+    size_t last;
+  };
+
+  typedef HashEntry<const llvm::StringRef,
+                    SymbolChain,
+                    hash::StringCompare<llvm::StringRef> > SymbolIndexEntryType;
+
+  typedef HashTable<SymbolIndexEntryType,
+                    hash::StringHash<hash::WY>,
+                    EntryFactory<SymbolIndexEntryType> > SymbolIndexType;
+
  private:
   Input& m_ArchiveFile;
   InputTree* m_pInputTree;
@@ -229,6 +262,7 @@ class Archive {
   ArchiveMemberMapType m_ArchiveMemberMap;
   SymbolFactory m_SymbolFactory;
   SymTabType m_SymTab;
+  SymbolIndexType m_SymbolIndex;
   size_t m_SymTabSize;
   std::string m_StrTab;
   InputBuilder& m_Builder;
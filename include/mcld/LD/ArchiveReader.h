@@ -10,10 +10,13 @@
 #define MCLD_LD_ARCHIVEREADER_H_
 #include "mcld/LD/LDReader.h"
 
+#include <vector>
+
 namespace mcld {
 
 class Archive;
 class LinkerConfig;
+class ThreadPool;
 
 /** \class ArchiveReader
  *  \brief ArchiveReader provides an common interface for all archive readers.
@@ -31,6 +34,22 @@ class ArchiveReader : public LDReader {
   virtual ~ArchiveReader();
 
   virtual bool readArchive(const LinkerConfig& pConfig, Archive& pArchive) = 0;
+
+  /// readArchives - include the needed members of the archives in a group,
+  /// which have been read once. It gives the same result as calling
+  /// readArchive() on each of them in turn until a round includes nothing.
+  virtual bool readArchives(const LinkerConfig& pConfig,
+                            const std::vector<Archive*>& pArchives);
+
+  /// setThreadPool - decode the selected members on pPool. NULL means that
+  /// the members are read serially.
+  void setThreadPool(ThreadPool* pPool) { m_pThreadPool = pPool; }
+
+ protected:
+  ThreadPool* getThreadPool() const { return m_pThreadPool; }
+
+ private:
+  ThreadPool* m_pThreadPool;
 };
 
 }  // namespace mcld
@@ -9,23 +9,29 @@
 #ifndef MCLD_LD_DEBUGSTRING_H_
 #define MCLD_LD_DEBUGSTRING_H_
 
-#include "mcld/LD/MergedStringTable.h"
+#include "mcld/LD/MergedStrings.h"
+#include "mcld/Support/MemoryRegion.h"
 
-#include <vector>
+#include <llvm/ADT/DenseMap.h>
 
 namespace mcld {
 
 class LDSection;
 class Relocation;
 class TargetLDBackend;
+class ThreadPool;
 
 /** \class DebugString
  *  \brief DebugString represents the output debug section .debug_str
+ *
+ *  The strings of the input .debug_str sections are merged by MergedStrings,
+ *  which keeps the output offset of every string, so that a relocation finds
+ *  the output offset by the input offset it refers to.
  */
 class DebugString {
  public:
   DebugString()
-      : m_pSection(NULL) {}
+      : m_pSection(NULL), m_Strings(1, 1) {}
 
   static DebugString* Create(LDSection& pSection);
 
@@ -35,8 +41,10 @@ class DebugString {
 
   /// computeOffsetSize - set up the output offset of each strings and the
   /// section size
+  /// @param pThreadPool - the workers to merge the strings, or NULL
+  /// @param pTailMerge - whether to keep a string in the end of another one
   /// @return string table size
-  size_t computeOffsetSize();
+  size_t computeOffsetSize(ThreadPool* pThreadPool, bool pTailMerge);
 
   /// applyOffset - apply the relocation which refer to debug string. This
   /// should be called after finalizeStringsOffset()
@@ -56,7 +64,10 @@ class DebugString {
   /// m_Section - the output LDSection of this .debug_str
   LDSection* m_pSection;
 
-  MergedStringTable m_StringTable;
+  MergedStrings m_Strings;
+
+  /// m_InputSections - the index of each input .debug_str in m_Strings
+  llvm::DenseMap<const LDSection*, unsigned int> m_InputSections;
 };
 
 }  // namespace mcld
@@ -10,6 +10,8 @@
 #define MCLD_LD_DYNOBJREADER_H_
 #include "mcld/LD/LDReader.h"
 
+#include <cstddef>
+
 namespace mcld {
 
 class TargetLDBackend;
@@ -29,6 +31,10 @@ class DynObjReader : public LDReader {
   virtual bool readHeader(Input& pFile) = 0;
 
   virtual bool readSymbols(Input& pFile) = 0;
+
+  /// countSymbols - the number of entries in the dynamic symbol table of
+  /// pFile, read from its section headers only.
+  virtual size_t countSymbols(Input& pFile) const { return 0; }
 };
 
 }  // namespace mcld
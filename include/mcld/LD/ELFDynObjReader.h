@@ -9,6 +9,11 @@
 #ifndef MCLD_LD_ELFDYNOBJREADER_H_
 #define MCLD_LD_ELFDYNOBJREADER_H_
 #include "mcld/LD/DynObjReader.h"
+#include "mcld/LD/NamePool.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <vector>
 
 namespace mcld {
 
@@ -17,12 +22,21 @@ class GNULDBackend;
 class Input;
 class IRBuilder;
 class LinkerConfig;
+class ShlibSymbolCache;
 
 /** \class ELFDynObjReader
  *  \brief ELFDynObjReader reads ELF dynamic shared objects.
  *
+ *  With --lazy-shlib-symbols, the defined entries of .dynsym are not read
+ *  until their names are seen. They are found by the .gnu.hash or .hash of
+ *  the shared object, and imported through NamePool::Importer right before
+ *  the name becomes a symbol, so the resolution is the same as reading the
+ *  whole .dynsym.
+ *
+ *  With --shlib-symbol-cache, the shared objects which are read in full are
+ *  decoded through the ShlibSymbolCache.
  */
-class ELFDynObjReader : public DynObjReader {
+class ELFDynObjReader : public DynObjReader, public NamePool::Importer {
  public:
   ELFDynObjReader(GNULDBackend& pBackend,
                   IRBuilder& pBuilder,
@@ -37,9 +51,49 @@ class ELFDynObjReader : public DynObjReader {
 
   bool readSymbols(Input& pInput);
 
+  size_t countSymbols(Input& pFile) const;
+
+  /// import - read the entries named pName of the shared objects which are
+  /// read lazily, in the order of the shared objects
+  void import(const llvm::StringRef& pName);
+
+ private:
+  struct LazyDynObj;
+  typedef std::vector<LazyDynObj*> LazyDynObjList;
+  typedef std::vector<llvm::StringRef> NameList;
+
+  /// createLazyDynObj - index the .dynsym of pInput by its hash section.
+  /// Return NULL if pInput has no usable hash section.
+  LazyDynObj* createLazyDynObj(Input& pInput,
+                               llvm::StringRef pSymTab,
+                               llvm::StringRef pStrTab) const;
+
+  /// readLazySymbols - read the undefined entries of pDynObj and the entries
+  /// of the names which are already symbols
+  bool readLazySymbols(LazyDynObj& pDynObj);
+
+  /// lookup - add the unread entries named pName of pDynObj, and their weak
+  /// aliases, to the batch of pDynObj. The names of the aliases are appended
+  /// to pNames.
+  void lookup(LazyDynObj& pDynObj,
+              const llvm::StringRef& pName,
+              NameList& pNames) const;
+
+  /// addEntry - add the pIdx-th entry of pDynObj to its batch, along with the
+  /// weak aliases of it
+  void addEntry(LazyDynObj& pDynObj, uint32_t pIdx, NameList& pNames) const;
+
+  /// importNames - look up pNames from pFirst on in all the shared objects,
+  /// and read the batches in order
+  void importNames(NameList& pNames, size_t pFirst);
+
  private:
   ELFReaderIF* m_pELFReader;
   IRBuilder& m_Builder;
+  const LinkerConfig& m_Config;
+  ShlibSymbolCache* m_pSymbolCache;
+  LazyDynObjList m_LazyDynObjs;
+  bool m_bImporting;
 };
 
 }  // namespace mcld
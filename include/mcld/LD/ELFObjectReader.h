@@ -55,6 +55,12 @@ class ELFObjectReader : public ObjectReader {
   /// This function should be called after symbol resolution.
   virtual bool readRelocations(Input& pFile);
 
+  /// decodeSymbols - decode .symtab of pFile into pBuffer. Thread-safe.
+  virtual bool decodeSymbols(Input& pFile, SymbolBuffer& pBuffer) const;
+
+  /// countSymbols - the number of entries in .symtab of pFile.
+  virtual size_t countSymbols(Input& pFile) const;
+
  private:
   ELFReaderIF* m_pELFReader;
   EhFrameReader* m_pEhFrameReader;
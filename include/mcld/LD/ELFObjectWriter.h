@@ -9,6 +9,7 @@
 #ifndef MCLD_LD_ELFOBJECTWRITER_H_
 #define MCLD_LD_ELFOBJECTWRITER_H_
 #include "mcld/LD/ObjectWriter.h"
+#include "mcld/LD/SectionData.h"
 #include "mcld/Support/FileOutputBuffer.h"
 
 #include <cassert>
@@ -21,7 +22,6 @@ class LDSection;
 class LinkerConfig;
 class Module;
 class RelocData;
-class SectionData;
 
 /** \class ELFObjectWriter
  *  \brief ELFObjectWriter writes the target-independent parts of object files.
@@ -43,6 +43,10 @@ class ELFObjectWriter : public ObjectWriter {
                     FileOutputBuffer& pOutput,
                     LDSection* section);
 
+  /// writeSectionsConcurrently - write the regular sections on the thread
+  /// pool. Large sections are split into ranges of fragments.
+  void writeSectionsConcurrently(Module& pModule, FileOutputBuffer& pOutput);
+
   const GNULDBackend& target() const { return m_Backend; }
   GNULDBackend& target() { return m_Backend; }
 
@@ -111,6 +115,11 @@ class ELFObjectWriter : public ObjectWriter {
 
   void emitSectionData(const SectionData& pSD, MemoryRegion& pRegion) const;
 
+  void emitFragments(SectionData::const_iterator pBegin,
+                     SectionData::const_iterator pEnd,
+                     MemoryRegion& pRegion,
+                     size_t pOffset) const;
+
  private:
   GNULDBackend& m_Backend;
 
@@ -68,11 +68,16 @@ class ELFReader<32, true> : public ELFReaderIF {
   /// readRegularSection - read a regular section and create fragments.
   bool readRegularSection(Input& pInput, SectionData& pSD) const;
 
-  /// readSymbols - read ELF symbols and create LDSymbol
-  bool readSymbols(Input& pInput,
-                   IRBuilder& pBuilder,
-                   llvm::StringRef pRegion,
-                   const char* StrTab) const;
+  /// decodeSymbols - decode the ELF symbol table into pBuffer
+  bool decodeSymbols(Input& pInput,
+                     const void* pELFHeader,
+                     uint32_t pType,
+                     SymbolBuffer& pBuffer) const;
+
+  /// countSymbols - the number of entries in the symbol table of type pType
+  size_t countSymbols(Input& pInput,
+                      const void* pELFHeader,
+                      uint32_t pType) const;
 
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
@@ -94,25 +99,20 @@ class ELFReader<32, true> : public ELFReaderIF {
   bool readDynamic(Input& pInput) const;
 
  private:
-  struct AliasInfo {
-    LDSymbol* pt_alias;  /// potential alias
-    uint64_t ld_value;
-    ResolveInfo::Binding ld_binding;
-  };
-
-  /// comparison function to sort symbols for analyzing weak alias.
-  /// sort symbols by symbol value and then weak before strong.
-  static bool less(AliasInfo p1, AliasInfo p2) {
-    if (p1.ld_value != p2.ld_value)
-      return (p1.ld_value < p2.ld_value);
-    if (p1.ld_binding != p2.ld_binding) {
-      if (ResolveInfo::Weak == p1.ld_binding)
-        return true;
-      else if (ResolveInfo::Weak == p2.ld_binding)
-        return false;
-    }
-    return p1.pt_alias->str() < p2.pt_alias->str();
-  }
+  /// decodeSymbolEntries - decode the entries pIndices of the ELF symbols,
+  /// or all of them but the first NULL symbol if pIndices is NULL
+  bool decodeSymbolEntries(llvm::StringRef pRegion,
+                           llvm::StringRef pStrTab,
+                           const std::vector<uint32_t>* pIndices,
+                           SymbolBuffer& pBuffer) const;
+
+  /// findSymbolTable - find the symbol table of type pType and its string
+  /// table in the mapped file.
+  bool findSymbolTable(Input& pInput,
+                       const void* pELFHeader,
+                       uint32_t pType,
+                       llvm::StringRef& pSymTab,
+                       llvm::StringRef& pStrTab) const;
 };
 
 /** \class ELFReader<64, true>
@@ -153,11 +153,16 @@ class ELFReader<64, true> : public ELFReaderIF {
   /// readRegularSection - read a regular section and create fragments.
   bool readRegularSection(Input& pInput, SectionData& pSD) const;
 
-  /// readSymbols - read ELF symbols and create LDSymbol
-  bool readSymbols(Input& pInput,
-                   IRBuilder& pBuilder,
-                   llvm::StringRef pRegion,
-                   const char* StrTab) const;
+  /// decodeSymbols - decode the ELF symbol table into pBuffer
+  bool decodeSymbols(Input& pInput,
+                     const void* pELFHeader,
+                     uint32_t pType,
+                     SymbolBuffer& pBuffer) const;
+
+  /// countSymbols - the number of entries in the symbol table of type pType
+  size_t countSymbols(Input& pInput,
+                      const void* pELFHeader,
+                      uint32_t pType) const;
 
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
@@ -179,25 +184,20 @@ class ELFReader<64, true> : public ELFReaderIF {
   bool readDynamic(Input& pInput) const;
 
  private:
-  struct AliasInfo {
-    LDSymbol* pt_alias;  /// potential alias
-    uint64_t ld_value;
-    ResolveInfo::Binding ld_binding;
-  };
-
-  /// comparison function to sort symbols for analyzing weak alias.
-  /// sort symbols by symbol value and then weak before strong.
-  static bool less(AliasInfo p1, AliasInfo p2) {
-    if (p1.ld_value != p2.ld_value)
-      return (p1.ld_value < p2.ld_value);
-    if (p1.ld_binding != p2.ld_binding) {
-      if (ResolveInfo::Weak == p1.ld_binding)
-        return true;
-      else if (ResolveInfo::Weak == p2.ld_binding)
-        return false;
-    }
-    return p1.pt_alias->str() < p2.pt_alias->str();
-  }
+  /// decodeSymbolEntries - decode the entries pIndices of the ELF symbols,
+  /// or all of them but the first NULL symbol if pIndices is NULL
+  bool decodeSymbolEntries(llvm::StringRef pRegion,
+                           llvm::StringRef pStrTab,
+                           const std::vector<uint32_t>* pIndices,
+                           SymbolBuffer& pBuffer) const;
+
+  /// findSymbolTable - find the symbol table of type pType and its string
+  /// table in the mapped file.
+  bool findSymbolTable(Input& pInput,
+                       const void* pELFHeader,
+                       uint32_t pType,
+                       llvm::StringRef& pSymTab,
+                       llvm::StringRef& pStrTab) const;
 };
 
 }  // namespace mcld
@@ -23,6 +23,7 @@ class IRBuilder;
 class FragmentRef;
 class LDSection;
 class SectionData;
+class SymbolBuffer;
 
 /** \class ELFReaderIF
  *  \brief ELFReaderIF provides common interface for all kind of ELF readers.
@@ -59,11 +60,49 @@ class ELFReaderIF {
   /// readRegularSection - read a regular section and create fragments.
   virtual bool readRegularSection(Input& pInput, SectionData& pSD) const = 0;
 
-  /// readSymbols - read ELF symbols and create LDSymbol
-  virtual bool readSymbols(Input& pInput,
-                           IRBuilder& pBuilder,
-                           llvm::StringRef pRegion,
-                           const char* StrTab) const = 0;
+  /// readSymbols - read ELF symbols and create LDSymbol. The weak aliases of
+  /// a shared object are not linked up; see findAliases.
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   llvm::StringRef pRegion,
+                   llvm::StringRef pStrTab) const;
+
+  /// readSymbols - read the entries pIndices of the ELF symbol table, in the
+  /// given order. The first NULL symbol is not added. This is used to read
+  /// the symbols of a shared object on demand.
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   llvm::StringRef pRegion,
+                   llvm::StringRef pStrTab,
+                   const std::vector<uint32_t>& pIndices) const;
+
+  /// decodeSymbols - decode the ELF symbol table of type pType (SHT_SYMTAB
+  /// or SHT_DYNSYM) of pInput into pBuffer. It only reads the mapped file, so
+  /// it can run concurrently for different inputs. Return false if the symbol
+  /// table can not be decoded.
+  virtual bool decodeSymbols(Input& pInput,
+                             const void* pELFHeader,
+                             uint32_t pType,
+                             SymbolBuffer& pBuffer) const = 0;
+
+  /// countSymbols - the number of entries in the symbol table of type pType
+  /// (SHT_SYMTAB or SHT_DYNSYM) of pInput, or 0 if it has none. Like
+  /// decodeSymbols, it only reads the mapped file.
+  virtual size_t countSymbols(Input& pInput,
+                              const void* pELFHeader,
+                              uint32_t pType) const = 0;
+
+  /// resolveSymbols - create LDSymbols from a buffer filled by decodeSymbols.
+  /// readSymbols decodes and resolves at once. The weak aliases of a shared
+  /// object are linked up by the groups recorded in pBuffer.
+  bool resolveSymbols(Input& pInput,
+                      IRBuilder& pBuilder,
+                      const SymbolBuffer& pBuffer) const;
+
+  /// findAliases - record the groups of weak aliases of the shared object
+  /// pInput in pBuffer. A group is a weak data object and all the others at
+  /// the same value.
+  void findAliases(const Input& pInput, SymbolBuffer& pBuffer) const;
 
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
@@ -95,6 +134,20 @@ class ELFReaderIF {
   typedef std::vector<LinkInfo> LinkInfoList;
 
  protected:
+  /// decodeSymbolEntries - decode the entries pIndices of the ELF symbol
+  /// table pRegion, or all of them but the first NULL symbol if pIndices is
+  /// NULL. Return false if an entry is out of the tables.
+  virtual bool decodeSymbolEntries(llvm::StringRef pRegion,
+                                   llvm::StringRef pStrTab,
+                                   const std::vector<uint32_t>* pIndices,
+                                   SymbolBuffer& pBuffer) const = 0;
+
+  /// addSymbols - create the LDSymbols of the entries of pBuffer, and link
+  /// up the weak aliases recorded in it
+  bool addSymbols(Input& pInput,
+                  IRBuilder& pBuilder,
+                  const SymbolBuffer& pBuffer) const;
+
   ResolveInfo::Type getSymType(uint8_t pInfo, uint16_t pShndx) const;
 
   ResolveInfo::Desc getSymDesc(uint16_t pShndx, const Input& pInput) const;
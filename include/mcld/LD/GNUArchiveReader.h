@@ -12,18 +12,30 @@
 #include "mcld/LD/Archive.h"
 #include "mcld/LD/ArchiveReader.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace mcld {
 
 class Archive;
+class ArchiveWorklist;
 class ELFObjectReader;
 class Input;
 class LinkerConfig;
 class Module;
+class SymbolBuffer;
 
 /** \class GNUArchiveReader
  *  \brief GNUArchiveReader reads GNU archive files.
  */
 class GNUArchiveReader : public ArchiveReader {
+ private:
+  /// the symbol tables of the members decoded ahead, keyed by the archive
+  /// file and the file offset of the member header
+  typedef std::map<std::pair<const Input*, uint32_t>, SymbolBuffer*>
+      DecodedMembers;
+
  public:
   GNUArchiveReader(Module& pModule, ELFObjectReader& pELFObjectReader);
 
@@ -33,6 +45,10 @@ class GNUArchiveReader : public ArchiveReader {
   /// the subtree
   bool readArchive(const LinkerConfig& pConfig, Archive& pArchive);
 
+  /// readArchives - include the needed members of the archives in a group
+  bool readArchives(const LinkerConfig& pConfig,
+                    const std::vector<Archive*>& pArchives);
+
   /// isMyFormat
   bool isMyFormat(Input& input, bool& pContinue) const;
 
@@ -81,13 +97,32 @@ class GNUArchiveReader : public ArchiveReader {
                        Archive& pArchiveRoot,
                        uint32_t pFileOffset);
 
+  /// includeNeededMembers - include the members needed by the entries in the
+  /// worklist of the pIdx-th archive, and return whether any is included
+  bool includeNeededMembers(const LinkerConfig& pConfig,
+                            ArchiveWorklist& pWorklist,
+                            size_t pIdx);
+
   /// includeAllMembers - include all object members. This is called if
   /// --whole-archive is the attribute for this archive file.
   bool includeAllMembers(const LinkerConfig& pConfig, Archive& pArchive);
 
+  /// decodeMembers - decode the symbol tables of the object members at
+  /// pOffsets on the thread pool. includeMember() replays them in order.
+  void decodeMembers(Archive& pArchive, const std::vector<uint32_t>& pOffsets);
+
+  /// decodeCandidates - decode the members which the next scan of the
+  /// worklist of the pIdx-th archive is about to include.
+  void decodeCandidates(ArchiveWorklist& pWorklist, size_t pIdx);
+
+  /// clearDecodedMembers - release the buffers which were decoded ahead but
+  /// whose members were not included after all.
+  void clearDecodedMembers();
+
  private:
   Module& m_Module;
   ELFObjectReader& m_ELFObjectReader;
+  DecodedMembers m_DecodedMembers;
 };
 
 }  // namespace mcld
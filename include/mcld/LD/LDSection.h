@@ -102,6 +102,11 @@ class LDSection {
   ///   Before layouting, output's LDSection::align() should return zero.
   uint32_t align() const { return m_Align; }
 
+  /// entSize - the size of the entries of a section that holds a table of
+  /// fixed-size entries, such as the strings of a SHF_MERGE section.
+  ///   In ELF, it is sh_entsize.
+  uint32_t entSize() const { return m_EntSize; }
+
   size_t index() const { return m_Index; }
 
   /// getLink - return the Link. When a section A needs the other section B
@@ -125,6 +130,8 @@ class LDSection {
 
   void setAlign(uint32_t align) { m_Align = align; }
 
+  void setEntSize(uint32_t pEntSize) { m_EntSize = pEntSize; }
+
   void setFlag(uint32_t flag) { m_Flag = flag; }
 
   void setType(uint32_t type) { m_Type = type; }
@@ -189,6 +196,7 @@ class LDSection {
   uint64_t m_Offset;
   uint64_t m_Addr;
   uint32_t m_Align;
+  uint32_t m_EntSize;
 
   size_t m_Info;
   LDSection* m_pLink;
@@ -0,0 +1,131 @@
+//===- MergedStrings.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_MERGEDSTRINGS_H_
+#define MCLD_LD_MERGEDSTRINGS_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+class ThreadPool;
+
+/** \class MergedStrings
+ *  \brief MergedStrings merges the strings of the input sections with
+ *  SHF_MERGE and SHF_STRINGS into one output block.
+ *
+ *  Every input section is split into pieces, each of which is a string with
+ *  its terminator. The sections of the constants, which do not have
+ *  SHF_STRINGS, are split into the records of the entry size instead. The
+ *  same pieces of all sections are kept once: the pieces
+ *  are hashed into shards, and each shard keeps the first of its pieces in
+ *  the order of the sections, so the result does not depend on the number of
+ *  threads. With tail merging, a piece that ends another piece is kept in
+ *  the end of that piece.
+ *
+ *  An offset of an input section is mapped to the offset in the output
+ *  block by the piece that holds it.
+ */
+class MergedStrings {
+ public:
+  /// @param pEntSize - the size of a character, or of a constant
+  /// @param pAlign - the alignment of every piece in the output
+  /// @param pStrings - whether the pieces are strings or constants
+  MergedStrings(uint32_t pEntSize, uint32_t pAlign, bool pStrings = true);
+
+  /// canMerge - whether pContents can be split into strings of characters
+  /// of pEntSize bytes, or into constants of pEntSize bytes
+  static bool canMerge(llvm::StringRef pContents,
+                       uint32_t pEntSize,
+                       bool pStrings = true);
+
+  /// addSection - add the contents of an input section. The contents must
+  /// live until emit().
+  /// @return the index of the section
+  unsigned int addSection(llvm::StringRef pContents);
+
+  /// finalize - split the sections, merge the same pieces, and set up the
+  /// output offsets. No section can be added afterwards.
+  /// @param pThreadPool - the workers to use, or NULL
+  /// @param pTailMerge - whether to keep a string in the end of another one.
+  /// The constants are never tail merged.
+  void finalize(ThreadPool* pThreadPool, bool pTailMerge);
+
+  /// getOutputOffset - the offset in the output block of the byte pOffset of
+  /// the section pSection. This should be called after finalize().
+  uint64_t getOutputOffset(unsigned int pSection, uint64_t pOffset) const;
+
+  /// emit - write the output block to pBuffer, which has size() bytes
+  void emit(char* pBuffer) const;
+
+  /// getContents - the output block, which is kept by this object
+  llvm::StringRef getContents();
+
+  /// ----- observers ----- ///
+  uint64_t size() const { return m_Size; }
+
+  uint32_t entSize() const { return m_EntSize; }
+
+  uint32_t align() const { return m_Align; }
+
+  bool isStrings() const { return m_bStrings; }
+
+  size_t numOfSections() const { return m_Sections.size(); }
+
+ private:
+  struct Piece {
+    uint64_t outputOffset;
+    const char* data;
+    uint32_t size;
+    uint32_t hash;
+    uint32_t leader;  // the index of the first of the same pieces
+  };
+
+  typedef std::vector<Piece> PieceList;
+
+ private:
+  llvm::StringRef getString(const Piece& pPiece) const;
+
+  /// isSame - whether two pieces of the same hash have the same contents
+  bool isSame(const Piece& pA, const Piece& pB) const;
+
+  /// split - append the pieces of pContents to pPieces
+  void split(llvm::StringRef pContents, PieceList& pPieces) const;
+
+  /// findLeaders - set up Piece::leader for the pieces in pShard
+  void findLeaders(unsigned int pShard, unsigned int pNumOfShards);
+
+  /// assignOffsets - set up the output offsets of the leaders
+  void assignOffsets(bool pTailMerge);
+
+ private:
+  uint32_t m_EntSize;
+  uint32_t m_Align;
+  uint64_t m_Size;
+  bool m_bStrings;
+
+  /// the contents of the sections and the index of their first pieces
+  std::vector<llvm::StringRef> m_Sections;
+  std::vector<uint32_t> m_SectionBegins;
+
+  PieceList m_Pieces;
+
+  std::vector<char> m_Contents;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MergedStrings);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_MERGEDSTRINGS_H_
@@ -18,8 +18,11 @@
 #include "mcld/Support/GCFactory.h"
 
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
 
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace mcld {
 
@@ -27,12 +30,70 @@ namespace mcld {
  *  \brief Store symbol and search symbol by name. Can help symbol resolution.
  *
  *  - MCLinker is responsed for creating NamePool.
+ *
+ *  The names are spread over NumOfShards hash tables, each with its own lock,
+ *  so that reader threads can intern the names of their inputs concurrently.
+ *  Symbol resolution itself still runs on one thread, in the order of the
+ *  inputs on the command line, so the result does not depend on which thread
+ *  interned a name first. For the same reason, the resolved symbols are
+ *  traversed in the order they were first inserted, not in the order of the
+ *  hash tables.
  */
 class NamePool {
  public:
-  typedef HashTable<ResolveInfo, hash::StringHash<hash::DJB> > Table;
-  typedef Table::iterator syminfo_iterator;
-  typedef Table::const_iterator const_syminfo_iterator;
+  /** \class InfoFactory
+   *  \brief InfoFactory produces the ResolveInfo of a Table. The names which
+   *  outlive the link are referred, and the others are copied.
+   *
+   *  The entries are bump-allocated, and released all at once with the
+   *  factory.
+   */
+  class InfoFactory {
+   public:
+    typedef ResolveInfo entry_type;
+    typedef ResolveInfo::key_type key_type;
+
+   public:
+    InfoFactory() : m_bReferName(false) {}
+
+    /// setReferName - refer the names of the following produced entries
+    void setReferName(bool pRefer) { m_bReferName = pRefer; }
+
+    entry_type* produce(const key_type& pKey) {
+      if (m_bReferName)
+        return ResolveInfo::CreateRef(pKey, m_Allocator);
+      return ResolveInfo::Create(pKey, m_Allocator);
+    }
+
+    void destroy(entry_type*& pEntry) { pEntry = NULL; }
+
+   private:
+    llvm::BumpPtrAllocator m_Allocator;
+    bool m_bReferName;
+  };
+
+  typedef HashTable<ResolveInfo, hash::StringHash<hash::WY>, InfoFactory>
+      Table;
+
+  /** \class Importer
+   *  \brief Importer inserts the symbols of the inputs which are read on
+   *  demand, such as the shared objects read lazily.
+   *
+   *  The symbols of a name are imported right before the name becomes a
+   *  symbol of the pool, so that they are resolved as if the inputs had been
+   *  read in full.
+   */
+  class Importer {
+   public:
+    virtual ~Importer() {}
+
+    /// import - insert the symbols named pName which are not read yet
+    virtual void import(const llvm::StringRef& pName) = 0;
+  };
+
+  typedef std::vector<ResolveInfo*> SymbolList;
+  typedef SymbolList::iterator syminfo_iterator;
+  typedef SymbolList::const_iterator const_syminfo_iterator;
 
   typedef GCFactory<ResolveInfo*, 128> FreeInfoSet;
   typedef FreeInfoSet::iterator freeinfo_iterator;
@@ -40,6 +101,8 @@ class NamePool {
 
   typedef size_t size_type;
 
+  static const unsigned int NumOfShards = 16;
+
  public:
   explicit NamePool(size_type pSize = 3);
 
@@ -48,6 +111,7 @@ class NamePool {
   // -----  modifiers  ----- //
   /// createSymbol - create a symbol but do not insert into the pool.
   /// The created symbol did not go through the path of symbol resolution.
+  /// @param pReferName - pName outlives the link, refer it instead of copying
   ResolveInfo* createSymbol(
       const llvm::StringRef& pName,
       bool pIsDyn,
@@ -55,12 +119,20 @@ class NamePool {
       ResolveInfo::Desc pDesc,
       ResolveInfo::Binding pBinding,
       ResolveInfo::SizeType pSize,
-      ResolveInfo::Visibility pVisibility = ResolveInfo::Default);
+      ResolveInfo::Visibility pVisibility = ResolveInfo::Default,
+      bool pReferName = false);
+
+  /// intern - make sure the table has an entry for pName, so that the
+  /// following insertSymbol() of pName only looks it up. The entry is not a
+  /// symbol until it is inserted as one. Unlike the other modifiers, intern()
+  /// may be called concurrently. pName must outlive the link, it is referred.
+  void intern(const llvm::StringRef& pName);
 
   /// insertSymbol - insert a symbol and resolve the symbol immediately
   /// @param pOldInfo - if pOldInfo is not NULL, the old ResolveInfo being
   ///                   overriden is kept in pOldInfo.
   /// @param pResult the result of symbol resultion.
+  /// @param pReferName - pName outlives the link, refer it instead of copying
   /// @note pResult.override is true if the output LDSymbol also need to be
   ///       overriden
   void insertSymbol(const llvm::StringRef& pName,
@@ -72,7 +144,17 @@ class NamePool {
                     LDSymbol::ValueType pValue,
                     ResolveInfo::Visibility pVisibility,
                     ResolveInfo* pOldInfo,
-                    Resolver::Result& pResult);
+                    Resolver::Result& pResult,
+                    bool pReferName = false);
+
+  /// setImporter - insertSymbol() asks pImporter for the symbols of a name
+  /// before the name becomes a symbol. NULL disables importing.
+  void setImporter(Importer* pImporter) { m_pImporter = pImporter; }
+
+  /// import - import the symbols named pName if pName is not a symbol yet.
+  /// Lookups which may define a name, such as the symbols provided only if
+  /// referred, call it before findInfo().
+  void import(const llvm::StringRef& pName);
 
   /// findSymbol - find the resolved output LDSymbol
   const LDSymbol* findSymbol(const llvm::StringRef& pName) const;
@@ -88,18 +170,19 @@ class NamePool {
   llvm::StringRef insertString(const llvm::StringRef& pString);
 
   // -----  observers  ----- //
-  size_type size() const { return m_Table.numOfEntries(); }
+  size_type size() const { return m_Symbols.size(); }
 
-  bool empty() const { return m_Table.empty(); }
+  bool empty() const { return m_Symbols.empty(); }
 
-  // syminfo_iterator - traverse the ResolveInfo in the resolved HashTable
-  syminfo_iterator syminfo_begin() { return m_Table.begin(); }
+  // syminfo_iterator - traverse the resolved ResolveInfo in the order they
+  // were first inserted
+  syminfo_iterator syminfo_begin() { return m_Symbols.begin(); }
 
-  syminfo_iterator syminfo_end() { return m_Table.end(); }
+  syminfo_iterator syminfo_end() { return m_Symbols.end(); }
 
-  const_syminfo_iterator syminfo_begin() const { return m_Table.begin(); }
+  const_syminfo_iterator syminfo_begin() const { return m_Symbols.begin(); }
 
-  const_syminfo_iterator syminfo_end() const { return m_Table.end(); }
+  const_syminfo_iterator syminfo_end() const { return m_Symbols.end(); }
 
   // freeinfo_iterator - traverse the ResolveInfo those do not need to be
   // resolved, for example, local symbols
@@ -114,15 +197,55 @@ class NamePool {
   const_freeinfo_iterator freeinfo_end() const { return m_FreeInfoSet.end(); }
 
   // -----  capacity  ----- //
+  /// reserve - make room for pN symbols, so that inserting them does not
+  /// rehash the symbol table.
   void reserve(size_type pN);
 
   size_type capacity() const;
 
+ private:
+  struct Shard {
+    explicit Shard(size_type pSize) : table(pSize) {}
+
+    Table table;
+    std::mutex lock;
+  };
+
+  /// hashOf - the hash value of pName, which picks its shard and is passed
+  /// to the table of the shard, so that a name is hashed once
+  unsigned int hashOf(const llvm::StringRef& pName) const {
+    return m_Shards[0]->table.hash()(pName);
+  }
+
+  /// shardOf - the shard holding the names of hash value pHash. The shard is
+  /// picked by the high bits of a multiplicative hash, which are unrelated to
+  /// the bucket index and the control byte that the table derives from the
+  /// same hash value.
+  Shard& shardOf(unsigned int pHash) const {
+    return *m_Shards[(pHash * 0x9E3779B1U) >> 28];
+  }
+
+  /// insertName - insert pName, whose hash value is pHash, into its shard
+  /// under the lock of the shard
+  ResolveInfo* insertName(const llvm::StringRef& pName,
+                          unsigned int pHash,
+                          bool pReferName,
+                          bool& pExist);
+
+  /// findName - the name pName, whose hash value is pHash, which may not be
+  /// a symbol yet
+  ResolveInfo* findName(const llvm::StringRef& pName, unsigned int pHash) const;
+
  private:
   Resolver* m_pResolver;
-  Table m_Table;
+  Importer* m_pImporter;
+  Shard* m_Shards[NumOfShards];
+  SymbolList m_Symbols;
   FreeInfoSet m_FreeInfoSet;
 
+  /// m_FreeInfoAllocator - the storage of the ResolveInfo in m_FreeInfoSet
+  llvm::BumpPtrAllocator m_FreeInfoAllocator;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(NamePool);
 };
@@ -12,6 +12,9 @@
 #include "mcld/ADT/StringHash.h"
 #include "mcld/LD/LDReader.h"
 #include "mcld/LD/ResolveInfo.h"
+#include "mcld/LD/SymbolBuffer.h"
+
+#include <map>
 
 namespace mcld {
 
@@ -24,14 +27,21 @@ class Module;
  */
 class ObjectReader : public LDReader {
  protected:
-  typedef HashTable<ResolveInfo, hash::StringHash<hash::DJB> >
+  typedef HashTable<ResolveInfo, hash::StringHash<hash::WY> >
       GroupSignatureMap;
 
+  typedef std::map<const Input*, SymbolBuffer*> SymbolBufferMap;
+
  protected:
   ObjectReader() {}
 
  public:
-  virtual ~ObjectReader() { f_GroupSignatureMap.clear(); }
+  virtual ~ObjectReader() {
+    f_GroupSignatureMap.clear();
+    SymbolBufferMap::iterator buf, bufEnd = f_SymbolBufferMap.end();
+    for (buf = f_SymbolBufferMap.begin(); buf != bufEnd; ++buf)
+      delete buf->second;
+  }
 
   virtual bool readHeader(Input& pFile) = 0;
 
@@ -44,12 +54,32 @@ class ObjectReader : public LDReader {
   /// This function should be called after symbol resolution.
   virtual bool readRelocations(Input& pFile) = 0;
 
+  /// decodeSymbols - decode the symbol table of pFile into pBuffer without
+  /// touching the module. This function may be called concurrently for
+  /// different inputs, so it must not emit diagnostics. Return false if the
+  /// input can not be decoded ahead; readSymbols() then reads it as usual.
+  virtual bool decodeSymbols(Input& pFile, SymbolBuffer& pBuffer) const {
+    return false;
+  }
+
+  /// countSymbols - the number of entries in the symbol table of pFile, read
+  /// from its section headers only. It is used to size the NamePool before
+  /// any symbol is read.
+  virtual size_t countSymbols(Input& pFile) const { return 0; }
+
   GroupSignatureMap& signatures() { return f_GroupSignatureMap; }
 
   const GroupSignatureMap& signatures() const { return f_GroupSignatureMap; }
 
+  /// symbolBuffers - the symbol tables decoded ahead by decodeSymbols().
+  /// readSymbols() consumes and releases the buffer of its input.
+  SymbolBufferMap& symbolBuffers() { return f_SymbolBufferMap; }
+
+  const SymbolBufferMap& symbolBuffers() const { return f_SymbolBufferMap; }
+
  protected:
   GroupSignatureMap f_GroupSignatureMap;
+  SymbolBufferMap f_SymbolBufferMap;
 };
 
 }  // namespace mcld
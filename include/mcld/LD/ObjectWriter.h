@@ -14,6 +14,7 @@ namespace mcld {
 
 class FileOutputBuffer;
 class Module;
+class ThreadPool;
 
 /** \class ObjectWriter
  *  \brief ObjectWriter provides a common interface for object file writers.
@@ -29,6 +30,16 @@ class ObjectWriter {
                                       FileOutputBuffer& pOutput) = 0;
 
   virtual size_t getOutputSize(const Module& pModule) const = 0;
+
+  /// setThreadPool - emit independent sections on pPool. NULL means that the
+  /// writer works serially.
+  void setThreadPool(ThreadPool* pPool) { m_pThreadPool = pPool; }
+
+ protected:
+  ThreadPool* getThreadPool() const { return m_pThreadPool; }
+
+ private:
+  ThreadPool* m_pThreadPool;
 };
 
 }  // namespace mcld
@@ -40,6 +40,9 @@ class Relocator {
   /// apply - general apply function
   virtual Result applyRelocation(Relocation& pRelocation) = 0;
 
+  /// issueResult - issue the diagnostic for the result of applying pReloc.
+  void issueResult(const Relocation& pReloc, Result pResult) const;
+
   /// scanRelocation - When read in relocations, backend can do any modification
   /// to relocation and generate empty entries, such as GOT, dynamic relocation
   /// entries and other target dependent entries. These entries are generated
@@ -64,6 +67,15 @@ class Relocator {
                              LDSection& pSection,
                              Input& pInput);
 
+  /// needsScan - check if scanRelocation() may reserve entries or issue
+  /// diagnostics for pReloc in pSection. A relocation for which it returns
+  /// false is not scanned. This is called on worker threads before any scan,
+  /// so it must only read. Be conservative by default.
+  virtual bool needsScan(const Relocation& pReloc,
+                         const LDSection& pSection) const {
+    return true;
+  }
+
   /// initializeScan - do initialization before scan relocations in pInput
   /// @return - return true for initialization success
   virtual bool initializeScan(Input& pInput) { return true; }
@@ -108,6 +120,15 @@ class Relocator {
     return true;
   }
 
+  /// mayApplyConcurrently - check if the given reloc can be applied on a
+  /// worker thread. Such a relocation must only write its own target data
+  /// and its own dynamic relocation, and must not touch shared entries such
+  /// as GOT slots. initializeApply() and finalizeApply() are not called for
+  /// it. Be conservative by default.
+  virtual bool mayApplyConcurrently(const Relocation& pReloc) const {
+    return false;
+  }
+
   /// getDebugStringOffset - get the offset from the relocation target. This is
   /// used to get the debug string offset.
   virtual uint32_t getDebugStringOffset(Relocation& pReloc) const = 0;
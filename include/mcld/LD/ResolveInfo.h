@@ -10,6 +10,7 @@
 #define MCLD_LD_RESOLVEINFO_H_
 
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
 #include <llvm/Support/DataTypes.h>
 
 namespace mcld {
@@ -31,11 +32,16 @@ class LinkerConfig;
  *uses
  *  a bit field to store all attributes.
  *
- *  The maximum string length is (2^16 - 1)
+ *  The maximum string length is (2^15 - 1)
+ *
+ *  The name is either copied behind the ResolveInfo, or referred in place
+ *  when it lives in a string table which outlives the link, such as the
+ *  mapped .strtab or .dynstr of an input.
  */
 class ResolveInfo {
   friend class FragmentLinker;
   friend class IRBuilder;
+  friend class NamePool;
 
  public:
   typedef uint64_t SizeType;
@@ -78,6 +84,18 @@ class ResolveInfo {
   // -----  factory method  ----- //
   static ResolveInfo* Create(const key_type& pKey);
 
+  /// CreateRef - create a ResolveInfo which refers to pKey instead of
+  /// copying it. pKey must be null-terminated and outlive the ResolveInfo.
+  static ResolveInfo* CreateRef(const key_type& pKey);
+
+  /// Create - create a ResolveInfo in pAllocator. It is released with
+  /// pAllocator, and must not be destroyed.
+  static ResolveInfo* Create(const key_type& pKey,
+                             llvm::BumpPtrAllocator& pAllocator);
+
+  static ResolveInfo* CreateRef(const key_type& pKey,
+                                llvm::BumpPtrAllocator& pAllocator);
+
   static void Destroy(ResolveInfo*& pInfo);
 
   static ResolveInfo* Null();
@@ -177,7 +195,7 @@ class ResolveInfo {
 
   SizeType size() const { return m_Size; }
 
-  const char* name() const { return m_Name; }
+  const char* name() const { return m_pName; }
 
   unsigned int nameSize() const { return (m_BitField >> NAME_LENGTH_OFFSET); }
 
@@ -188,6 +206,20 @@ class ResolveInfo {
   // shouldForceLocal - check if this symbol should be forced to local
   bool shouldForceLocal(const LinkerConfig& pConfig);
 
+  /// elfHash - the SysV ELF hash of the name, for .hash
+  uint32_t elfHash() const {
+    if (m_ELFHash == NoHash)
+      computeHashes();
+    return m_ELFHash;
+  }
+
+  /// gnuHash - the DJB hash of the name, for .gnu.hash
+  uint32_t gnuHash() const {
+    if (m_ELFHash == NoHash)
+      computeHashes();
+    return m_GNUHash;
+  }
+
   // -----  For HashTable  ----- //
   bool compare(const key_type& pKey);
 
@@ -225,6 +257,10 @@ class ResolveInfo {
   static const uint32_t INFO_MASK = 0xF;
   static const uint32_t RESOLVE_MASK = 0xFFFF;
 
+  /// NoHash - m_ELFHash before the hashes are computed. The top four bits
+  /// of an ELF hash are always zero, so it never collides with a real one.
+  static const uint32_t NoHash = 0xFFFFFFFF;
+
   union SymOrInfo {
     LDSymbol* sym_ptr;
     ResolveInfo* info_ptr;
@@ -255,9 +291,25 @@ class ResolveInfo {
   ResolveInfo& operator=(const ResolveInfo& pCopy);
   ~ResolveInfo();
 
+  /// setName - refer pName on a newly constructed ResolveInfo
+  void setName(const key_type& pName);
+
+  /// construct - construct a ResolveInfo at pStorage. If pCopy is true, the
+  /// name is copied behind the ResolveInfo, and pStorage must have room for
+  /// it.
+  static ResolveInfo* construct(void* pStorage,
+                                const key_type& pKey,
+                                bool pCopy);
+
+  /// computeHashes - compute and cache the hashes of the dynamic symbol hash
+  /// tables, so that the name is hashed once however many of the tables are
+  /// emitted. It is not thread-safe.
+  void computeHashes() const;
+
  private:
   SizeType m_Size;
   SymOrInfo m_Ptr;
+  const char* m_pName;
 
   /** m_BitField
    *  31     ...    17 16    15    12 11     10..7 6      ..    5 4     3   2
@@ -266,6 +318,10 @@ class ResolveInfo {
    * visibility|Local|Com|Def|Dyn|Weak|
    */
   uint32_t m_BitField;
+  mutable uint32_t m_ELFHash;
+  mutable uint32_t m_GNUHash;
+
+  /// m_Name - the storage of a copied name
   char m_Name[1];
 };
 
@@ -14,16 +14,24 @@
 #include "mcld/Support/Allocators.h"
 #include "mcld/Support/Compiler.h"
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/ilist.h>
 #include <llvm/ADT/ilist_node.h>
 #include <llvm/Support/DataTypes.h>
 
+#include <vector>
+
 namespace mcld {
 
 class LDSection;
 
 /** \class SectionData
  *  \brief SectionData provides a container for all Fragments.
+ *
+ *  SectionData keeps an index of the end offsets of its fragments, which
+ *  findFragment() builds on demand and searches in O(log n). Since all the
+ *  changes of the fragment list go through the non-const getFragmentList(),
+ *  calling it drops the index.
  */
 class SectionData {
  private:
@@ -55,7 +63,10 @@ class SectionData {
   LDSection& getSection() { return *m_pSection; }
 
   const FragmentListType& getFragmentList() const { return m_Fragments; }
-  FragmentListType& getFragmentList() { return m_Fragments; }
+  FragmentListType& getFragmentList() {
+    m_bIndexValid = false;
+    return m_Fragments;
+  }
 
   /// Support for Fragment::getNextNode()
   static FragmentListType SectionData::*getSublistAccess(Fragment * frag) {
@@ -80,10 +91,28 @@ class SectionData {
   const_reverse_iterator rend() const { return m_Fragments.rend(); }
   reverse_iterator rend() { return m_Fragments.rend(); }
 
+  /// findFragment - find the fragment which holds the byte pOffset bytes
+  /// after the start of pFrag, and set pFragOffset to the offset of the byte
+  /// in it. A byte at the end of a non-empty fragment is held by the next
+  /// one. Return NULL if the byte is out of the section.
+  Fragment* findFragment(const Fragment& pFrag,
+                         uint64_t pOffset,
+                         uint64_t& pFragOffset);
+
+ private:
+  /// buildIndex - compute the end offsets of all fragments
+  void buildIndex();
+
  private:
   FragmentListType m_Fragments;
   LDSection* m_pSection;
 
+  // the index of findFragment()
+  bool m_bIndexValid;
+  std::vector<Fragment*> m_IndexedFragments;
+  std::vector<uint64_t> m_FragmentEnds;
+  llvm::DenseMap<const Fragment*, size_t> m_FragmentPositions;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(SectionData);
 };
@@ -0,0 +1,73 @@
+//===- ShlibSymbolCache.h -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_SHLIBSYMBOLCACHE_H_
+#define MCLD_LD_SHLIBSYMBOLCACHE_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <stdint.h>
+#include <string>
+
+namespace mcld {
+
+class Input;
+class SymbolBuffer;
+
+/** \class ShlibSymbolCache
+ *  \brief ShlibSymbolCache keeps the decoded .dynsym of shared objects in a
+ *  directory, to be shared by the links against the same libraries.
+ *
+ *  A cache file holds the entries of a SymbolBuffer and its groups of weak
+ *  aliases. The names are kept as offsets into .dynstr, which is still read
+ *  from the mapped shared object. A cache file is only used for the same
+ *  file, which is identified by its path, device, inode, size and
+ *  modification time, and for the same target triple.
+ *
+ *  The cache files are written to a temporary file and renamed, so that the
+ *  concurrent links see either a whole cache file or none.
+ */
+class ShlibSymbolCache {
+ public:
+  ShlibSymbolCache(const std::string& pDirectory, const std::string& pTriple);
+
+  /// load - fill pBuffer with the cached .dynsym of pInput, whose string table
+  /// is pStrTab. Return false if there is no valid cache file of pInput.
+  bool load(const Input& pInput,
+            llvm::StringRef pStrTab,
+            SymbolBuffer& pBuffer) const;
+
+  /// store - write pBuffer, the .dynsym of pInput, to the cache. Return false
+  /// if it can not be written.
+  bool store(const Input& pInput,
+             llvm::StringRef pStrTab,
+             const SymbolBuffer& pBuffer) const;
+
+ private:
+  struct Header;
+  struct Entry;
+
+  /// getKey - fill the key fields of pHeader by the file of pInput
+  bool getKey(const Input& pInput, Header& pHeader) const;
+
+  /// getCacheFile - the path of the cache file of pInput
+  std::string getCacheFile(const Input& pInput) const;
+
+ private:
+  std::string m_Directory;
+  std::string m_Triple;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ShlibSymbolCache);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_SHLIBSYMBOLCACHE_H_
@@ -0,0 +1,94 @@
+//===- StringTableBuilder.h -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_STRINGTABLEBUILDER_H_
+#define MCLD_LD_STRINGTABLEBUILDER_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+/** \class StringTableBuilder
+ *  \brief StringTableBuilder lays out an ELF string table, such as .strtab,
+ *  .dynstr and .shstrtab, in which every string is kept once.
+ *
+ *  The table starts with '\0', which is also the empty string. The strings
+ *  are placed in the order they are first added. With tail merging, a
+ *  string that ends another string is kept in the end of that string.
+ *
+ *  The offsets are looked up by the strings, so the writer may emit the
+ *  symbols in another order than they are added in.
+ */
+class StringTableBuilder {
+ public:
+  explicit StringTableBuilder(bool pTailMerge);
+
+  /// add - add a string, which must live as long as the table
+  void add(llvm::StringRef pString);
+
+  /// finalize - set up the offsets of the strings. No string can be added
+  /// afterwards.
+  /// @return the size of the table
+  uint64_t finalize();
+
+  /// getOffset - the offset of pString, which must have been added. This
+  /// should be called after finalize().
+  uint64_t getOffset(llvm::StringRef pString) const;
+
+  /// append - the offset of pString, which is placed in the end of the table
+  /// if it has not been added. This is for the names which come after the
+  /// table is finalized, such as the stubs of relaxation, whose room is
+  /// reserved by the caller.
+  uint64_t append(llvm::StringRef pString);
+
+  /// emit - write the table to pBuffer, which has size() bytes
+  void emit(char* pBuffer) const;
+
+  /// ----- observers ----- ///
+  uint64_t size() const { return m_Size; }
+
+  /// numOfStrings - the number of the different strings
+  size_t numOfStrings() const { return m_Strings.size(); }
+
+ private:
+  struct Entry {
+    llvm::StringRef str;
+    uint64_t offset;
+    uint32_t hash;
+  };
+
+  /// findSlot - the slot of pString in m_Table, which is empty if pString
+  /// has not been added
+  size_t findSlot(llvm::StringRef pString, uint32_t pHash) const;
+
+  /// insert - add pString to the empty slot pSlot
+  uint32_t insert(size_t pSlot, llvm::StringRef pString, uint32_t pHash);
+
+ private:
+  bool m_bTailMerge;
+  bool m_bFinalized;
+  uint64_t m_Size;
+
+  /// the different strings, in the order they are first added
+  std::vector<Entry> m_Strings;
+
+  /// an open addressing table of the indices of m_Strings
+  std::vector<uint32_t> m_Table;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(StringTableBuilder);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_STRINGTABLEBUILDER_H_
@@ -0,0 +1,85 @@
+//===- SymbolBuffer.h -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_SYMBOLBUFFER_H_
+#define MCLD_LD_SYMBOLBUFFER_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace mcld {
+
+/** \class SymbolBuffer
+ *  \brief SymbolBuffer holds the raw symbol table of an input file which has
+ *  been decoded in host byte order, ahead of symbol resolution.
+ *
+ *  Decoding touches only the mapped file, so buffers of different inputs can
+ *  be filled concurrently. The buffers are then replayed into the NamePool in
+ *  command-line order, which keeps the resolution result deterministic.
+ *
+ *  The buffer of a shared object also carries its groups of weak aliases,
+ *  so that a buffer loaded from the ShlibSymbolCache needs no alias analysis.
+ */
+class SymbolBuffer {
+ public:
+  struct Entry {
+    llvm::StringRef name;  ///< points into the mapped string table
+    uint64_t value;
+    uint64_t size;
+    uint16_t shndx;
+    uint8_t info;
+    uint8_t other;
+  };
+
+  typedef std::vector<Entry> EntryList;
+  typedef EntryList::const_iterator const_iterator;
+
+  /// AliasList - the groups of weak aliases. Each group is its size followed
+  /// by the positions of its entries in the buffer, the weak symbol which
+  /// heads the alias list first.
+  typedef std::vector<uint32_t> AliasList;
+
+ public:
+  SymbolBuffer() {}
+
+  void reserve(size_t pSize) { m_Entries.reserve(pSize); }
+
+  void append(const Entry& pEntry) { m_Entries.push_back(pEntry); }
+
+  void clear() {
+    m_Entries.clear();
+    m_Aliases.clear();
+  }
+
+  size_t size() const { return m_Entries.size(); }
+
+  bool empty() const { return m_Entries.empty(); }
+
+  const_iterator begin() const { return m_Entries.begin(); }
+  const_iterator end() const { return m_Entries.end(); }
+
+  const Entry& at(size_t pPos) const { return m_Entries[pPos]; }
+
+  AliasList& aliases() { return m_Aliases; }
+  const AliasList& aliases() const { return m_Aliases; }
+
+ private:
+  EntryList m_Entries;
+  AliasList m_Aliases;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SymbolBuffer);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_SYMBOLBUFFER_H_
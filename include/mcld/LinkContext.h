@@ -0,0 +1,127 @@
+//===- LinkContext.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LINKCONTEXT_H_
+#define MCLD_LINKCONTEXT_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <vector>
+
+namespace mcld {
+
+/** \class LinkContext
+ *  \brief LinkContext owns the per-link arenas: the factories of sections,
+ *  fragments, symbols, relocations and script objects.
+ *
+ *  Every thread has a current LinkContext. The static Create()/Destroy()
+ *  functions of the IR classes allocate from the factories of the current
+ *  context, so links running on different threads never share an arena.
+ *  Threads that never activate a context use the process-wide default one.
+ *
+ *  Objects are created in the context on first use and released together by
+ *  release() or by the destructor, in the reverse order of their creation.
+ */
+class LinkContext {
+ public:
+  /** \class Scope
+   *  \brief Scope makes a LinkContext current on the calling thread for its
+   *  lifetime, and restores the previous one afterwards.
+   */
+  class Scope {
+   public:
+    explicit Scope(LinkContext& pContext)
+        : m_pPrevious(LinkContext::activate(&pContext)) {}
+
+    ~Scope() { LinkContext::activate(m_pPrevious); }
+
+   private:
+    LinkContext* m_pPrevious;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(Scope);
+  };
+
+ public:
+  LinkContext();
+
+  ~LinkContext();
+
+  /// current - the context of the calling thread.
+  static LinkContext& current();
+
+  /// activate - make pContext current on the calling thread and return the
+  /// previously activated one. A NULL pContext restores the default context.
+  static LinkContext* activate(LinkContext* pContext);
+
+  /// get - the T owned by this context. It is default-constructed on first
+  /// use.
+  template <typename T>
+  T& get();
+
+  /// release - destroy every object owned by this context. The context can be
+  /// used again afterwards.
+  void release();
+
+ private:
+  typedef void (*DestroyFn)(void* pObject);
+
+  struct Slot {
+    void* object;
+    DestroyFn destroy;
+  };
+
+  template <typename T>
+  static void destroy(void* pObject) {
+    delete static_cast<T*>(pObject);
+  }
+
+  /// nextID - allocate a dense slot index for a new object type.
+  static unsigned int nextID();
+
+  Slot& slot(unsigned int pID);
+
+  void create(unsigned int pID, void* pObject, DestroyFn pDestroy);
+
+ private:
+  std::vector<Slot> m_Slots;
+
+  /// the slot indices in the order their objects were created
+  std::vector<unsigned int> m_Order;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LinkContext);
+};
+
+template <typename T>
+T& LinkContext::get() {
+  static const unsigned int id = nextID();
+  if (slot(id).object == NULL) {
+    // T's constructor may create other objects in this context, so the slot
+    // is looked up again after construction.
+    T* object = new T();
+    create(id, object, &destroy<T>);
+  }
+  return *static_cast<T*>(slot(id).object);
+}
+
+/** \class LinkStatic
+ *  \brief LinkStatic is a drop-in replacement for llvm::ManagedStatic whose
+ *  object lives in the current LinkContext instead of the process.
+ */
+template <typename T>
+class LinkStatic {
+ public:
+  T& operator*() const { return LinkContext::current().get<T>(); }
+
+  T* operator->() const { return &LinkContext::current().get<T>(); }
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LINKCONTEXT_H_
@@ -16,6 +16,7 @@ namespace mcld {
 class FileHandle;
 class FileOutputBuffer;
 class IRBuilder;
+class LinkContext;
 class LinkerConfig;
 class LinkerScript;
 class Module;
@@ -59,6 +60,11 @@ class Linker {
 
   bool reset();
 
+  /// context - the LinkContext that owns the objects of this link. Callers
+  /// that build the IR on their own (e.g. through IRBuilder) should activate
+  /// it with LinkContext::Scope.
+  LinkContext& context() { return *m_pContext; }
+
  private:
   bool initTarget();
 
@@ -68,6 +74,9 @@ class Linker {
 
   bool initEmulator(LinkerScript& pScript);
 
+  /// printTimeTrace - print the summary and the JSON file of --time-trace.
+  void printTimeTrace() const;
+
  private:
   LinkerConfig* m_pConfig;
   IRBuilder* m_pIRBuilder;
@@ -75,6 +84,8 @@ class Linker {
   const Target* m_pTarget;
   TargetLDBackend* m_pBackend;
   ObjectLinker* m_pObjLinker;
+
+  LinkContext* m_pContext;
 };
 
 }  // namespace mcld
@@ -18,6 +18,8 @@
 #include "mcld/LD/SectionSymbolSet.h"
 #include "mcld/MC/SymbolCategory.h"
 
+#include <llvm/ADT/StringMap.h>
+
 #include <vector>
 #include <string>
 
@@ -104,7 +106,14 @@ class Module {
 
   // -----  sections  ----- //
   const SectionTable& getSectionTable() const { return m_SectionTable; }
-  SectionTable& getSectionTable() { return m_SectionTable; }
+
+  /// getSectionTable - the table may be changed through the reference, so the
+  /// index of getSection() is rebuilt afterwards. Use addSection() and
+  /// clearSections() to keep it.
+  SectionTable& getSectionTable() {
+    m_bSectionIndexValid = false;
+    return m_SectionTable;
+  }
 
   iterator begin() { return m_SectionTable.begin(); }
   const_iterator begin() const { return m_SectionTable.begin(); }
@@ -117,9 +126,16 @@ class Module {
   size_t size() const { return m_SectionTable.size(); }
   bool empty() const { return m_SectionTable.empty(); }
 
+  /// getSection - the first section named pName, or NULL
   LDSection* getSection(const std::string& pName);
   const LDSection* getSection(const std::string& pName) const;
 
+  /// addSection - append pSection to the section table
+  void addSection(LDSection& pSection);
+
+  /// clearSections - remove all the sections from the section table
+  void clearSections();
+
   /// @}
   /// @name Symbol Accessors
   /// @{
@@ -161,6 +177,10 @@ class Module {
   void addAlias(const ResolveInfo& pAlias);
   AliasList* getAliasList(const ResolveInfo& pSym);
 
+ private:
+  /// buildSectionIndex - index the section table by name
+  void buildSectionIndex();
+
  private:
   std::string m_Name;
   LinkerScript& m_Script;
@@ -168,6 +188,8 @@ class Module {
   LibraryList m_LibraryList;
   InputTree m_MainTree;
   SectionTable m_SectionTable;
+  llvm::StringMap<LDSection*> m_SectionIndex;  // the first section of a name
+  bool m_bSectionIndexValid;
   SymbolTable m_SymbolTable;
   NamePool m_NamePool;
   SectionSymbolSet m_SectSymbolSet;
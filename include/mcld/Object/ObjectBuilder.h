@@ -10,10 +10,13 @@
 #define MCLD_OBJECT_OBJECTBUILDER_H_
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDFileFormat.h"
+#include "mcld/Object/SectionMap.h"
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/DataTypes.h>
 
 #include <string>
+#include <utility>
 
 namespace mcld {
 
@@ -56,7 +59,9 @@ class ObjectBuilder {
 
   /// MergeSection - merge the pInput section to mcld::Module.
   /// This function moves all fragments in pInputSection to the corresponding
-  /// output section of mcld::Module.
+  /// output section of mcld::Module. The output section last matched by each
+  /// input section name is remembered for the lifetime of the builder, which
+  /// must not outlive the section table of mcld::Module.
   ///
   /// @see SectionMap
   /// @param [in] pInputSection The merged input section.
@@ -92,8 +97,14 @@ class ObjectBuilder {
                                  SectionData& pSD,
                                  uint32_t pAlignConstraint = 1);
 
+ private:
+  /// LastMatch - the output section description and the output section last
+  /// matched by an input section name
+  typedef std::pair<const SectionMap::Output*, LDSection*> LastMatch;
+
  private:
   Module& m_Module;
+  llvm::StringMap<LastMatch> m_LastMatches;
 };
 
 }  // namespace mcld
@@ -10,6 +10,8 @@
 #define MCLD_OBJECT_OBJECTLINKER_H_
 #include <llvm/Support/DataTypes.h>
 
+#include <vector>
+
 namespace mcld {
 
 class ArchiveReader;
@@ -21,7 +23,9 @@ class ExecWriter;
 class FileOutputBuffer;
 class GroupReader;
 class IRBuilder;
+class LDSection;
 class LinkerConfig;
+class MergedStrings;
 class Module;
 class ObjectReader;
 class ObjectWriter;
@@ -29,6 +33,7 @@ class Relocation;
 class ResolveInfo;
 class ScriptReader;
 class TargetLDBackend;
+class ThreadPool;
 
 /** \class ObjectLinker
  */
@@ -145,7 +150,39 @@ class ObjectLinker {
   const ObjectWriter* getWriter() const { return m_pWriter; }
   ObjectWriter* getWriter() { return m_pWriter; }
 
+  /// getThreadPool - the worker threads of this link. NULL if --threads is
+  /// not greater than 1.
+  ThreadPool* getThreadPool() { return m_pThreadPool; }
+
  private:
+  /// reserveNamePool - size the NamePool for the symbols of the object files
+  /// and shared libraries on the command line, counted from their section
+  /// headers, so that the symbol table is allocated once.
+  void reserveNamePool();
+
+  /// decodeInputs - decode the symbol tables of the relocatable objects on
+  /// the command line concurrently. normalize() then resolves the decoded
+  /// symbols in command-line order.
+  void decodeInputs();
+
+  /// scanRelocationsConcurrently - classify the relocations of all inputs on
+  /// the worker threads, then scan those which may reserve entries in input
+  /// order.
+  bool scanRelocationsConcurrently();
+
+  /// applyRelocationsConcurrently - apply the relocations of all inputs on
+  /// the worker threads. Relocations that the target does not allow to be
+  /// applied concurrently, and those against .debug_str, are applied
+  /// afterwards in input order.
+  void applyRelocationsConcurrently(LDSection* pDebugStr);
+
+  /// mergeStrings - merge the strings and the constants of the allocated
+  /// SHF_MERGE input sections that go to the same output section. The first
+  /// of those sections keeps the merged pieces, the others are folded, and
+  /// the symbols and the relocations against them are moved to the merged
+  /// pieces.
+  void mergeStrings();
+
   /// normalSyncRelocationResult - sync relocation result when producing shared
   /// objects or executables
   void normalSyncRelocationResult(FileOutputBuffer& pOutput);
@@ -177,6 +214,11 @@ class ObjectLinker {
   BinaryReader* m_pBinaryReader;
   ScriptReader* m_pScriptReader;
   ObjectWriter* m_pWriter;
+
+  ThreadPool* m_pThreadPool;
+
+  /// the merged strings, which keep the contents of their fragments
+  std::vector<MergedStrings*> m_MergedStrings;
 };
 
 }  // namespace mcld
@@ -13,6 +13,7 @@
 #include "mcld/Script/InputSectDesc.h"
 #include "mcld/Script/OutputSectDesc.h"
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/DataTypes.h>
 
 #include <string>
@@ -25,6 +26,11 @@ class LDSection;
 
 /** \class SectionMap
  *  \brief descirbe how to map input sections into output sections
+ *
+ *  find(file, section) looks only at the input descriptions whose section
+ *  patterns may match the first character of the section, and remembers its
+ *  results. Both are dropped by insert() and by the non-const accessors of
+ *  the output descriptions, which may reorder them.
  */
 class SectionMap {
  public:
@@ -155,6 +161,7 @@ class SectionMap {
   typedef OutputDescList::reverse_iterator reverse_iterator;
 
  public:
+  SectionMap();
   ~SectionMap();
 
   const_mapping find(const std::string& pInputFile,
@@ -175,19 +182,37 @@ class SectionMap {
   size_t size() const { return m_OutputDescList.size(); }
 
   const_iterator begin() const { return m_OutputDescList.begin(); }
-  iterator begin() { return m_OutputDescList.begin(); }
+  iterator begin() {
+    m_bIndexValid = false;
+    return m_OutputDescList.begin();
+  }
   const_iterator end() const { return m_OutputDescList.end(); }
-  iterator end() { return m_OutputDescList.end(); }
+  iterator end() {
+    m_bIndexValid = false;
+    return m_OutputDescList.end();
+  }
 
   const_reference front() const { return m_OutputDescList.front(); }
-  reference front() { return m_OutputDescList.front(); }
+  reference front() {
+    m_bIndexValid = false;
+    return m_OutputDescList.front();
+  }
   const_reference back() const { return m_OutputDescList.back(); }
-  reference back() { return m_OutputDescList.back(); }
+  reference back() {
+    m_bIndexValid = false;
+    return m_OutputDescList.back();
+  }
 
   const_reverse_iterator rbegin() const { return m_OutputDescList.rbegin(); }
-  reverse_iterator rbegin() { return m_OutputDescList.rbegin(); }
+  reverse_iterator rbegin() {
+    m_bIndexValid = false;
+    return m_OutputDescList.rbegin();
+  }
   const_reverse_iterator rend() const { return m_OutputDescList.rend(); }
-  reverse_iterator rend() { return m_OutputDescList.rend(); }
+  reverse_iterator rend() {
+    m_bIndexValid = false;
+    return m_OutputDescList.rend();
+  }
 
   iterator insert(iterator pPosition, LDSection* pSection);
 
@@ -195,14 +220,44 @@ class SectionMap {
   void fixupDotSymbols();
 
  private:
-  bool matched(const Input& pInput,
-               const std::string& pInputFile,
-               const std::string& pInputSection) const;
+  /// Candidate - an input description, in the order that find() tries them
+  struct Candidate {
+    Output* output;
+    Input* input;
+    bool anyFile;  // the description takes the sections of every file
+  };
+
+  typedef std::vector<Candidate> CandidateList;
+
+  /// CandidateIndex - the positions of candidates in the CandidateList
+  typedef std::vector<uint32_t> CandidateIndex;
+
+  /// buildIndex - group the candidates by the first characters of their
+  /// section patterns, and drop the remembered results
+  void buildIndex() const;
 
-  bool matched(const WildcardPattern& pPattern, const std::string& pName) const;
+  /// lookup - the first input description that takes pInputSection of
+  /// pInputFile
+  mapping lookup(const std::string& pInputFile,
+                 const std::string& pInputSection) const;
+
+  bool matchedFile(const Input& pInput, const std::string& pInputFile) const;
+
+  bool matchedSection(const Input& pInput,
+                      const std::string& pInputSection) const;
 
  private:
   OutputDescList m_OutputDescList;
+
+  mutable bool m_bIndexValid;
+  mutable CandidateList m_Candidates;
+  mutable CandidateIndex m_FirstCharIndex[256];
+  mutable CandidateIndex m_AnyCharIndex;  // patterns starting with a wildcard
+
+  /// the results of find(), by the section name when they do not depend on
+  /// the file, and by the file and the section name otherwise
+  mutable llvm::StringMap<mapping> m_SectionMemo;
+  mutable llvm::StringMap<mapping> m_FileMemo;
 };
 
 }  // namespace mcld
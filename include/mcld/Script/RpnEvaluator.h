@@ -22,13 +22,13 @@ class TargetLDBackend;
  */
 class RpnEvaluator {
  public:
-  RpnEvaluator(const Module& pModule, const TargetLDBackend& pBackend);
+  RpnEvaluator(Module& pModule, const TargetLDBackend& pBackend);
 
   // evaluate a valid expression and set the value in the second parameter
   bool eval(const RpnExpr& pExpr, uint64_t& pResult);
 
  private:
-  const Module& m_Module;
+  Module& m_Module;
   const TargetLDBackend& m_Backend;
 };
 
@@ -19,10 +19,25 @@ namespace mcld {
 
 /** \class WildcardPattern
  *  \brief This class defines the interfaces to Input Section Wildcard Patterns
+ *
+ *  A pattern is classified once when it is created. The patterns with only
+ *  '*' and '?' are matched without fnmatch(): a literal name, a prefix, a
+ *  suffix or a substring is compared directly, and the others are matched
+ *  by a small glob matcher. The patterns with brackets or escapes are left
+ *  to fnmatch().
  */
 
 class WildcardPattern : public StrToken {
  public:
+  enum MatchKind {
+    MATCH_LITERAL,   // name
+    MATCH_PREFIX,    // name*
+    MATCH_SUFFIX,    // *name
+    MATCH_CONTAINS,  // *name*
+    MATCH_GLOB,      // any other pattern of '*' and '?'
+    MATCH_FNMATCH    // patterns with '[' or '\\'
+  };
+
   enum SortPolicy {
     SORT_NONE,
     SORT_BY_NAME,
@@ -42,10 +57,22 @@ class WildcardPattern : public StrToken {
 
   SortPolicy sortPolicy() const { return m_SortPolicy; }
 
-  bool isPrefix() const { return m_bIsPrefix; }
+  MatchKind matchKind() const { return m_MatchKind; }
+
+  bool isPrefix() const { return m_MatchKind == MATCH_PREFIX; }
+
+  /// matchesAll - whether every name is matched, as by "*"
+  bool matchesAll() const {
+    return m_MatchKind == MATCH_CONTAINS && m_LiteralSize == 0;
+  }
 
+  /// prefix - the literal characters before the first metacharacter, which
+  /// every matched name starts with
   llvm::StringRef prefix() const;
 
+  /// matches - whether pName is matched by this pattern
+  bool matches(llvm::StringRef pName) const;
+
   static bool classof(const StrToken* pToken) {
     return pToken->kind() == StrToken::Wildcard;
   }
@@ -56,9 +83,19 @@ class WildcardPattern : public StrToken {
   static void destroy(WildcardPattern*& pToken);
   static void clear();
 
+ private:
+  /// compile - classify the pattern and keep its literal part
+  void compile();
+
+  /// globMatch - match pName against a pattern of '*' and '?'
+  static bool globMatch(llvm::StringRef pPattern, llvm::StringRef pName);
+
  private:
   SortPolicy m_SortPolicy;
-  bool m_bIsPrefix;
+  MatchKind m_MatchKind;
+  size_t m_PrefixSize;
+  size_t m_LiteralBegin;  // the literal part of a name, a prefix, a suffix
+  size_t m_LiteralSize;   // or a substring pattern
 };
 
 }  // namespace mcld
@@ -39,6 +39,10 @@ class MemoryArea {
 
   size_t size() const;
 
+  /// contains - whether pRegion lies in this area, and thus stays valid as
+  /// long as the area does
+  bool contains(llvm::StringRef pRegion) const;
+
  private:
   std::unique_ptr<llvm::MemoryBuffer> m_pMemoryBuffer;
 
@@ -36,6 +36,14 @@ long GetRandomNum();
 /// SetRandomSeed - set the initial seed value for future calls to random().
 void SetRandomSeed(unsigned pSeed);
 
+/// GetProcessCPUTime - the user and system CPU time consumed by the process so
+/// far, in microseconds.
+uint64_t GetProcessCPUTime();
+
+/// GetResidentSetSize - the resident set size of the process in bytes, or 0
+/// if it is unknown.
+uint64_t GetResidentSetSize();
+
 }  // namespace sys
 }  // namespace mcld
 
@@ -0,0 +1,76 @@
+//===- ThreadPool.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_THREADPOOL_H_
+#define MCLD_SUPPORT_THREADPOOL_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcld {
+
+/** \class ThreadPool
+ *  \brief ThreadPool runs independent tasks on a fixed set of worker threads.
+ *
+ *  Tasks must not emit diagnostics or allocate from the LinkContext factories
+ *  (workers do not inherit the caller's current context); they should
+ *  record their results in task-private buffers, and the caller merges them
+ *  in a deterministic order after wait() returns.
+ */
+class ThreadPool {
+ public:
+  typedef std::function<void()> Task;
+  typedef std::function<void(size_t)> IndexedTask;
+
+ public:
+  /// @param pNumThreads - the number of worker threads. It must be positive.
+  explicit ThreadPool(unsigned int pNumThreads);
+
+  ~ThreadPool();
+
+  /// async - queue pTask to be run by one of the workers.
+  void async(const Task& pTask);
+
+  /// wait - block until all queued tasks have finished.
+  void wait();
+
+  /// parallelFor - run pTask(i) for every i in [pBegin, pEnd) and wait for
+  /// all of them. Indices are dispatched in chunks of pGrainSize.
+  void parallelFor(size_t pBegin,
+                   size_t pEnd,
+                   const IndexedTask& pTask,
+                   size_t pGrainSize = 1);
+
+  unsigned int size() const { return m_Workers.size(); }
+
+ private:
+  void work();
+
+ private:
+  std::vector<std::thread> m_Workers;
+  std::deque<Task> m_Tasks;
+  std::mutex m_Mutex;
+  std::condition_variable m_TaskCond;
+  std::condition_variable m_DoneCond;
+  unsigned int m_NumOfActive;
+  bool m_bStop;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_THREADPOOL_H_
@@ -0,0 +1,114 @@
+//===- TimeTrace.h --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_TIMETRACE_H_
+#define MCLD_SUPPORT_TIMETRACE_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+/** \class TimeTrace
+ *  \brief TimeTrace records the wall time, CPU time and resident set size
+ *  delta of the nested phases of a link (--time-trace).
+ *
+ *  Each link has its own TimeTrace in the current LinkContext. Phases are
+ *  recorded with TimeTrace::Scope, which costs nothing but a lookup when the
+ *  trace is disabled. Only the thread that drives the link records phases;
+ *  work dispatched to the ThreadPool is accounted to the enclosing phase.
+ */
+class TimeTrace {
+ public:
+  struct Event {
+    std::string name;
+    std::string detail;
+    uint64_t start;     ///< wall time since the trace was enabled, in us
+    uint64_t wall;      ///< in us
+    uint64_t cpu;       ///< process CPU time, in us
+    int64_t rss_delta;  ///< in bytes
+    unsigned int depth;
+  };
+
+  typedef std::vector<Event> EventList;
+
+  /** \class Scope
+   *  \brief Scope records one phase of the current link's TimeTrace.
+   */
+  class Scope {
+   public:
+    explicit Scope(llvm::StringRef pName, llvm::StringRef pDetail = "");
+
+    ~Scope();
+
+   private:
+    TimeTrace* m_pTrace;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(Scope);
+  };
+
+ public:
+  TimeTrace();
+
+  /// current - the TimeTrace of the current LinkContext.
+  static TimeTrace& current();
+
+  /// enable - start recording. The timestamps of events are relative to the
+  /// moment the trace is enabled.
+  void enable();
+
+  bool isEnabled() const { return m_bEnabled; }
+
+  /// begin - open a phase nested in the innermost open one.
+  void begin(llvm::StringRef pName, llvm::StringRef pDetail = "");
+
+  /// end - close the innermost open phase.
+  void end();
+
+  const EventList& events() const { return m_Events; }
+
+  /// printJSON - print the events in Chrome trace-event format, which can be
+  /// loaded by chrome://tracing or Perfetto.
+  void printJSON(llvm::raw_ostream& pOS) const;
+
+  /// printSummary - print the phases as an indented table. Repeated phases at
+  /// the same position of the tree (e.g. relaxation passes) are merged.
+  void printSummary(llvm::raw_ostream& pOS) const;
+
+ private:
+  struct OpenEvent {
+    size_t index;
+    uint64_t cpu;
+    uint64_t rss;
+  };
+
+  uint64_t now() const;
+
+ private:
+  bool m_bEnabled;
+  uint64_t m_Origin;
+  EventList m_Events;
+  std::vector<OpenEvent> m_Stack;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TimeTrace);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_TIMETRACE_H_
@@ -39,6 +39,7 @@ class LinkerConfig;
 class LinkerScript;
 class Module;
 class Relocation;
+class StringTableBuilder;
 class StubFactory;
 
 /** \class GNULDBackend
@@ -109,6 +110,9 @@ class GNULDBackend : public TargetLDBackend {
   /// sizeShstrtab - compute the size of .shstrtab
   void sizeShstrtab(Module& pModule);
 
+  /// getShStrTab - the layout of .shstrtab. NULL before sizeShstrtab().
+  const StringTableBuilder* getShStrTab() const { return m_pShStrTab; }
+
   /// sizeNamePools - compute the size of regular name pools
   /// In ELF executable files, regular name pools are .symtab, .strtab.,
   /// .dynsym, .dynstr, and .hash
@@ -533,6 +537,14 @@ class GNULDBackend : public TargetLDBackend {
   // map the LDSymbol to its index in the output symbol table
   HashTableType* m_pSymIndexMap;
 
+  // the layouts of .strtab, .dynstr and .shstrtab
+  StringTableBuilder* m_pStrTab;
+  StringTableBuilder* m_pDynStrTab;
+  StringTableBuilder* m_pShStrTab;
+
+  // the DT_RPATH or DT_RUNPATH string in .dynstr, joined by ':'
+  std::string m_DynRPath;
+
   // section .eh_frame_hdr
   EhFrameHdr* m_pEhFrameHdr;
 
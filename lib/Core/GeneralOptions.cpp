@@ -39,6 +39,7 @@ GeneralOptions::GeneralOptions()
       m_bNow(false),
       m_bOrigin(false),
       m_bTrace(false),
+      m_bTimeTrace(false),
       m_Bsymbolic(false),
       m_Bgroup(false),
       m_bPIE(false),
@@ -59,8 +60,11 @@ GeneralOptions::GeneralOptions()
       m_bPrintGCSections(false),
       m_bGenUnwindInfo(true),
       m_bPrintICFSections(false),
+      m_bLazyShlibSymbols(false),
+      m_bTailMergeStrings(false),
       m_ICF(ICF::None),
       m_ICFIterations(2),
+      m_NumThreads(1),
       m_StripSymbols(StripSymbolMode::KeepAllSymbols),
       m_HashStyle(HashStyle::SystemV) {
 }
@@ -395,7 +395,7 @@ uint64_t IRBuilder::AppendEhFrame(EhFrame::CIE& pCIE, EhFrame& pEhFrame) {
 /// AddSymbol - To add a symbol in the input file and resolve the symbol
 /// immediately
 LDSymbol* IRBuilder::AddSymbol(Input& pInput,
-                               const std::string& pName,
+                               const llvm::StringRef& pName,
                                ResolveInfo::Type pType,
                                ResolveInfo::Desc pDesc,
                                ResolveInfo::Binding pBind,
@@ -404,7 +404,7 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
                                LDSection* pSection,
                                ResolveInfo::Visibility pVis) {
   // rename symbols
-  std::string name = pName;
+  llvm::StringRef name = pName;
   if (!m_Module.getScript().renameMap().empty() &&
       ResolveInfo::Undefined == pDesc) {
     // If the renameMap is not empty, some symbols should be renamed.
@@ -416,6 +416,13 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
       name = renameSym.getEntry()->value();
   }
 
+  // the names in the mapped string tables of the input live as long as the
+  // link, so the symbols refer to them rather than keep a copy
+  bool refer_name = pInput.hasMemArea() &&
+                    pInput.memArea()->contains(
+                        llvm::StringRef(name.data(), name.size() + 1)) &&
+                    name.data()[name.size()] == '\0';
+
   // Fix up the visibility if object has no export set.
   if (pInput.noExport() && (pDesc != ResolveInfo::Undefined)) {
     if ((pVis == ResolveInfo::Default) || (pVis == ResolveInfo::Protected)) {
@@ -435,13 +442,13 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
         frag = FragmentRef::Create(*pSection, pValue);
 
       LDSymbol* input_sym = addSymbolFromObject(
-          name, pType, pDesc, pBind, pSize, pValue, frag, pVis);
+          name, pType, pDesc, pBind, pSize, pValue, frag, pVis, refer_name);
       pInput.context()->addSymbol(input_sym);
       return input_sym;
     }
     case Input::DynObj: {
       return addSymbolFromDynObj(
-          pInput, name, pType, pDesc, pBind, pSize, pValue, pVis);
+          pInput, name, pType, pDesc, pBind, pSize, pValue, pVis, refer_name);
     }
     default: {
       return NULL;
@@ -451,14 +458,15 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
   return NULL;
 }
 
-LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
+LDSymbol* IRBuilder::addSymbolFromObject(const llvm::StringRef& pName,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
                                          ResolveInfo::SizeType pSize,
                                          LDSymbol::ValueType pValue,
                                          FragmentRef* pFragmentRef,
-                                         ResolveInfo::Visibility pVisibility) {
+                                         ResolveInfo::Visibility pVisibility,
+                                         bool pReferName) {
   // Step 1. calculate a Resolver::Result
   // resolved_result is a triple <resolved_info, existent, override>
   Resolver::Result resolved_result;
@@ -468,7 +476,7 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
     // if the symbol is a local symbol, create a LDSymbol for input, but do not
     // resolve them.
     resolved_result.info = m_Module.getNamePool().createSymbol(
-        pName, false, pType, pDesc, pBinding, pSize, pVisibility);
+        pName, false, pType, pDesc, pBinding, pSize, pVisibility, pReferName);
 
     // No matter if there is a symbol with the same name, insert the symbol
     // into output symbol table. So, we let the existent false.
@@ -485,7 +493,8 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
                                         pValue,
                                         pVisibility,
                                         &old_info,
-                                        resolved_result);
+                                        resolved_result,
+                                        pReferName);
   }
 
   // the return ResolveInfo should not NULL
@@ -526,13 +535,14 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
 }
 
 LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
-                                         const std::string& pName,
+                                         const llvm::StringRef& pName,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
                                          ResolveInfo::SizeType pSize,
                                          LDSymbol::ValueType pValue,
-                                         ResolveInfo::Visibility pVisibility) {
+                                         ResolveInfo::Visibility pVisibility,
+                                         bool pReferName) {
   // We don't need sections of dynamic objects. So we ignore section symbols.
   if (pType == ResolveInfo::Section)
     return NULL;
@@ -560,7 +570,8 @@ LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
                                       pValue,
                                       pVisibility,
                                       NULL,
-                                      resolved_result);
+                                      resolved_result,
+                                      pReferName);
 
   // the return ResolveInfo should not NULL
   assert(resolved_result.info != NULL);
@@ -642,6 +653,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::Force, IRBuilder::Unresolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  m_Module.getNamePool().import(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
   LDSymbol* output_sym = NULL;
   if (info == NULL) {
@@ -712,6 +724,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::AsReferred, IRBuilder::Unresolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  m_Module.getNamePool().import(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
 
   if (info == NULL || !(info->isUndef() || info->isDyn())) {
@@ -809,6 +822,7 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::AsReferred, IRBuilder::Resolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  m_Module.getNamePool().import(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
 
   if (info == NULL || !(info->isUndef() || info->isDyn())) {
@@ -0,0 +1,78 @@
+//===- LinkContext.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LinkContext.h"
+
+#include <llvm/Support/ManagedStatic.h>
+
+#include <atomic>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// static variables
+//===----------------------------------------------------------------------===//
+static llvm::ManagedStatic<LinkContext> g_DefaultContext;
+
+static LLVM_THREAD_LOCAL LinkContext* g_pCurrentContext = NULL;
+
+//===----------------------------------------------------------------------===//
+// LinkContext
+//===----------------------------------------------------------------------===//
+LinkContext::LinkContext() {
+}
+
+LinkContext::~LinkContext() {
+  release();
+}
+
+LinkContext& LinkContext::current() {
+  if (g_pCurrentContext != NULL)
+    return *g_pCurrentContext;
+  return *g_DefaultContext;
+}
+
+LinkContext* LinkContext::activate(LinkContext* pContext) {
+  LinkContext* previous = g_pCurrentContext;
+  g_pCurrentContext = pContext;
+  return previous;
+}
+
+void LinkContext::release() {
+  // Destroying an object may still reach other objects of this context, so
+  // each slot is emptied before its object is destroyed.
+  while (!m_Order.empty()) {
+    unsigned int id = m_Order.back();
+    m_Order.pop_back();
+    Slot victim = m_Slots[id];
+    m_Slots[id].object = NULL;
+    victim.destroy(victim.object);
+  }
+}
+
+unsigned int LinkContext::nextID() {
+  static std::atomic<unsigned int> counter(0);
+  return counter++;
+}
+
+LinkContext::Slot& LinkContext::slot(unsigned int pID) {
+  if (pID >= m_Slots.size()) {
+    Slot empty = { NULL, NULL };
+    m_Slots.resize(pID + 1, empty);
+  }
+  return m_Slots[pID];
+}
+
+void LinkContext::create(unsigned int pID, void* pObject, DestroyFn pDestroy) {
+  Slot& s = slot(pID);
+  s.object = pObject;
+  s.destroy = pDestroy;
+  m_Order.push_back(pID);
+}
+
+}  // namespace mcld
@@ -9,12 +9,9 @@
 #include "mcld/Linker.h"
 
 #include "mcld/IRBuilder.h"
+#include "mcld/LinkContext.h"
 #include "mcld/LinkerConfig.h"
 #include "mcld/Module.h"
-#include "mcld/Fragment/FragmentRef.h"
-#include "mcld/Fragment/Relocation.h"
-#include "mcld/LD/LDSection.h"
-#include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/ObjectWriter.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
@@ -24,6 +21,7 @@
 #include "mcld/Support/FileOutputBuffer.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/TargetRegistry.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Support/raw_ostream.h"
 #include "mcld/Target/TargetLDBackend.h"
 
@@ -36,16 +34,22 @@ Linker::Linker()
       m_pIRBuilder(NULL),
       m_pTarget(NULL),
       m_pBackend(NULL),
-      m_pObjLinker(NULL) {
+      m_pObjLinker(NULL),
+      m_pContext(new LinkContext()) {
 }
 
 Linker::~Linker() {
   reset();
+  delete m_pContext;
 }
 
 /// emulate - To set up target-dependent options and default linker script.
 /// Follow GNU ld quirks.
 bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig) {
+  LinkContext::Scope scope(*m_pContext);
+  if (pConfig.options().timeTrace())
+    TimeTrace::current().enable();
+  TimeTrace::Scope trace("Linker::emulate");
   m_pConfig = &pConfig;
 
   if (!initTarget())
@@ -64,6 +68,7 @@ bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig) {
 }
 
 bool Linker::link(Module& pModule, IRBuilder& pBuilder) {
+  LinkContext::Scope scope(*m_pContext);
   if (!normalize(pModule, pBuilder))
     return false;
 
@@ -75,6 +80,8 @@ bool Linker::link(Module& pModule, IRBuilder& pBuilder) {
 
 /// normalize - to convert the command line language to the input tree.
 bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
+  LinkContext::Scope scope(*m_pContext);
+  TimeTrace::Scope trace("Linker::normalize");
   assert(m_pConfig != NULL);
 
   m_pIRBuilder = &pBuilder;
@@ -163,6 +170,8 @@ bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
 }
 
 bool Linker::resolve(Module& pModule) {
+  LinkContext::Scope scope(*m_pContext);
+  TimeTrace::Scope trace("Linker::resolve");
   assert(m_pConfig != NULL);
   assert(m_pObjLinker != NULL);
 
@@ -200,6 +209,8 @@ bool Linker::resolve(Module& pModule) {
 }
 
 bool Linker::layout() {
+  LinkContext::Scope scope(*m_pContext);
+  TimeTrace::Scope trace("Linker::layout");
   assert(m_pConfig != NULL && m_pObjLinker != NULL);
 
   // 10. - add standard symbols, target-dependent symbols and script symbols
@@ -240,11 +251,19 @@ bool Linker::layout() {
 }
 
 bool Linker::emit(FileOutputBuffer& pOutput) {
-  // 15. - write out output
-  m_pObjLinker->emitOutput(pOutput);
+  LinkContext::Scope scope(*m_pContext);
+  {
+    TimeTrace::Scope trace("Linker::emit");
 
-  // 16. - post processing
-  m_pObjLinker->postProcessing(pOutput);
+    // 15. - write out output
+    m_pObjLinker->emitOutput(pOutput);
+
+    // 16. - post processing
+    m_pObjLinker->postProcessing(pOutput);
+  }
+
+  // 17. - report the cost of each phase
+  printTimeTrace();
 
   if (!Diagnose())
     return false;
@@ -253,6 +272,7 @@ bool Linker::emit(FileOutputBuffer& pOutput) {
 }
 
 bool Linker::emit(const Module& pModule, const std::string& pPath) {
+  LinkContext::Scope scope(*m_pContext);
   FileHandle file;
   FileHandle::OpenMode open_mode(
       FileHandle::ReadWrite | FileHandle::Truncate | FileHandle::Create);
@@ -287,6 +307,7 @@ bool Linker::emit(const Module& pModule, const std::string& pPath) {
 }
 
 bool Linker::emit(const Module& pModule, int pFileDescriptor) {
+  LinkContext::Scope scope(*m_pContext);
   FileHandle file;
   file.delegate(pFileDescriptor);
 
@@ -298,6 +319,7 @@ bool Linker::emit(const Module& pModule, int pFileDescriptor) {
 }
 
 bool Linker::reset() {
+  LinkContext::Scope scope(*m_pContext);
   m_pConfig = NULL;
   m_pIRBuilder = NULL;
   m_pTarget = NULL;
@@ -314,13 +336,33 @@ bool Linker::reset() {
   delete m_pObjLinker;
   m_pObjLinker = NULL;
 
-  LDSection::Clear();
-  LDSymbol::Clear();
-  FragmentRef::Clear();
-  Relocation::Clear();
+  // release the sections, symbols, fragment references, relocations and
+  // script objects of this link at once
+  m_pContext->release();
   return true;
 }
 
+void Linker::printTimeTrace() const {
+  const TimeTrace& trace = TimeTrace::current();
+  if (!trace.isEnabled())
+    return;
+
+  trace.printSummary(mcld::errs());
+
+  const std::string& path = m_pConfig->options().timeTraceFile();
+  if (path.empty())
+    return;
+
+  std::error_code error_code;
+  mcld::raw_fd_ostream os(path.c_str(), error_code, llvm::sys::fs::F_Text);
+  if (error_code) {
+    warning(diag::warn_cannot_open_time_trace) << path
+                                               << error_code.message();
+    return;
+  }
+  trace.printJSON(os);
+}
+
 bool Linker::initTarget() {
   assert(m_pConfig != NULL);
 
@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "mcld/Module.h"
+#include "mcld/LinkContext.h"
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDSection.h"
@@ -18,17 +19,21 @@
 
 namespace mcld {
 
-static GCFactory<Module::AliasList, MCLD_SECTIONS_PER_INPUT>
-    gc_aliaslist_factory;
+typedef GCFactory<Module::AliasList, MCLD_SECTIONS_PER_INPUT> AliasListFactory;
+static LinkStatic<AliasListFactory> g_AliasListFactory;
 
 //===----------------------------------------------------------------------===//
 // Module
 //===----------------------------------------------------------------------===//
-Module::Module(LinkerScript& pScript) : m_Script(pScript), m_NamePool(1024) {
+Module::Module(LinkerScript& pScript)
+    : m_Script(pScript), m_bSectionIndexValid(true), m_NamePool(1024) {
 }
 
 Module::Module(const std::string& pName, LinkerScript& pScript)
-    : m_Name(pName), m_Script(pScript), m_NamePool(1024) {
+    : m_Name(pName),
+      m_Script(pScript),
+      m_bSectionIndexValid(true),
+      m_NamePool(1024) {
 }
 
 Module::~Module() {
@@ -36,15 +41,26 @@ Module::~Module() {
 
 // Following two functions will be obsolette when we have new section merger.
 LDSection* Module::getSection(const std::string& pName) {
-  iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  if (!m_bSectionIndexValid)
+    buildSectionIndex();
+
+  llvm::StringMap<LDSection*>::iterator entry = m_SectionIndex.find(pName);
+  if (entry == m_SectionIndex.end())
+    return NULL;
+  return entry->getValue();
 }
 
 const LDSection* Module::getSection(const std::string& pName) const {
+  // the const one does not rebuild the index, so that it can be called
+  // concurrently
+  if (m_bSectionIndexValid) {
+    llvm::StringMap<LDSection*>::const_iterator entry =
+        m_SectionIndex.find(pName);
+    if (entry == m_SectionIndex.end())
+      return NULL;
+    return entry->getValue();
+  }
+
   const_iterator sect, sectEnd = end();
   for (sect = begin(); sect != sectEnd; ++sect) {
     if ((*sect)->name() == pName)
@@ -53,8 +69,28 @@ const LDSection* Module::getSection(const std::string& pName) const {
   return NULL;
 }
 
+void Module::addSection(LDSection& pSection) {
+  m_SectionTable.push_back(&pSection);
+  if (m_bSectionIndexValid)
+    m_SectionIndex.insert(std::make_pair(pSection.name(), &pSection));
+}
+
+void Module::clearSections() {
+  m_SectionTable.clear();
+  m_SectionIndex.clear();
+  m_bSectionIndexValid = true;
+}
+
+void Module::buildSectionIndex() {
+  m_SectionIndex.clear();
+  iterator sect, sectEnd = m_SectionTable.end();
+  for (sect = m_SectionTable.begin(); sect != sectEnd; ++sect)
+    m_SectionIndex.insert(std::make_pair((*sect)->name(), *sect));
+  m_bSectionIndexValid = true;
+}
+
 void Module::CreateAliasList(const ResolveInfo& pSym) {
-  AliasList* result = gc_aliaslist_factory.allocate();
+  AliasList* result = g_AliasListFactory->allocate();
   new (result) AliasList();
   m_AliasLists.push_back(result);
   result->push_back(&pSym);
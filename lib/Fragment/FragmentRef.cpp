@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Fragment/FragmentRef.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Fragment/Fragment.h"
 #include "mcld/Fragment/RegionFragment.h"
 #include "mcld/Fragment/Stub.h"
@@ -18,7 +19,6 @@
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
 
 #include <cassert>
 
@@ -26,10 +26,14 @@ namespace mcld {
 
 typedef GCFactory<FragmentRef, MCLD_SECTIONS_PER_INPUT> FragRefFactory;
 
-static llvm::ManagedStatic<FragRefFactory> g_FragRefFactory;
+static LinkStatic<FragRefFactory> g_FragRefFactory;
 
 FragmentRef FragmentRef::g_NullFragmentRef;
 
+/// the number of fragments Create() walks before it searches the offset index
+/// of SectionData
+static const unsigned int MaxLinearSteps = 8;
+
 //===----------------------------------------------------------------------===//
 // FragmentRef
 //===----------------------------------------------------------------------===//
@@ -51,11 +55,25 @@ FragmentRef* FragmentRef::Create(Fragment& pFrag, uint64_t pOffset) {
   int64_t offset = pOffset;
   Fragment* frag = &pFrag;
 
+  // walk a few fragments, and search the offset index of the section if the
+  // offset is further away
+  unsigned int steps = 0;
   while (frag != NULL) {
     offset -= frag->size();
     if (offset <= 0)
       break;
     frag = frag->getNextNode();
+    if (++steps == MaxLinearSteps && frag != NULL &&
+        pFrag.getParent() != NULL) {
+      uint64_t frag_offset = 0;
+      frag = pFrag.getParent()->findFragment(pFrag, pOffset, frag_offset);
+      if (frag == NULL)
+        return Null();
+
+      FragmentRef* result = g_FragRefFactory->allocate();
+      new (result) FragmentRef(*frag, frag_offset);
+      return result;
+    }
   }
   if ((frag != NULL) && (frag->size() != 0)) {
     if (offset == 0)
@@ -8,19 +8,17 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Fragment/Relocation.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocationFactory.h"
 #include "mcld/LD/Relocator.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
-#include "mcld/Support/MsgHandling.h"
-
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-static llvm::ManagedStatic<RelocationFactory> g_RelocationFactory;
+static LinkStatic<RelocationFactory> g_RelocationFactory;
 
 //===----------------------------------------------------------------------===//
 // Relocation Factory Methods
@@ -94,33 +92,7 @@ Relocation::Address Relocation::symValue() const {
 }
 
 void Relocation::apply(Relocator& pRelocator) {
-  Relocator::Result result = pRelocator.applyRelocation(*this);
-
-  switch (result) {
-    case Relocator::OK: {
-      // do nothing
-      return;
-    }
-    case Relocator::Overflow: {
-      error(diag::result_overflow) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::BadReloc: {
-      error(diag::result_badreloc) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::Unsupported: {
-      fatal(diag::unsupported_relocation) << type()
-                                          << "mclinker@googlegroups.com";
-      return;
-    }
-    case Relocator::Unknown: {
-      fatal(diag::unknown_relocation) << type() << symInfo()->name();
-      return;
-    }
-  }  // end of switch
+  pRelocator.issueResult(*this, pRelocator.applyRelocation(*this));
 }
 
 void Relocation::setType(Type pType) {
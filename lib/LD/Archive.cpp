@@ -25,6 +25,7 @@ const char Archive::IRIX6_SYMTAB_NAME[] = "/SYM64/         ";
 const char Archive::STRTAB_NAME[] = "//              ";
 const char Archive::PAD[] = "\n";
 const char Archive::MEMBER_MAGIC[] = "`\n";
+const size_t Archive::NoSymbol;
 
 Archive::Archive(Input& pInputFile, InputBuilder& pBuilder)
     : m_ArchiveFile(pInputFile),
@@ -91,6 +92,14 @@ bool Archive::hasObjectMember(uint32_t pFileOffset) const {
   return (m_ObjectMemberMap.find(pFileOffset) != m_ObjectMemberMap.end());
 }
 
+/// getObjectMember - get the included object file
+Input* Archive::getObjectMember(uint32_t pFileOffset) {
+  ObjectMemberMapType::iterator it = m_ObjectMemberMap.find(pFileOffset);
+  if (it == m_ObjectMemberMap.end())
+    return NULL;
+  return *(it.getEntry()->value());
+}
+
 /// getArchiveMemberMap - get the map that contains the included archive files
 Archive::ArchiveMemberMapType& Archive::getArchiveMemberMap() {
   return m_ArchiveMemberMap;
@@ -172,14 +181,38 @@ void Archive::addSymbol(const char* pName,
   Symbol* entry = m_SymbolFactory.allocate();
   new (entry) Symbol(pName, pFileOffset, pStatus);
   m_SymTab.push_back(entry);
+
+  // chain the entries of the same name in the order of the symtab
+  bool exist = false;
+  SymbolIndexEntryType* chain = m_SymbolIndex.insert(entry->name, exist);
+  size_t idx = m_SymTab.size() - 1;
+  if (exist)
+    m_SymTab[chain->value().last]->next = idx;
+  else
+    chain->value().first = idx;
+  chain->value().last = idx;
 }
 
 /// getSymbolName - get the symbol name with the given index
-const std::string& Archive::getSymbolName(size_t pSymIdx) const {
+llvm::StringRef Archive::getSymbolName(size_t pSymIdx) const {
   assert(pSymIdx < numOfSymbols());
   return m_SymTab[pSymIdx]->name;
 }
 
+/// findSymbol - get the index of the first symtab entry named pName
+size_t Archive::findSymbol(const llvm::StringRef& pName) const {
+  SymbolIndexType::const_iterator chain = m_SymbolIndex.find(pName);
+  if (chain == m_SymbolIndex.end())
+    return NoSymbol;
+  return chain.getEntry()->value().first;
+}
+
+/// getNextSymbol - get the index of the next symtab entry of the same name
+size_t Archive::getNextSymbol(size_t pSymIdx) const {
+  assert(pSymIdx < numOfSymbols());
+  return m_SymTab[pSymIdx]->next;
+}
+
 /// getObjFileOffset - get the file offset that represent a object file
 uint32_t Archive::getObjFileOffset(size_t pSymIdx) const {
   assert(pSymIdx < numOfSymbols());
@@ -8,14 +8,37 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/ArchiveReader.h"
 
+#include "mcld/LD/Archive.h"
+#include "mcld/MC/Attribute.h"
+#include "mcld/MC/Input.h"
+
 namespace mcld {
 
 //==========================
 // MCELFArchiveReader
-ArchiveReader::ArchiveReader() {
+ArchiveReader::ArchiveReader() : m_pThreadPool(NULL) {
 }
 
 ArchiveReader::~ArchiveReader() {
 }
 
+bool ArchiveReader::readArchives(const LinkerConfig& pConfig,
+                                 const std::vector<Archive*>& pArchives) {
+  bool included = true;
+  while (included) {
+    included = false;
+    std::vector<Archive*>::const_iterator ar, arEnd = pArchives.end();
+    for (ar = pArchives.begin(); ar != arEnd; ++ar) {
+      // if --whole-archive is given to this archive, no need to read it again
+      if ((*ar)->getARFile().attribute()->isWholeArchive())
+        continue;
+      size_t num_of_members = (*ar)->numOfObjectMember();
+      readArchive(pConfig, **ar);
+      if ((*ar)->numOfObjectMember() != num_of_members)
+        included = true;
+    }
+  }
+  return true;
+}
+
 }  // namespace mcld
@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/DebugString.h"
+#include "mcld/LinkContext.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocData.h"
@@ -19,21 +20,14 @@
 #include "mcld/LD/Relocator.h"
 
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
+
+#include <cassert>
 
 namespace mcld {
 
 // DebugString represents the output .debug_str section, which is at most on
 // in each linking
-static llvm::ManagedStatic<DebugString> g_DebugString;
-
-static inline size_t string_length(const char* pStr) {
-  const char* p = pStr;
-  size_t len = 0;
-  for (; *p != 0; ++p)
-    ++len;
-  return len;
-}
+static LinkStatic<DebugString> g_DebugString;
 
 //==========================
 // DebugString
@@ -44,47 +38,43 @@ void DebugString::merge(LDSection& pSection) {
   for (it = pSection.getSectionData()->begin(); it != end; ++it) {
     if ((*it).getKind() == Fragment::Region) {
       RegionFragment* frag = llvm::cast<RegionFragment>(&(*it));
-      strings = frag->getRegion().data();
+      strings = frag->getRegion();
     }
   }
 
-  // get the debug strings and add them into merged string table
-  const char* str = strings.data();
-  const char* str_end = str + pSection.size();
-  while (str < str_end) {
-    size_t len = string_length(str);
-    m_StringTable.insertString(llvm::StringRef(str, len));
-    str = str + len + 1;
-  }
+  // the strings are split when the offsets are computed. The bytes after the
+  // last terminator are not a string.
+  strings = strings.substr(0, pSection.size());
+  strings = strings.substr(0, strings.rfind('\0') + 1);
+  m_InputSections[&pSection] = m_Strings.addSection(strings);
 }
 
-size_t DebugString::computeOffsetSize() {
-  size_t size = m_StringTable.finalizeOffset();
+size_t DebugString::computeOffsetSize(ThreadPool* pThreadPool,
+                                      bool pTailMerge) {
+  m_Strings.finalize(pThreadPool, pTailMerge);
+  size_t size = m_Strings.size();
   m_pSection->setSize(size);
   return size;
 }
 
 void DebugString::applyOffset(Relocation& pReloc, TargetLDBackend& pBackend) {
-  // get the refered string
+  // the symbol should point to the first region fragment in the input debug
+  // string section
   ResolveInfo* info = pReloc.symInfo();
-  // the symbol should point to the first region fragment in the debug
-  // string section, get the input .debut_str region
-  llvm::StringRef d_str;
-  if (info->outSymbol()->fragRef()->frag()->getKind() == Fragment::Region) {
-    RegionFragment* frag =
-        llvm::cast<RegionFragment>(info->outSymbol()->fragRef()->frag());
-    d_str = frag->getRegion();
-  }
+  const LDSection& input =
+      info->outSymbol()->fragRef()->frag()->getParent()->getSection();
   uint32_t offset = pBackend.getRelocator()->getDebugStringOffset(pReloc);
-  const char* str = d_str.data() + offset;
 
   // apply the relocation
-  pBackend.getRelocator()->applyDebugStringOffset(pReloc,
-      m_StringTable.getOutputOffset(llvm::StringRef(str, string_length(str))));
+  llvm::DenseMap<const LDSection*, unsigned int>::const_iterator entry =
+      m_InputSections.find(&input);
+  assert(entry != m_InputSections.end() && "the .debug_str is not merged");
+  pBackend.getRelocator()->applyDebugStringOffset(
+      pReloc, m_Strings.getOutputOffset(entry->second, offset));
 }
 
 void DebugString::emit(MemoryRegion& pRegion) {
-  return m_StringTable.emit(pRegion);
+  m_Strings.emit(reinterpret_cast<char*>(pRegion.begin()));
 }
 
 DebugString* DebugString::Create(LDSection& pSection) {
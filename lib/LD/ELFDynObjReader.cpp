@@ -10,34 +10,205 @@
 
 #include "mcld/IRBuilder.h"
 #include "mcld/LinkerConfig.h"
+#include "mcld/Module.h"
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/ADT/StringHash.h"
 #include "mcld/LD/ELFReader.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/ShlibSymbolCache.h"
+#include "mcld/LD/SymbolBuffer.h"
 #include "mcld/MC/Input.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/Twine.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/Host.h>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <utility>
 
 namespace mcld {
 
+static uint32_t readWord(const uint32_t* pWord) {
+  if (llvm::sys::IsLittleEndianHost)
+    return *pWord;
+  return mcld::bswap32(*pWord);
+}
+
+//===----------------------------------------------------------------------===//
+// ELFDynObjReader::LazyDynObj
+//===----------------------------------------------------------------------===//
+/// LazyDynObj - a shared object whose defined entries of .dynsym are read on
+/// demand, and its hash section.
+struct ELFDynObjReader::LazyDynObj {
+  /// Entry - the fields of a .dynsym entry needed to index it
+  struct Entry {
+    uint32_t name;
+    uint64_t value;
+    uint8_t info;
+    uint16_t shndx;
+  };
+
+  /// Object - the value and the index of a defined data object, which may
+  /// have weak aliases
+  typedef std::pair<uint64_t, uint32_t> Object;
+
+  Input* input;
+  llvm::StringRef symtab;
+  llvm::StringRef strtab;
+  bool is64Bits;
+  size_t numOfEntries;
+
+  // the hash section. .gnu.hash has the bloom filter and symoffset, .hash
+  // has neither.
+  bool isGNUHash;
+  uint32_t numOfBuckets;
+  uint32_t symOffset;
+  uint32_t bloomSize;
+  uint32_t bloomShift;
+  const char* bloom;
+  const uint32_t* buckets;
+  const uint32_t* chains;
+  uint32_t numOfChains;
+
+  std::vector<bool> read;         // the entries which have been read
+  std::vector<Object> objects;    // the defined data objects by value
+  std::vector<uint32_t> batch;    // the entries to be read next
+
+  static bool lessValue(const Object& pX, const Object& pY) {
+    return pX.first < pY.first;
+  }
+
+  Entry entry(uint32_t pIdx) const {
+    Entry result;
+    if (is64Bits) {
+      const llvm::ELF::Elf64_Sym& sym =
+          reinterpret_cast<const llvm::ELF::Elf64_Sym*>(symtab.begin())[pIdx];
+      result.info = sym.st_info;
+      if (llvm::sys::IsLittleEndianHost) {
+        result.name = sym.st_name;
+        result.value = sym.st_value;
+        result.shndx = sym.st_shndx;
+      } else {
+        result.name = mcld::bswap32(sym.st_name);
+        result.value = mcld::bswap64(sym.st_value);
+        result.shndx = mcld::bswap16(sym.st_shndx);
+      }
+    } else {
+      const llvm::ELF::Elf32_Sym& sym =
+          reinterpret_cast<const llvm::ELF::Elf32_Sym*>(symtab.begin())[pIdx];
+      result.info = sym.st_info;
+      if (llvm::sys::IsLittleEndianHost) {
+        result.name = sym.st_name;
+        result.value = sym.st_value;
+        result.shndx = sym.st_shndx;
+      } else {
+        result.name = mcld::bswap32(sym.st_name);
+        result.value = mcld::bswap32(sym.st_value);
+        result.shndx = mcld::bswap16(sym.st_shndx);
+      }
+    }
+    return result;
+  }
+
+  llvm::StringRef name(const Entry& pEntry) const {
+    if (pEntry.name >= strtab.size())
+      return llvm::StringRef();
+    const char* name = strtab.begin() + pEntry.name;
+    return llvm::StringRef(name, strnlen(name, strtab.size() - pEntry.name));
+  }
+
+  /// mayMatch - the bloom filter of .gnu.hash
+  bool mayMatch(uint32_t pHash) const {
+    unsigned int bits = is64Bits ? 64 : 32;
+    uint32_t word_idx = (pHash / bits) % bloomSize;
+    uint64_t word = 0x0;
+    if (is64Bits) {
+      word = reinterpret_cast<const uint64_t*>(bloom)[word_idx];
+      if (!llvm::sys::IsLittleEndianHost)
+        word = mcld::bswap64(word);
+    } else {
+      word = readWord(reinterpret_cast<const uint32_t*>(bloom) + word_idx);
+    }
+    uint64_t mask = (uint64_t(1) << (pHash % bits)) |
+                    (uint64_t(1) << ((pHash >> bloomShift) % bits));
+    return ((word & mask) == mask);
+  }
+
+  /// candidates - the entries whose hash values may be pName's
+  void candidates(const llvm::StringRef& pName,
+                  std::vector<uint32_t>& pResult) const {
+    if (numOfBuckets == 0)
+      return;
+
+    if (isGNUHash) {
+      uint32_t hash = hash::StringHash<hash::DJB>()(pName);
+      if (!mayMatch(hash))
+        return;
+      uint32_t idx = readWord(buckets + (hash % numOfBuckets));
+      if (idx < symOffset)
+        return;
+      // a chain ends with an odd word. The hash values are compared without
+      // the lowest bit.
+      for (; idx < numOfEntries && (idx - symOffset) < numOfChains; ++idx) {
+        uint32_t chain = readWord(chains + (idx - symOffset));
+        if ((chain | 0x1) == (hash | 0x1))
+          pResult.push_back(idx);
+        if ((chain & 0x1) != 0x0)
+          break;
+      }
+      return;
+    }
+
+    // the chains of .hash may be corrupted, so that they are walked at most
+    // numOfChains steps
+    uint32_t hash = hash::StringHash<hash::ELF>()(pName);
+    uint32_t idx = readWord(buckets + (hash % numOfBuckets));
+    for (uint32_t step = 0; idx != 0 && idx < numOfChains && step < numOfChains;
+         ++step) {
+      pResult.push_back(idx);
+      idx = readWord(chains + idx);
+    }
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // ELFDynObjReader
 //===----------------------------------------------------------------------===//
 ELFDynObjReader::ELFDynObjReader(GNULDBackend& pBackend,
                                  IRBuilder& pBuilder,
                                  const LinkerConfig& pConfig)
-    : DynObjReader(), m_pELFReader(0), m_Builder(pBuilder) {
+    : DynObjReader(),
+      m_pELFReader(0),
+      m_Builder(pBuilder),
+      m_Config(pConfig),
+      m_pSymbolCache(NULL),
+      m_bImporting(false) {
   if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian())
     m_pELFReader = new ELFReader<32, true>(pBackend);
   else if (pConfig.targets().is64Bits() && pConfig.targets().isLittleEndian())
     m_pELFReader = new ELFReader<64, true>(pBackend);
+
+  if (!pConfig.options().shlibSymbolCache().empty()) {
+    m_pSymbolCache =
+        new ShlibSymbolCache(pConfig.options().shlibSymbolCache(),
+                             pConfig.targets().triple().str());
+  }
 }
 
 ELFDynObjReader::~ELFDynObjReader() {
+  if (!m_LazyDynObjs.empty())
+    m_Builder.getModule().getNamePool().setImporter(NULL);
+  LazyDynObjList::iterator dynobj, dynEnd = m_LazyDynObjs.end();
+  for (dynobj = m_LazyDynObjs.begin(); dynobj != dynEnd; ++dynobj)
+    delete *dynobj;
+  delete m_pSymbolCache;
   delete m_pELFReader;
 }
 
@@ -112,10 +283,258 @@ bool ELFDynObjReader::readSymbols(Input& pInput) {
 
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
-  const char* strtab = strtab_region.begin();
-  bool result =
-      m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
-  return result;
+
+  if (m_Config.options().lazyShlibSymbols()) {
+    LazyDynObj* dynobj =
+        createLazyDynObj(pInput, symtab_region, strtab_region);
+    if (dynobj != NULL) {
+      if (m_LazyDynObjs.empty())
+        m_Builder.getModule().getNamePool().setImporter(this);
+      m_LazyDynObjs.push_back(dynobj);
+      return readLazySymbols(*dynobj);
+    }
+  }
+
+  // decode .dynsym and find its weak aliases, unless the cache has them. The
+  // members of archives are not cached.
+  SymbolBuffer buffer;
+  bool cacheable = (m_pSymbolCache != NULL && pInput.fileOffset() == 0);
+  if (!cacheable || !m_pSymbolCache->load(pInput, strtab_region, buffer)) {
+    size_t hdr_size = m_pELFReader->getELFHeaderSize();
+    llvm::StringRef region =
+        pInput.memArea()->request(pInput.fileOffset(), hdr_size);
+    if (!m_pELFReader->decodeSymbols(
+            pInput, region.begin(), llvm::ELF::SHT_DYNSYM, buffer)) {
+      fatal(diag::fatal_cannot_read_strtab) << pInput.name() << pInput.path()
+                                            << ".dynsym";
+      return false;
+    }
+    m_pELFReader->findAliases(pInput, buffer);
+
+    // a cache which can not be written only costs the next link the decoding
+    if (cacheable)
+      m_pSymbolCache->store(pInput, strtab_region, buffer);
+  }
+  return m_pELFReader->resolveSymbols(pInput, m_Builder, buffer);
+}
+
+/// countSymbols
+size_t ELFDynObjReader::countSymbols(Input& pInput) const {
+  size_t hdr_size = m_pELFReader->getELFHeaderSize();
+  if (!pInput.hasMemArea() ||
+      pInput.memArea()->size() < pInput.fileOffset() + hdr_size)
+    return 0;
+
+  llvm::StringRef region =
+      pInput.memArea()->request(pInput.fileOffset(), hdr_size);
+  return m_pELFReader->countSymbols(
+      pInput, region.begin(), llvm::ELF::SHT_DYNSYM);
+}
+
+/// import - the entries named pName are read from all the shared objects,
+/// along with the names of their weak aliases
+void ELFDynObjReader::import(const llvm::StringRef& pName) {
+  // the symbols read here come back through NamePool::insertSymbol()
+  if (m_bImporting)
+    return;
+
+  NameList names(1, pName);
+  importNames(names, 0);
+}
+
+ELFDynObjReader::LazyDynObj* ELFDynObjReader::createLazyDynObj(
+    Input& pInput,
+    llvm::StringRef pSymTab,
+    llvm::StringRef pStrTab) const {
+  bool is64Bits = m_Config.targets().is64Bits();
+  size_t entsize = is64Bits ? sizeof(llvm::ELF::Elf64_Sym)
+                            : sizeof(llvm::ELF::Elf32_Sym);
+  size_t num_of_entries = pSymTab.size() / entsize;
+
+  // prefer .gnu.hash, whose bloom filter rejects most of the names at once
+  LDSection* hash_shdr = pInput.context()->getSection(".gnu.hash");
+  bool is_gnu_hash = (hash_shdr != NULL);
+  if (hash_shdr == NULL)
+    hash_shdr = pInput.context()->getSection(".hash");
+  if (hash_shdr == NULL || num_of_entries == 0)
+    return NULL;
+
+  llvm::StringRef hash_region = pInput.memArea()->request(
+      pInput.fileOffset() + hash_shdr->offset(), hash_shdr->size());
+  const uint32_t* words =
+      reinterpret_cast<const uint32_t*>(hash_region.begin());
+  size_t num_of_words = hash_region.size() / sizeof(uint32_t);
+
+  LazyDynObj* dynobj = new LazyDynObj();
+  dynobj->input = &pInput;
+  dynobj->symtab = pSymTab;
+  dynobj->strtab = pStrTab;
+  dynobj->is64Bits = is64Bits;
+  dynobj->numOfEntries = num_of_entries;
+  dynobj->isGNUHash = is_gnu_hash;
+  dynobj->symOffset = 0;
+  dynobj->bloomSize = 0;
+  dynobj->bloomShift = 0;
+  dynobj->bloom = NULL;
+
+  bool valid = false;
+  if (is_gnu_hash && num_of_words >= 4) {
+    // nbuckets, symoffset, bloom_size, bloom_shift, bloom, buckets, chains
+    dynobj->numOfBuckets = readWord(words);
+    dynobj->symOffset = readWord(words + 1);
+    dynobj->bloomSize = readWord(words + 2);
+    dynobj->bloomShift = readWord(words + 3);
+    size_t bloom_words = dynobj->bloomSize * (is64Bits ? 2 : 1);
+    size_t head = 4 + bloom_words + dynobj->numOfBuckets;
+    if (dynobj->bloomSize != 0 && head <= num_of_words) {
+      dynobj->bloom = reinterpret_cast<const char*>(words + 4);
+      dynobj->buckets = words + 4 + bloom_words;
+      dynobj->chains = words + head;
+      dynobj->numOfChains = num_of_words - head;
+      valid = true;
+    }
+  } else if (!is_gnu_hash && num_of_words >= 2) {
+    // nbucket, nchain, buckets, chains
+    dynobj->numOfBuckets = readWord(words);
+    dynobj->numOfChains = readWord(words + 1);
+    if (2 + dynobj->numOfBuckets + dynobj->numOfChains <= num_of_words) {
+      dynobj->buckets = words + 2;
+      dynobj->chains = words + 2 + dynobj->numOfBuckets;
+      valid = true;
+    }
+  }
+
+  if (!valid) {
+    delete dynobj;
+    return NULL;
+  }
+
+  dynobj->read.resize(num_of_entries, false);
+  dynobj->read[0] = true;
+  return dynobj;
+}
+
+bool ELFDynObjReader::readLazySymbols(LazyDynObj& pDynObj) {
+  Input& input = *pDynObj.input;
+
+  // skip the first NULL symbol
+  input.context()->addSymbol(LDSymbol::Null());
+
+  // The undefined entries are read now, since they may pull in archive
+  // members, and the defined data objects are sorted for the weak aliases.
+  // An entry defined in a section which is not read is also undefined.
+  NameList names;
+  for (uint32_t idx = 1; idx < pDynObj.numOfEntries; ++idx) {
+    LazyDynObj::Entry entry = pDynObj.entry(idx);
+    uint8_t binding = entry.info >> 4;
+    uint8_t type = entry.info & 0xF;
+    bool undefined = (entry.shndx == llvm::ELF::SHN_UNDEF);
+    if (entry.shndx != llvm::ELF::SHN_UNDEF &&
+        entry.shndx < llvm::ELF::SHN_LORESERVE) {
+      LDSection* section = input.context()->getSection(entry.shndx);
+      undefined = (section == NULL || LDFileFormat::Ignore == section->kind());
+    }
+
+    if (undefined || binding == llvm::ELF::STB_LOCAL) {
+      pDynObj.read[idx] = true;
+      pDynObj.batch.push_back(idx);
+      if (binding != llvm::ELF::STB_LOCAL)
+        names.push_back(pDynObj.name(entry));
+      continue;
+    }
+
+    if (entry.shndx == llvm::ELF::SHN_ABS && type == llvm::ELF::STT_SECTION)
+      type = llvm::ELF::STT_OBJECT;
+    if (type == llvm::ELF::STT_OBJECT &&
+        (binding == llvm::ELF::STB_WEAK ||
+         (binding == llvm::ELF::STB_GLOBAL &&
+          entry.shndx != llvm::ELF::SHN_ABS)))
+      pDynObj.objects.push_back(LazyDynObj::Object(entry.value, idx));
+  }
+  std::stable_sort(
+      pDynObj.objects.begin(), pDynObj.objects.end(), LazyDynObj::lessValue);
+
+  // the names which are already symbols have seen all the earlier shared
+  // objects, so only this one is looked up
+  NamePool& name_pool = m_Builder.getModule().getNamePool();
+  NamePool::syminfo_iterator info, infoEnd = name_pool.syminfo_end();
+  for (info = name_pool.syminfo_begin(); info != infoEnd; ++info) {
+    lookup(pDynObj,
+           llvm::StringRef((*info)->name(), (*info)->nameSize()),
+           names);
+  }
+
+  // the new names may also be defined by the earlier shared objects
+  importNames(names, 0);
+  return true;
+}
+
+void ELFDynObjReader::lookup(LazyDynObj& pDynObj,
+                             const llvm::StringRef& pName,
+                             NameList& pNames) const {
+  std::vector<uint32_t> candidates;
+  pDynObj.candidates(pName, candidates);
+  std::vector<uint32_t>::iterator idx, idxEnd = candidates.end();
+  for (idx = candidates.begin(); idx != idxEnd; ++idx) {
+    if (*idx >= pDynObj.numOfEntries || pDynObj.read[*idx])
+      continue;
+    if (pDynObj.name(pDynObj.entry(*idx)) == pName)
+      addEntry(pDynObj, *idx, pNames);
+  }
+}
+
+void ELFDynObjReader::addEntry(LazyDynObj& pDynObj,
+                               uint32_t pIdx,
+                               NameList& pNames) const {
+  pDynObj.read[pIdx] = true;
+  pDynObj.batch.push_back(pIdx);
+
+  // the weak aliases of a data object are read together, so that they are
+  // linked up by ELFReaderIF::findAliases()
+  LazyDynObj::Object key(pDynObj.entry(pIdx).value, pIdx);
+  std::pair<std::vector<LazyDynObj::Object>::iterator,
+            std::vector<LazyDynObj::Object>::iterator> range =
+      std::equal_range(pDynObj.objects.begin(),
+                       pDynObj.objects.end(),
+                       key,
+                       LazyDynObj::lessValue);
+  if (std::find(range.first, range.second, key) == range.second)
+    return;
+
+  for (; range.first != range.second; ++range.first) {
+    uint32_t alias = range.first->second;
+    if (pDynObj.read[alias])
+      continue;
+    pDynObj.read[alias] = true;
+    pDynObj.batch.push_back(alias);
+    pNames.push_back(pDynObj.name(pDynObj.entry(alias)));
+  }
+}
+
+void ELFDynObjReader::importNames(NameList& pNames, size_t pFirst) {
+  m_bImporting = true;
+  for (size_t n = pFirst; n < pNames.size(); ++n) {
+    LazyDynObjList::iterator dynobj, dynEnd = m_LazyDynObjs.end();
+    for (dynobj = m_LazyDynObjs.begin(); dynobj != dynEnd; ++dynobj)
+      lookup(**dynobj, pNames[n], pNames);
+  }
+
+  // read the entries in the order of the shared objects, and in the order of
+  // .dynsym in each of them, as if the whole .dynsym had been read
+  LazyDynObjList::iterator dynobj, dynEnd = m_LazyDynObjs.end();
+  for (dynobj = m_LazyDynObjs.begin(); dynobj != dynEnd; ++dynobj) {
+    std::vector<uint32_t>& batch = (*dynobj)->batch;
+    if (batch.empty())
+      continue;
+    std::sort(batch.begin(), batch.end());
+    m_pELFReader->readSymbols(*(*dynobj)->input,
+                              m_Builder,
+                              (*dynobj)->symtab,
+                              (*dynobj)->strtab,
+                              batch);
+    batch.clear();
+  }
+  m_bImporting = false;
 }
 
 }  // namespace mcld
@@ -276,6 +276,19 @@ bool ELFObjectReader::readSections(Input& pInput) {
 bool ELFObjectReader::readSymbols(Input& pInput) {
   assert(pInput.hasMemArea());
 
+  // replay the symbol table if it has been decoded ahead.
+  SymbolBufferMap::iterator buf = symbolBuffers().find(&pInput);
+  if (buf != symbolBuffers().end()) {
+    SymbolBuffer* buffer = buf->second;
+    symbolBuffers().erase(buf);
+    if (buffer != NULL && !buffer->empty()) {
+      bool result = m_pELFReader->resolveSymbols(pInput, m_Builder, *buffer);
+      delete buffer;
+      return result;
+    }
+    delete buffer;
+  }
+
   LDSection* symtab_shdr = pInput.context()->getSection(".symtab");
   if (symtab_shdr == NULL) {
     note(diag::note_has_no_symtab) << pInput.name() << pInput.path()
@@ -294,12 +307,48 @@ bool ELFObjectReader::readSymbols(Input& pInput) {
       pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
-  const char* strtab = strtab_region.begin();
-  bool result =
-      m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
+  bool result = m_pELFReader->readSymbols(
+      pInput, m_Builder, symtab_region, strtab_region);
   return result;
 }
 
+/// decodeSymbols - decode the symbol table of the input relocatable object.
+bool ELFObjectReader::decodeSymbols(Input& pInput,
+                                    SymbolBuffer& pBuffer) const {
+  if (!pInput.hasMemArea())
+    return false;
+
+  size_t hdr_size = m_pELFReader->getELFHeaderSize();
+  if (pInput.memArea()->size() < pInput.fileOffset() + hdr_size)
+    return false;
+
+  llvm::StringRef region =
+      pInput.memArea()->request(pInput.fileOffset(), hdr_size);
+  const char* ELF_hdr = region.begin();
+  if (!m_pELFReader->isELF(ELF_hdr) ||
+      Input::Object != m_pELFReader->fileType(ELF_hdr) ||
+      !m_pELFReader->isMyEndian(ELF_hdr) ||
+      !m_pELFReader->isMyMachine(ELF_hdr))
+    return false;
+
+  return m_pELFReader->decodeSymbols(
+      pInput, ELF_hdr, llvm::ELF::SHT_SYMTAB, pBuffer);
+}
+
+/// countSymbols - the number of entries in .symtab of the input relocatable
+/// object.
+size_t ELFObjectReader::countSymbols(Input& pInput) const {
+  size_t hdr_size = m_pELFReader->getELFHeaderSize();
+  if (!pInput.hasMemArea() ||
+      pInput.memArea()->size() < pInput.fileOffset() + hdr_size)
+    return 0;
+
+  llvm::StringRef region =
+      pInput.memArea()->request(pInput.fileOffset(), hdr_size);
+  return m_pELFReader->countSymbols(
+      pInput, region.begin(), llvm::ELF::SHT_SYMTAB);
+}
+
 bool ELFObjectReader::readRelocations(Input& pInput) {
   assert(pInput.hasMemArea());
 
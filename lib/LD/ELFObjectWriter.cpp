@@ -26,7 +26,10 @@
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/LD/StringTableBuilder.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/ThreadPool.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/GNUInfo.h"
 #include "mcld/Target/GNULDBackend.h"
 
@@ -37,6 +40,9 @@
 
 namespace mcld {
 
+/// the minimal size of the fragment ranges copied by one task
+static const size_t EmitChunkSize = 4 * 1024 * 1024;
+
 //===----------------------------------------------------------------------===//
 // ELFObjectWriter
 //===----------------------------------------------------------------------===//
@@ -116,8 +122,69 @@ void ELFObjectWriter::writeSection(Module& pModule,
   }
 }
 
+void ELFObjectWriter::writeSectionsConcurrently(Module& pModule,
+                                                FileOutputBuffer& pOutput) {
+  ThreadPool& pool = *getThreadPool();
+
+  // After layout the file ranges of the output sections are disjoint, so they
+  // can be written in any order. Target sections are emitted by the backend,
+  // which may keep state, so they are written in order on this thread.
+  Module::iterator sect, sectEnd = pModule.end();
+  for (sect = pModule.begin(); sect != sectEnd; ++sect) {
+    LDSection* section = *sect;
+    switch (section->kind()) {
+      case LDFileFormat::TEXT:
+      case LDFileFormat::DATA:
+      case LDFileFormat::Debug:
+      case LDFileFormat::Note:
+      case LDFileFormat::GCCExceptTable: {
+        if (!section->hasSectionData()) {
+          writeSection(pModule, pOutput, section);
+          break;
+        }
+        MemoryRegion region =
+            pOutput.request(section->offset(), section->size());
+        if (region.size() == 0)
+          break;
+
+        // split large sections into fragment ranges of EmitChunkSize bytes
+        const SectionData* sd = section->getSectionData();
+        SectionData::const_iterator begin = sd->begin(), frag = sd->begin();
+        SectionData::const_iterator fragEnd = sd->end();
+        size_t begin_offset = 0, cur_offset = 0;
+        while (frag != fragEnd) {
+          cur_offset += frag->size();
+          ++frag;
+          if (cur_offset - begin_offset < EmitChunkSize && frag != fragEnd)
+            continue;
+          pool.async([this, region, begin, frag, begin_offset]() {
+            MemoryRegion chunk = region;
+            emitFragments(begin, frag, chunk, begin_offset);
+          });
+          begin = frag;
+          begin_offset = cur_offset;
+        }
+        break;
+      }
+      case LDFileFormat::EhFrame:
+      case LDFileFormat::Relocation:
+      case LDFileFormat::DebugString: {
+        pool.async([this, &pModule, &pOutput, section]() {
+          writeSection(pModule, pOutput, section);
+        });
+        break;
+      }
+      default:
+        writeSection(pModule, pOutput, section);
+        break;
+    }
+  }
+  pool.wait();
+}
+
 std::error_code ELFObjectWriter::writeObject(Module& pModule,
                                              FileOutputBuffer& pOutput) {
+  TimeTrace::Scope trace("writeObject");
   bool is_dynobj = m_Config.codeGenType() == LinkerConfig::DynObj;
   bool is_exec = m_Config.codeGenType() == LinkerConfig::Exec;
   bool is_binary = m_Config.codeGenType() == LinkerConfig::Binary;
@@ -154,9 +221,13 @@ std::error_code ELFObjectWriter::writeObject(Module& pModule,
     }
   } else {
     // Write out regular ELF sections
-    Module::iterator sect, sectEnd = pModule.end();
-    for (sect = pModule.begin(); sect != sectEnd; ++sect)
-      writeSection(pModule, pOutput, *sect);
+    if (getThreadPool() != NULL) {
+      writeSectionsConcurrently(pModule, pOutput);
+    } else {
+      Module::iterator sect, sectEnd = pModule.end();
+      for (sect = pModule.begin(); sect != sectEnd; ++sect)
+        writeSection(pModule, pOutput, *sect);
+    }
 
     emitShStrTab(target().getOutputFormat()->getShStrTab(), pModule, pOutput);
 
@@ -267,6 +338,7 @@ uint64_t ELFObjectWriter::getEntryPoint(const LinkerConfig& pConfig,
                         LinkerConfig::Object != pConfig.codeGenType() &&
                         LinkerConfig::DynObj != pConfig.codeGenType());
 
+  // ObjectLinker::normalize() has imported the entry from shared objects
   const LDSymbol* entry_symbol = pModule.getNamePool().findSymbol(entry_name);
 
   // found the symbol
@@ -308,11 +380,12 @@ void ELFObjectWriter::emitSectionHeader(const Module& pModule,
   ElfXX_Shdr* shdr = reinterpret_cast<ElfXX_Shdr*>(region.begin());
 
   // Iterate the SectionTable in LDContext
+  const StringTableBuilder* shstrtab = target().getShStrTab();
+  assert(shstrtab != NULL);
   unsigned int sectIdx = 0;
-  unsigned int shstridx = 0;  // NULL section has empty name
   for (; sectIdx < sectNum; ++sectIdx) {
     const LDSection* ld_sect = pModule.getSectionTable().at(sectIdx);
-    shdr[sectIdx].sh_name = shstridx;
+    shdr[sectIdx].sh_name = shstrtab->getOffset(ld_sect->name());
     shdr[sectIdx].sh_type = ld_sect->type();
     shdr[sectIdx].sh_flags = ld_sect->flag();
     shdr[sectIdx].sh_addr = ld_sect->addr();
@@ -322,9 +395,6 @@ void ELFObjectWriter::emitSectionHeader(const Module& pModule,
     shdr[sectIdx].sh_entsize = getSectEntrySize<SIZE>(*ld_sect);
     shdr[sectIdx].sh_link = getSectLink(*ld_sect, pConfig);
     shdr[sectIdx].sh_info = getSectInfo(*ld_sect);
-
-    // adjust strshidx
-    shstridx += ld_sect->name().size() + 1;
   }
 }
 
@@ -366,15 +436,9 @@ void ELFObjectWriter::emitShStrTab(const LDSection& pShStrTab,
                                    FileOutputBuffer& pOutput) {
   // write out data
   MemoryRegion region = pOutput.request(pShStrTab.offset(), pShStrTab.size());
-  char* data = reinterpret_cast<char*>(region.begin());
-  size_t shstrsize = 0;
-  Module::const_iterator section, sectEnd = pModule.end();
-  for (section = pModule.begin(); section != sectEnd; ++section) {
-    ::memcpy(reinterpret_cast<char*>(data + shstrsize),
-             (*section)->name().data(),
-             (*section)->name().size());
-    shstrsize += (*section)->name().size() + 1;
-  }
+  const StringTableBuilder* shstrtab = target().getShStrTab();
+  assert(shstrtab != NULL && shstrtab->size() == pShStrTab.size());
+  shstrtab->emit(reinterpret_cast<char*>(region.begin()));
 }
 
 /// emitSectionData
@@ -648,9 +712,18 @@ uint64_t ELFObjectWriter::getLastStartOffset<64>(const Module& pModule) const {
 /// emitSectionData
 void ELFObjectWriter::emitSectionData(const SectionData& pSD,
                                       MemoryRegion& pRegion) const {
-  SectionData::const_iterator fragIter, fragEnd = pSD.end();
-  size_t cur_offset = 0;
-  for (fragIter = pSD.begin(); fragIter != fragEnd; ++fragIter) {
+  emitFragments(pSD.begin(), pSD.end(), pRegion, 0);
+}
+
+/// emitFragments - emit the fragments in [pBegin, pEnd), where pBegin is at
+/// pOffset of pRegion
+void ELFObjectWriter::emitFragments(SectionData::const_iterator pBegin,
+                                    SectionData::const_iterator pEnd,
+                                    MemoryRegion& pRegion,
+                                    size_t pOffset) const {
+  SectionData::const_iterator fragIter, fragEnd = pEnd;
+  size_t cur_offset = pOffset;
+  for (fragIter = pBegin; fragIter != fragEnd; ++fragIter) {
     size_t size = fragIter->size();
     switch (fragIter->getKind()) {
       case Fragment::Region: {
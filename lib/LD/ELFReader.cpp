@@ -13,6 +13,7 @@
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/LD/SymbolBuffer.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
@@ -61,142 +62,6 @@ bool ELFReader<32, true>::readRegularSection(Input& pInput,
   return true;
 }
 
-/// readSymbols - read ELF symbols and create LDSymbol
-bool ELFReader<32, true>::readSymbols(Input& pInput,
-                                      IRBuilder& pBuilder,
-                                      llvm::StringRef pRegion,
-                                      const char* pStrTab) const {
-  // get number of symbols
-  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
-  const llvm::ELF::Elf32_Sym* symtab =
-      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
-
-  uint32_t st_name = 0x0;
-  uint32_t st_value = 0x0;
-  uint32_t st_size = 0x0;
-  uint8_t st_info = 0x0;
-  uint8_t st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
-
-  /// recording symbols added from DynObj to analyze weak alias
-  std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type() == Input::DynObj);
-  for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
-
-    if (llvm::sys::IsLittleEndianHost) {
-      st_name = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    } else {
-      st_name = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap32(symtab[idx].st_value);
-      st_size = mcld::bswap32(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
-
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (pInput.context()->getSection(st_shndx) == NULL)
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
-
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
-
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
-
-    // get ld_binding
-    ResolveInfo::Binding ld_binding =
-        getSymBinding((st_info >> 4), st_shndx, st_other);
-
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
-
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
-
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
-
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(section != NULL && "get a invalid section");
-      ld_name = section->name();
-    } else {
-      ld_name = std::string(pStrTab + st_name);
-    }
-
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
-        (ResolveInfo::Global == ld_binding ||
-         ResolveInfo::Weak == ld_binding) &&
-        ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
-    }
-  }  // end of for loop
-
-  // analyze weak alias
-  // FIXME: it is better to let IRBuilder handle alias anlysis.
-  //        1. eliminate code duplication
-  //        2. easy to know if a symbol is from .so
-  //           (so that it may be a potential alias)
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
-      if (ResolveInfo::Weak != sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
-      while (alias_it != sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }  // end of for loop
-  }
-
-  return true;
-}
-
 //===----------------------------------------------------------------------===//
 // ELFReader::read relocations - read ELF rela and rel, and create Relocation
 //===----------------------------------------------------------------------===//
@@ -336,6 +201,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
   uint32_t sh_link = 0x0;
   uint32_t sh_info = 0x0;
   uint32_t sh_addralign = 0x0;
+  uint32_t sh_entsize = 0x0;
 
   // if shnum and shstrtab overflow, the actual values are in the 1st shdr
   if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
@@ -391,6 +257,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
       sh_link = shdrTab[idx].sh_link;
       sh_info = shdrTab[idx].sh_info;
       sh_addralign = shdrTab[idx].sh_addralign;
+      sh_entsize = shdrTab[idx].sh_entsize;
     } else {
       sh_name = mcld::bswap32(shdrTab[idx].sh_name);
       sh_type = mcld::bswap32(shdrTab[idx].sh_type);
@@ -400,6 +267,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
       sh_link = mcld::bswap32(shdrTab[idx].sh_link);
       sh_info = mcld::bswap32(shdrTab[idx].sh_info);
       sh_addralign = mcld::bswap32(shdrTab[idx].sh_addralign);
+      sh_entsize = mcld::bswap32(shdrTab[idx].sh_entsize);
     }
 
     LDSection* section = IRBuilder::CreateELFHeader(
@@ -407,6 +275,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
+    section->setEntSize(sh_entsize);
 
     if (sh_link != 0x0 || sh_info != 0x0) {
       LinkInfo link_info = {section, sh_link, sh_info};
@@ -426,6 +295,176 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
   return true;
 }
 
+/// findSymbolTable - find the first section of type pType (SHT_SYMTAB or
+/// SHT_DYNSYM) and its string table in the mapped file. Nothing but the
+/// section header table is read.
+bool ELFReader<32, true>::findSymbolTable(Input& pInput,
+                                          const void* pELFHeader,
+                                          uint32_t pType,
+                                          llvm::StringRef& pSymTab,
+                                          llvm::StringRef& pStrTab) const {
+  const llvm::ELF::Elf32_Ehdr* ehdr =
+      reinterpret_cast<const llvm::ELF::Elf32_Ehdr*>(pELFHeader);
+  MemoryArea* mem = pInput.memArea();
+  uint64_t file_size = mem->size() - pInput.fileOffset();
+
+  uint64_t shoff = 0x0;
+  uint16_t shentsize = 0x0;
+  uint32_t shnum = 0x0;
+
+  if (llvm::sys::IsLittleEndianHost) {
+    shoff = ehdr->e_shoff;
+    shentsize = ehdr->e_shentsize;
+    shnum = ehdr->e_shnum;
+  } else {
+    shoff = mcld::bswap32(ehdr->e_shoff);
+    shentsize = mcld::bswap16(ehdr->e_shentsize);
+    shnum = mcld::bswap16(ehdr->e_shnum);
+  }
+
+  if (shoff == 0x0 || shentsize != sizeof(llvm::ELF::Elf32_Shdr) ||
+      shoff + shentsize > file_size)
+    return false;
+
+  llvm::StringRef shdr_region = mem->request(pInput.fileOffset() + shoff,
+                                             file_size - shoff);
+  const llvm::ELF::Elf32_Shdr* shdrTab =
+      reinterpret_cast<const llvm::ELF::Elf32_Shdr*>(shdr_region.begin());
+
+  // if shnum overflows, the actual value is in the 1st shdr
+  if (shnum == llvm::ELF::SHN_UNDEF) {
+    if (llvm::sys::IsLittleEndianHost)
+      shnum = shdrTab[0].sh_size;
+    else
+      shnum = mcld::bswap32(shdrTab[0].sh_size);
+  }
+
+  if (static_cast<uint64_t>(shnum) * shentsize > file_size - shoff)
+    return false;
+
+  // find the symbol table and its string table
+  uint64_t sym_offset = 0x0, sym_size = 0x0;
+  uint64_t str_offset = 0x0, str_size = 0x0;
+  uint32_t sh_link = 0x0;
+  bool found = false;
+  for (size_t idx = 0; idx < shnum; ++idx) {
+    uint32_t sh_type = llvm::sys::IsLittleEndianHost
+                           ? shdrTab[idx].sh_type
+                           : mcld::bswap32(shdrTab[idx].sh_type);
+    if (sh_type != pType)
+      continue;
+
+    if (llvm::sys::IsLittleEndianHost) {
+      sym_offset = shdrTab[idx].sh_offset;
+      sym_size = shdrTab[idx].sh_size;
+      sh_link = shdrTab[idx].sh_link;
+    } else {
+      sym_offset = mcld::bswap32(shdrTab[idx].sh_offset);
+      sym_size = mcld::bswap32(shdrTab[idx].sh_size);
+      sh_link = mcld::bswap32(shdrTab[idx].sh_link);
+    }
+    found = true;
+    break;
+  }
+
+  if (!found || sh_link == 0x0 || sh_link >= shnum)
+    return false;
+
+  if (llvm::sys::IsLittleEndianHost) {
+    str_offset = shdrTab[sh_link].sh_offset;
+    str_size = shdrTab[sh_link].sh_size;
+  } else {
+    str_offset = mcld::bswap32(shdrTab[sh_link].sh_offset);
+    str_size = mcld::bswap32(shdrTab[sh_link].sh_size);
+  }
+
+  if (sym_offset > file_size || sym_size > file_size - sym_offset ||
+      str_offset > file_size || str_size > file_size - str_offset)
+    return false;
+
+  pSymTab = mem->request(pInput.fileOffset() + sym_offset, sym_size);
+  pStrTab = mem->request(pInput.fileOffset() + str_offset, str_size);
+  return true;
+}
+
+/// countSymbols - the number of entries in the symbol table of type pType,
+/// or 0 if there is none.
+size_t ELFReader<32, true>::countSymbols(Input& pInput,
+                                         const void* pELFHeader,
+                                         uint32_t pType) const {
+  llvm::StringRef symtab_region, strtab;
+  if (!findSymbolTable(pInput, pELFHeader, pType, symtab_region, strtab))
+    return 0;
+  return symtab_region.size() / sizeof(llvm::ELF::Elf32_Sym);
+}
+
+/// decodeSymbols - decode the symbol table of type pType into pBuffer. Only
+/// the mapped file is read, and no diagnostic is emitted, so that it is safe to
+/// run concurrently.
+bool ELFReader<32, true>::decodeSymbols(Input& pInput,
+                                        const void* pELFHeader,
+                                        uint32_t pType,
+                                        SymbolBuffer& pBuffer) const {
+  llvm::StringRef symtab_region, strtab;
+  if (!findSymbolTable(pInput, pELFHeader, pType, symtab_region, strtab))
+    return false;
+  return decodeSymbolEntries(symtab_region, strtab, NULL, pBuffer);
+}
+
+/// decodeSymbolEntries - decode all the entries but the first NULL symbol if
+/// pIndices is NULL, or the entries in pIndices otherwise
+bool ELFReader<32, true>::decodeSymbolEntries(
+    llvm::StringRef pRegion,
+    llvm::StringRef pStrTab,
+    const std::vector<uint32_t>* pIndices,
+    SymbolBuffer& pBuffer) const {
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
+  const llvm::ELF::Elf32_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
+
+  size_t count = (pIndices != NULL) ? pIndices->size()
+                                    : ((entsize > 0) ? entsize - 1 : 0);
+  pBuffer.clear();
+  pBuffer.reserve(count);
+  for (size_t n = 0; n < count; ++n) {
+    size_t idx = (pIndices != NULL) ? (*pIndices)[n] : n + 1;
+    if (idx >= entsize) {
+      pBuffer.clear();
+      return false;
+    }
+
+    SymbolBuffer::Entry entry;
+    uint32_t st_name = 0x0;
+    entry.info = symtab[idx].st_info;
+    entry.other = symtab[idx].st_other;
+    if (llvm::sys::IsLittleEndianHost) {
+      st_name = symtab[idx].st_name;
+      entry.value = symtab[idx].st_value;
+      entry.size = symtab[idx].st_size;
+      entry.shndx = symtab[idx].st_shndx;
+    } else {
+      st_name = mcld::bswap32(symtab[idx].st_name);
+      entry.value = mcld::bswap32(symtab[idx].st_value);
+      entry.size = mcld::bswap32(symtab[idx].st_size);
+      entry.shndx = mcld::bswap16(symtab[idx].st_shndx);
+    }
+
+    if (st_name >= pStrTab.size()) {
+      pBuffer.clear();
+      return false;
+    }
+
+    size_t length = pStrTab.find('\0', st_name);
+    if (length == llvm::StringRef::npos) {
+      pBuffer.clear();
+      return false;
+    }
+    entry.name = pStrTab.slice(st_name, length);
+    pBuffer.append(entry);
+  }
+  return true;
+}
+
 /// readSignature - read a symbol from the given Input and index in symtab
 /// This is used to get the signature of a group section.
 ResolveInfo* ELFReader<32, true>::readSignature(Input& pInput,
@@ -561,137 +600,6 @@ bool ELFReader<64, true>::readRegularSection(Input& pInput,
   return true;
 }
 
-/// readSymbols - read ELF symbols and create LDSymbol
-bool ELFReader<64, true>::readSymbols(Input& pInput,
-                                      IRBuilder& pBuilder,
-                                      llvm::StringRef pRegion,
-                                      const char* pStrTab) const {
-  // get number of symbols
-  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf64_Sym);
-  const llvm::ELF::Elf64_Sym* symtab =
-      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
-
-  uint32_t st_name = 0x0;
-  uint64_t st_value = 0x0;
-  uint64_t st_size = 0x0;
-  uint8_t st_info = 0x0;
-  uint8_t st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
-
-  /// recording symbols added from DynObj to analyze weak alias
-  std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type() == Input::DynObj);
-  for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
-
-    if (llvm::sys::IsLittleEndianHost) {
-      st_name = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    } else {
-      st_name = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap64(symtab[idx].st_value);
-      st_size = mcld::bswap64(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
-
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (pInput.context()->getSection(st_shndx) == NULL)
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
-
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
-
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
-
-    // get ld_binding
-    ResolveInfo::Binding ld_binding =
-        getSymBinding((st_info >> 4), st_shndx, st_other);
-
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
-
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
-
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
-
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(section != NULL && "get a invalid section");
-      ld_name = section->name();
-    } else {
-      ld_name = std::string(pStrTab + st_name);
-    }
-
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
-        (ResolveInfo::Global == ld_binding ||
-         ResolveInfo::Weak == ld_binding) &&
-        ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
-    }
-  }  // end of for loop
-
-  // analyze weak alias here
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
-      if (ResolveInfo::Weak != sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
-      while (alias_it != sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }  // end of for loop
-  }
-  return true;
-}
-
 //===----------------------------------------------------------------------===//
 // ELFReader::read relocations - read ELF rela and rel, and create Relocation
 //===----------------------------------------------------------------------===//
@@ -830,6 +738,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
   uint32_t sh_link = 0x0;
   uint32_t sh_info = 0x0;
   uint64_t sh_addralign = 0x0;
+  uint64_t sh_entsize = 0x0;
 
   // if shnum and shstrtab overflow, the actual values are in the 1st shdr
   if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
@@ -885,6 +794,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
       sh_link = shdrTab[idx].sh_link;
       sh_info = shdrTab[idx].sh_info;
       sh_addralign = shdrTab[idx].sh_addralign;
+      sh_entsize = shdrTab[idx].sh_entsize;
     } else {
       sh_name = mcld::bswap32(shdrTab[idx].sh_name);
       sh_type = mcld::bswap32(shdrTab[idx].sh_type);
@@ -894,6 +804,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
       sh_link = mcld::bswap32(shdrTab[idx].sh_link);
       sh_info = mcld::bswap32(shdrTab[idx].sh_info);
       sh_addralign = mcld::bswap64(shdrTab[idx].sh_addralign);
+      sh_entsize = mcld::bswap64(shdrTab[idx].sh_entsize);
     }
 
     LDSection* section = IRBuilder::CreateELFHeader(
@@ -901,6 +812,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
+    section->setEntSize(sh_entsize);
 
     if (sh_link != 0x0 || sh_info != 0x0) {
       LinkInfo link_info = {section, sh_link, sh_info};
@@ -920,6 +832,176 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
   return true;
 }
 
+/// findSymbolTable - find the first section of type pType (SHT_SYMTAB or
+/// SHT_DYNSYM) and its string table in the mapped file. Nothing but the
+/// section header table is read.
+bool ELFReader<64, true>::findSymbolTable(Input& pInput,
+                                          const void* pELFHeader,
+                                          uint32_t pType,
+                                          llvm::StringRef& pSymTab,
+                                          llvm::StringRef& pStrTab) const {
+  const llvm::ELF::Elf64_Ehdr* ehdr =
+      reinterpret_cast<const llvm::ELF::Elf64_Ehdr*>(pELFHeader);
+  MemoryArea* mem = pInput.memArea();
+  uint64_t file_size = mem->size() - pInput.fileOffset();
+
+  uint64_t shoff = 0x0;
+  uint16_t shentsize = 0x0;
+  uint32_t shnum = 0x0;
+
+  if (llvm::sys::IsLittleEndianHost) {
+    shoff = ehdr->e_shoff;
+    shentsize = ehdr->e_shentsize;
+    shnum = ehdr->e_shnum;
+  } else {
+    shoff = mcld::bswap64(ehdr->e_shoff);
+    shentsize = mcld::bswap16(ehdr->e_shentsize);
+    shnum = mcld::bswap16(ehdr->e_shnum);
+  }
+
+  if (shoff == 0x0 || shentsize != sizeof(llvm::ELF::Elf64_Shdr) ||
+      shoff + shentsize > file_size)
+    return false;
+
+  llvm::StringRef shdr_region = mem->request(pInput.fileOffset() + shoff,
+                                             file_size - shoff);
+  const llvm::ELF::Elf64_Shdr* shdrTab =
+      reinterpret_cast<const llvm::ELF::Elf64_Shdr*>(shdr_region.begin());
+
+  // if shnum overflows, the actual value is in the 1st shdr
+  if (shnum == llvm::ELF::SHN_UNDEF) {
+    if (llvm::sys::IsLittleEndianHost)
+      shnum = shdrTab[0].sh_size;
+    else
+      shnum = mcld::bswap64(shdrTab[0].sh_size);
+  }
+
+  if (static_cast<uint64_t>(shnum) * shentsize > file_size - shoff)
+    return false;
+
+  // find the symbol table and its string table
+  uint64_t sym_offset = 0x0, sym_size = 0x0;
+  uint64_t str_offset = 0x0, str_size = 0x0;
+  uint32_t sh_link = 0x0;
+  bool found = false;
+  for (size_t idx = 0; idx < shnum; ++idx) {
+    uint32_t sh_type = llvm::sys::IsLittleEndianHost
+                           ? shdrTab[idx].sh_type
+                           : mcld::bswap32(shdrTab[idx].sh_type);
+    if (sh_type != pType)
+      continue;
+
+    if (llvm::sys::IsLittleEndianHost) {
+      sym_offset = shdrTab[idx].sh_offset;
+      sym_size = shdrTab[idx].sh_size;
+      sh_link = shdrTab[idx].sh_link;
+    } else {
+      sym_offset = mcld::bswap64(shdrTab[idx].sh_offset);
+      sym_size = mcld::bswap64(shdrTab[idx].sh_size);
+      sh_link = mcld::bswap32(shdrTab[idx].sh_link);
+    }
+    found = true;
+    break;
+  }
+
+  if (!found || sh_link == 0x0 || sh_link >= shnum)
+    return false;
+
+  if (llvm::sys::IsLittleEndianHost) {
+    str_offset = shdrTab[sh_link].sh_offset;
+    str_size = shdrTab[sh_link].sh_size;
+  } else {
+    str_offset = mcld::bswap64(shdrTab[sh_link].sh_offset);
+    str_size = mcld::bswap64(shdrTab[sh_link].sh_size);
+  }
+
+  if (sym_offset > file_size || sym_size > file_size - sym_offset ||
+      str_offset > file_size || str_size > file_size - str_offset)
+    return false;
+
+  pSymTab = mem->request(pInput.fileOffset() + sym_offset, sym_size);
+  pStrTab = mem->request(pInput.fileOffset() + str_offset, str_size);
+  return true;
+}
+
+/// countSymbols - the number of entries in the symbol table of type pType,
+/// or 0 if there is none.
+size_t ELFReader<64, true>::countSymbols(Input& pInput,
+                                         const void* pELFHeader,
+                                         uint32_t pType) const {
+  llvm::StringRef symtab_region, strtab;
+  if (!findSymbolTable(pInput, pELFHeader, pType, symtab_region, strtab))
+    return 0;
+  return symtab_region.size() / sizeof(llvm::ELF::Elf64_Sym);
+}
+
+/// decodeSymbols - decode the symbol table of type pType into pBuffer. Only
+/// the mapped file is read, and no diagnostic is emitted, so that it is safe to
+/// run concurrently.
+bool ELFReader<64, true>::decodeSymbols(Input& pInput,
+                                        const void* pELFHeader,
+                                        uint32_t pType,
+                                        SymbolBuffer& pBuffer) const {
+  llvm::StringRef symtab_region, strtab;
+  if (!findSymbolTable(pInput, pELFHeader, pType, symtab_region, strtab))
+    return false;
+  return decodeSymbolEntries(symtab_region, strtab, NULL, pBuffer);
+}
+
+/// decodeSymbolEntries - decode all the entries but the first NULL symbol if
+/// pIndices is NULL, or the entries in pIndices otherwise
+bool ELFReader<64, true>::decodeSymbolEntries(
+    llvm::StringRef pRegion,
+    llvm::StringRef pStrTab,
+    const std::vector<uint32_t>* pIndices,
+    SymbolBuffer& pBuffer) const {
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf64_Sym);
+  const llvm::ELF::Elf64_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
+
+  size_t count = (pIndices != NULL) ? pIndices->size()
+                                    : ((entsize > 0) ? entsize - 1 : 0);
+  pBuffer.clear();
+  pBuffer.reserve(count);
+  for (size_t n = 0; n < count; ++n) {
+    size_t idx = (pIndices != NULL) ? (*pIndices)[n] : n + 1;
+    if (idx >= entsize) {
+      pBuffer.clear();
+      return false;
+    }
+
+    SymbolBuffer::Entry entry;
+    uint32_t st_name = 0x0;
+    entry.info = symtab[idx].st_info;
+    entry.other = symtab[idx].st_other;
+    if (llvm::sys::IsLittleEndianHost) {
+      st_name = symtab[idx].st_name;
+      entry.value = symtab[idx].st_value;
+      entry.size = symtab[idx].st_size;
+      entry.shndx = symtab[idx].st_shndx;
+    } else {
+      st_name = mcld::bswap32(symtab[idx].st_name);
+      entry.value = mcld::bswap64(symtab[idx].st_value);
+      entry.size = mcld::bswap64(symtab[idx].st_size);
+      entry.shndx = mcld::bswap16(symtab[idx].st_shndx);
+    }
+
+    if (st_name >= pStrTab.size()) {
+      pBuffer.clear();
+      return false;
+    }
+
+    size_t length = pStrTab.find('\0', st_name);
+    if (length == llvm::StringRef::npos) {
+      pBuffer.clear();
+      return false;
+    }
+    entry.name = pStrTab.slice(st_name, length);
+    pBuffer.append(entry);
+  }
+  return true;
+}
+
 /// readSignature - read a symbol from the given Input and index in symtab
 /// This is used to get the signature of a group section.
 ResolveInfo* ELFReader<64, true>::readSignature(Input& pInput,
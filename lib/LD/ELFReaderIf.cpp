@@ -9,10 +9,12 @@
 #include "mcld/LD/ELFReaderIf.h"
 
 #include "mcld/IRBuilder.h"
+#include "mcld/Module.h"
 #include "mcld/Fragment/FillFragment.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/LD/SymbolBuffer.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
@@ -20,7 +22,9 @@
 #include <llvm/Support/ELF.h>
 #include <llvm/Support/Host.h>
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace mcld {
 
@@ -151,4 +155,179 @@ uint64_t ELFReaderIF::getSymValue(uint64_t pValue,
   return pValue;
 }
 
+/// readSymbols - read ELF symbols and create LDSymbol
+bool ELFReaderIF::readSymbols(Input& pInput,
+                              IRBuilder& pBuilder,
+                              llvm::StringRef pRegion,
+                              llvm::StringRef pStrTab) const {
+  SymbolBuffer buffer;
+  if (!decodeSymbolEntries(pRegion, pStrTab, NULL, buffer))
+    return false;
+  return resolveSymbols(pInput, pBuilder, buffer);
+}
+
+/// readSymbols - read the given entries of the ELF symbols
+bool ELFReaderIF::readSymbols(Input& pInput,
+                              IRBuilder& pBuilder,
+                              llvm::StringRef pRegion,
+                              llvm::StringRef pStrTab,
+                              const std::vector<uint32_t>& pIndices) const {
+  SymbolBuffer buffer;
+  if (!decodeSymbolEntries(pRegion, pStrTab, &pIndices, buffer))
+    return false;
+  if (pInput.type() == Input::DynObj)
+    findAliases(pInput, buffer);
+  return addSymbols(pInput, pBuilder, buffer);
+}
+
+/// resolveSymbols - create LDSymbols from the decoded symbol table.
+bool ELFReaderIF::resolveSymbols(Input& pInput,
+                                 IRBuilder& pBuilder,
+                                 const SymbolBuffer& pBuffer) const {
+  // skip the first NULL symbol
+  pInput.context()->addSymbol(LDSymbol::Null());
+  return addSymbols(pInput, pBuilder, pBuffer);
+}
+
+/// addSymbols - create LDSymbols from the decoded entries.
+bool ELFReaderIF::addSymbols(Input& pInput,
+                             IRBuilder& pBuilder,
+                             const SymbolBuffer& pBuffer) const {
+  const SymbolBuffer::AliasList& aliases = pBuffer.aliases();
+  std::vector<LDSymbol*> symbols;
+  if (!aliases.empty())
+    symbols.reserve(pBuffer.size());
+
+  SymbolBuffer::const_iterator entry, entryEnd = pBuffer.end();
+  for (entry = pBuffer.begin(); entry != entryEnd; ++entry) {
+    uint16_t st_shndx = entry->shndx;
+
+    // If the section should not be included, set the st_shndx SHN_UNDEF
+    // - A section in interrelated groups are not included.
+    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
+        st_shndx != llvm::ELF::SHN_UNDEF) {
+      if (pInput.context()->getSection(st_shndx) == NULL)
+        st_shndx = llvm::ELF::SHN_UNDEF;
+    }
+
+    ResolveInfo::Type ld_type = getSymType(entry->info, st_shndx);
+    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+    ResolveInfo::Binding ld_binding =
+        getSymBinding((entry->info >> 4), st_shndx, entry->other);
+    uint64_t ld_value = getSymValue(entry->value, st_shndx, pInput);
+    ResolveInfo::Visibility ld_vis = getSymVisibility(entry->other);
+
+    LDSection* section = NULL;
+    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
+      section = pInput.context()->getSection(st_shndx);
+
+    llvm::StringRef ld_name;
+    if (ResolveInfo::Section == ld_type) {
+      // Section symbol's st_name is the section index.
+      assert(section != NULL && "get a invalid section");
+      ld_name = section->name();
+    } else {
+      ld_name = entry->name;
+    }
+
+    LDSymbol* psym = pBuilder.AddSymbol(pInput,
+                                        ld_name,
+                                        ld_type,
+                                        ld_desc,
+                                        ld_binding,
+                                        entry->size,
+                                        ld_value,
+                                        section,
+                                        ld_vis);
+    if (!aliases.empty())
+      symbols.push_back(psym);
+  }
+
+  // link up the weak aliases
+  Module& module = pBuilder.getModule();
+  for (size_t group = 0; group < aliases.size(); group += aliases[group] + 1) {
+    for (uint32_t n = 1; n <= aliases[group]; ++n) {
+      LDSymbol* alias = symbols[aliases[group + n]];
+      assert(alias != NULL && "a weak alias is not a symbol");
+      if (n == 1)
+        module.CreateAliasList(*alias->resolveInfo());
+      else
+        module.addAlias(*alias->resolveInfo());
+    }
+  }
+  return true;
+}
+
+namespace {
+
+/// AliasEntry - a defined data object of a shared object, which may be a weak
+/// alias of the others at the same value
+struct AliasEntry {
+  uint32_t pos;
+  uint64_t value;
+  llvm::StringRef name;
+  bool weak;
+};
+
+/// sort by value, weak before strong, and then by name
+bool lessAlias(const AliasEntry& pX, const AliasEntry& pY) {
+  if (pX.value != pY.value)
+    return (pX.value < pY.value);
+  if (pX.weak != pY.weak)
+    return pX.weak;
+  return (pX.name < pY.name);
+}
+
+}  // anonymous namespace
+
+/// findAliases - the potential aliases are the global and weak data objects
+/// which become symbols, and a group is a weak one followed by all the others
+/// at the same value.
+void ELFReaderIF::findAliases(const Input& pInput,
+                              SymbolBuffer& pBuffer) const {
+  assert(pInput.type() == Input::DynObj);
+  pBuffer.aliases().clear();
+
+  std::vector<AliasEntry> candidates;
+  for (size_t pos = 0; pos < pBuffer.size(); ++pos) {
+    const SymbolBuffer::Entry& entry = pBuffer.at(pos);
+    ResolveInfo::Type ld_type = getSymType(entry.info, entry.shndx);
+    ResolveInfo::Desc ld_desc = getSymDesc(entry.shndx, pInput);
+    ResolveInfo::Binding ld_binding =
+        getSymBinding((entry.info >> 4), entry.shndx, entry.other);
+    ResolveInfo::Visibility ld_vis = getSymVisibility(entry.other);
+
+    // IRBuilder ignores the internal and hidden symbols of shared objects
+    if (ResolveInfo::Object != ld_type || ResolveInfo::Undefined == ld_desc ||
+        (ResolveInfo::Global != ld_binding && ResolveInfo::Weak != ld_binding) ||
+        ResolveInfo::Internal == ld_vis || ResolveInfo::Hidden == ld_vis)
+      continue;
+
+    AliasEntry candidate;
+    candidate.pos = pos;
+    candidate.value = getSymValue(entry.value, entry.shndx, pInput);
+    candidate.name = entry.name;
+    candidate.weak = (ResolveInfo::Weak == ld_binding);
+    candidates.push_back(candidate);
+  }
+  std::sort(candidates.begin(), candidates.end(), lessAlias);
+
+  std::vector<AliasEntry>::iterator sym_it, sym_e = candidates.end();
+  for (sym_it = candidates.begin(); sym_it != sym_e; ++sym_it) {
+    if (!sym_it->weak)
+      continue;
+
+    std::vector<AliasEntry>::iterator alias_it = sym_it + 1;
+    while (alias_it != sym_e && alias_it->value == sym_it->value)
+      ++alias_it;
+
+    if (alias_it - sym_it > 1) {
+      pBuffer.aliases().push_back(alias_it - sym_it);
+      for (; sym_it != alias_it; ++sym_it)
+        pBuffer.aliases().push_back(sym_it->pos);
+    }
+    sym_it = alias_it - 1;
+  }
+}
+
 }  // namespace mcld
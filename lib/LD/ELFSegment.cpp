@@ -8,18 +8,17 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/ELFSegment.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Config/Config.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 #include <cassert>
 
 namespace mcld {
 
 typedef GCFactory<ELFSegment, MCLD_SEGMENTS_PER_OUTPUT> ELFSegmentFactory;
-static llvm::ManagedStatic<ELFSegmentFactory> g_ELFSegmentFactory;
+static LinkStatic<ELFSegmentFactory> g_ELFSegmentFactory;
 
 //===----------------------------------------------------------------------===//
 // ELFSegment
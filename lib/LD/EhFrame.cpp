@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/EhFrame.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Fragment/Relocation.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/LDSection.h"
@@ -19,13 +20,11 @@
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 namespace mcld {
 
 typedef GCFactory<EhFrame, MCLD_SECTIONS_PER_INPUT> EhFrameFactory;
 
-static llvm::ManagedStatic<EhFrameFactory> g_EhFrameFactory;
+static LinkStatic<EhFrameFactory> g_EhFrameFactory;
 
 //===----------------------------------------------------------------------===//
 // EhFrame::Record
@@ -14,19 +14,31 @@
 #include "mcld/ADT/SizeTraits.h"
 #include "mcld/MC/Attribute.h"
 #include "mcld/MC/Input.h"
+#include "mcld/ADT/HashEntry.h"
+#include "mcld/ADT/HashTable.h"
+#include "mcld/ADT/StringHash.h"
 #include "mcld/LD/ELFObjectReader.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/NamePool.h"
 #include "mcld/LD/ResolveInfo.h"
+#include "mcld/LD/SymbolBuffer.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileSystem.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/Path.h"
+#include "mcld/Support/ThreadPool.h"
+#include "mcld/Support/TimeTrace.h"
 
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/Host.h>
 
 #include <cstdlib>
 #include <cstring>
+#include <set>
+#include <vector>
 
 namespace mcld {
 
@@ -36,6 +48,7 @@ GNUArchiveReader::GNUArchiveReader(Module& pModule,
 }
 
 GNUArchiveReader::~GNUArchiveReader() {
+  clearDecodedMembers();
 }
 
 /// isMyFormat
@@ -82,8 +95,140 @@ bool GNUArchiveReader::isThinArchive(Input& pInput) const {
   return result;
 }
 
+//===----------------------------------------------------------------------===//
+// ArchiveWorklist
+//===----------------------------------------------------------------------===//
+/** \class ArchiveWorklist
+ *  \brief ArchiveWorklist keeps the armap entries of some archives which are
+ *  to be visited, in armap order.
+ *
+ *  When a member is included, the names it refers but does not define are
+ *  looked up once in an index of all the archives, and their entries are
+ *  added to the worklists of the archives that have them.
+ */
+class ArchiveWorklist {
+ public:
+  typedef std::set<size_t> Worklist;
+
+ public:
+  explicit ArchiveWorklist(const std::vector<Archive*>& pArchives);
+
+  Archive& archive(size_t pIdx) { return *m_Archives[pIdx]; }
+
+  Worklist& worklist(size_t pIdx) { return m_Worklists[pIdx]; }
+
+  /// addUndefined - add the unknown entries of the pIdx-th archive whose
+  /// names are undefined in pNamePool
+  void addUndefined(size_t pIdx, const NamePool& pNamePool);
+
+  /// addReferred - add the unknown entries of the undefined names in the
+  /// symbol table of pMember
+  void addReferred(Input& pMember);
+
+ private:
+  /// addEntries - add the unknown entries named pName of the pIdx-th archive
+  void addEntries(size_t pIdx, const llvm::StringRef& pName);
+
+ private:
+  /// Occurrence - an archive having a name, and the next one having it
+  struct Occurrence {
+    size_t archive;
+    size_t next;
+  };
+
+  typedef HashEntry<const llvm::StringRef,
+                    size_t,
+                    hash::StringCompare<llvm::StringRef> > IndexEntryType;
+
+  typedef HashTable<IndexEntryType,
+                    hash::StringHash<hash::WY>,
+                    EntryFactory<IndexEntryType> > IndexType;
+
+ private:
+  const std::vector<Archive*>& m_Archives;
+  std::vector<Worklist> m_Worklists;
+
+  // the first occurrence of each name. A single archive is looked up by its
+  // own index instead.
+  IndexType m_Index;
+  std::vector<Occurrence> m_Occurrences;
+};
+
+ArchiveWorklist::ArchiveWorklist(const std::vector<Archive*>& pArchives)
+    : m_Archives(pArchives), m_Worklists(pArchives.size()) {
+  if (m_Archives.size() < 2)
+    return;
+
+  for (size_t ar = 0; ar < m_Archives.size(); ++ar) {
+    for (size_t idx = 0; idx < m_Archives[ar]->numOfSymbols(); ++idx) {
+      bool exist = false;
+      IndexEntryType* entry =
+          m_Index.insert(m_Archives[ar]->getSymbolName(idx), exist);
+      // the archives are indexed in turn, so a repeated name of the same
+      // archive is always the latest occurrence
+      if (exist && m_Occurrences[entry->value()].archive == ar)
+        continue;
+      Occurrence occurrence = { ar, Archive::NoSymbol };
+      if (exist)
+        occurrence.next = entry->value();
+      entry->value() = m_Occurrences.size();
+      m_Occurrences.push_back(occurrence);
+    }
+  }
+}
+
+void ArchiveWorklist::addUndefined(size_t pIdx, const NamePool& pNamePool) {
+  Archive& ar = *m_Archives[pIdx];
+  for (size_t idx = 0; idx < ar.numOfSymbols(); ++idx) {
+    if (Archive::Symbol::Unknown != ar.getSymbolStatus(idx))
+      continue;
+    const ResolveInfo* info = pNamePool.findInfo(ar.getSymbolName(idx));
+    if (info != NULL && info->isUndef())
+      m_Worklists[pIdx].insert(idx);
+  }
+}
+
+void ArchiveWorklist::addReferred(Input& pMember) {
+  if (pMember.context() == NULL)
+    return;
+
+  LDContext::sym_iterator sym, symEnd = pMember.context()->symTabEnd();
+  for (sym = pMember.context()->symTabBegin(); sym != symEnd; ++sym) {
+    const ResolveInfo* info = (*sym)->resolveInfo();
+    if (!info->isUndef() || info->isLocal())
+      continue;
+
+    llvm::StringRef name(info->name(), info->nameSize());
+    if (m_Archives.size() < 2) {
+      addEntries(0, name);
+      continue;
+    }
+
+    IndexType::iterator entry = m_Index.find(name);
+    if (entry == m_Index.end())
+      continue;
+    for (size_t occ = entry.getEntry()->value(); occ != Archive::NoSymbol;
+         occ = m_Occurrences[occ].next)
+      addEntries(m_Occurrences[occ].archive, name);
+  }
+}
+
+void ArchiveWorklist::addEntries(size_t pIdx, const llvm::StringRef& pName) {
+  Archive& ar = *m_Archives[pIdx];
+  for (size_t idx = ar.findSymbol(pName); idx != Archive::NoSymbol;
+       idx = ar.getNextSymbol(idx)) {
+    if (Archive::Symbol::Unknown == ar.getSymbolStatus(idx))
+      m_Worklists[pIdx].insert(idx);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// GNUArchiveReader
+//===----------------------------------------------------------------------===//
 bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
                                    Archive& pArchive) {
+  TimeTrace::Scope trace("readArchive", pArchive.getARFile().name());
+
   // bypass the empty archive
   if (Archive::MAGIC_LEN == pArchive.getARFile().memArea()->size())
     return true;
@@ -106,35 +251,108 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
   }
 
   // include the needed members in the archive and build up the input tree
-  bool willSymResolved;
-  do {
-    willSymResolved = false;
-    for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx) {
-      // bypass if we already decided to include this symbol or not
-      if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(idx))
-        continue;
+  std::vector<Archive*> archives(1, &pArchive);
+  ArchiveWorklist worklist(archives);
+  worklist.addUndefined(0, m_Module.getNamePool());
+  includeNeededMembers(pConfig, worklist, 0);
+  clearDecodedMembers();
+  return true;
+}
 
-      // bypass if another symbol with the same object file offset is included
-      if (pArchive.hasObjectMember(pArchive.getObjFileOffset(idx))) {
-        pArchive.setSymbolStatus(idx, Archive::Symbol::Include);
-        continue;
-      }
+bool GNUArchiveReader::readArchives(const LinkerConfig& pConfig,
+                                    const std::vector<Archive*>& pArchives) {
+  TimeTrace::Scope trace("readArchives");
+
+  // the archives included all or nothing are not read again
+  std::vector<Archive*> archives;
+  std::vector<Archive*>::const_iterator ar, arEnd = pArchives.end();
+  for (ar = pArchives.begin(); ar != arEnd; ++ar) {
+    if (Archive::MAGIC_LEN != (*ar)->getARFile().memArea()->size() &&
+        !(*ar)->getARFile().attribute()->isWholeArchive())
+      archives.push_back(*ar);
+  }
+
+  ArchiveWorklist worklist(archives);
+  for (size_t idx = 0; idx < archives.size(); ++idx)
+    worklist.addUndefined(idx, m_Module.getNamePool());
+
+  // read the archives in turn until a round includes nothing. A member
+  // included from one archive adds its undefined names to the worklists of
+  // all the archives, so that no armap is scanned again.
+  bool included = true;
+  while (included) {
+    included = false;
+    for (size_t idx = 0; idx < archives.size(); ++idx) {
+      if (includeNeededMembers(pConfig, worklist, idx))
+        included = true;
+    }
+  }
+  clearDecodedMembers();
+  return true;
+}
 
-      // check if we should include this defined symbol
-      Archive::Symbol::Status status =
-          shouldIncludeSymbol(pArchive.getSymbolName(idx));
-      if (Archive::Symbol::Unknown != status)
-        pArchive.setSymbolStatus(idx, status);
+/// includeNeededMembers - include the members needed by the entries in the
+/// worklist of the pIdx-th archive.
+///
+/// The members are included as if the armap were scanned from the start
+/// over and over until a scan includes nothing. Instead of scanning, only
+/// the entries whose names may be undefined are visited, in the same order.
+bool GNUArchiveReader::includeNeededMembers(const LinkerConfig& pConfig,
+                                            ArchiveWorklist& pWorklist,
+                                            size_t pIdx) {
+  Archive& archive = pWorklist.archive(pIdx);
+  ArchiveWorklist::Worklist& worklist = pWorklist.worklist(pIdx);
+
+  size_t scan_pos = 0;
+  bool included = false;
+  bool willSymResolved = false;
+  decodeCandidates(pWorklist, pIdx);
+  while (true) {
+    ArchiveWorklist::Worklist::iterator next = worklist.lower_bound(scan_pos);
+    if (next == worklist.end()) {
+      // end of a scan, start another one if this one included a member
+      if (!willSymResolved)
+        break;
+      scan_pos = 0;
+      willSymResolved = false;
+      decodeCandidates(pWorklist, pIdx);
+      continue;
+    }
+    size_t idx = *next;
+    worklist.erase(next);
+    scan_pos = idx + 1;
 
-      if (Archive::Symbol::Include == status) {
-        // include the object member from the given offset
-        includeMember(pConfig, pArchive, pArchive.getObjFileOffset(idx));
-        willSymResolved = true;
-      }  // end of if
-    }    // end of for
-  } while (willSymResolved);
+    // bypass if we already decided to include this symbol or not
+    if (Archive::Symbol::Unknown != archive.getSymbolStatus(idx))
+      continue;
 
-  return true;
+    // bypass if another symbol with the same object file offset is included
+    uint32_t file_offset = archive.getObjFileOffset(idx);
+    if (archive.hasObjectMember(file_offset)) {
+      archive.setSymbolStatus(idx, Archive::Symbol::Include);
+      continue;
+    }
+
+    // check if we should include this defined symbol
+    Archive::Symbol::Status status =
+        shouldIncludeSymbol(archive.getSymbolName(idx));
+    if (Archive::Symbol::Unknown != status)
+      archive.setSymbolStatus(idx, status);
+
+    if (Archive::Symbol::Include != status)
+      continue;
+
+    // include the object member from the given offset, and visit the
+    // entries of the names it refers but does not define
+    includeMember(pConfig, archive, file_offset);
+    willSymResolved = true;
+    included = true;
+
+    Input* member = archive.getObjectMember(file_offset);
+    if (member != NULL)
+      pWorklist.addReferred(*member);
+  }
+  return included;
 }
 
 /// readMemberHeader - read the header of a member in a archive file and then
@@ -387,6 +605,15 @@ size_t GNUArchiveReader::includeMember(const LinkerConfig& pConfig,
         member->setNoExport();
       }
       pArchive.addObjectMember(pFileOffset, parent->lastPos);
+
+      // hand the symbol table decoded ahead over to readSymbols()
+      DecodedMembers::iterator decoded = m_DecodedMembers.find(
+          std::make_pair(&pArchive.getARFile(), pFileOffset));
+      if (decoded != m_DecodedMembers.end()) {
+        m_ELFObjectReader.symbolBuffers()[member] = decoded->second;
+        m_DecodedMembers.erase(decoded);
+      }
+
       m_ELFObjectReader.readHeader(*member);
       m_ELFObjectReader.readSections(*member);
       m_ELFObjectReader.readSymbols(*member);
@@ -433,6 +660,25 @@ bool GNUArchiveReader::includeAllMembers(const LinkerConfig& pConfig,
         sizeof(Archive::MemberHeader) + pArchive.getStrTable().size();
   }
   uint32_t end_offset = pArchive.getARFile().memArea()->size();
+
+  // all the members are included, so decode them ahead at once
+  if (!isThinAR && getThreadPool() != NULL) {
+    std::vector<uint32_t> offsets;
+    for (uint32_t offset = begin_offset; offset < end_offset;) {
+      llvm::StringRef header_region = pArchive.getARFile().memArea()->request(
+          pArchive.getARFile().fileOffset() + offset,
+          sizeof(Archive::MemberHeader));
+      const Archive::MemberHeader* header =
+          reinterpret_cast<const Archive::MemberHeader*>(
+              header_region.begin());
+      offsets.push_back(offset);
+      offset += sizeof(Archive::MemberHeader) + atoi(header->size);
+      if ((offset & 1) != 0x0)
+        ++offset;
+    }
+    decodeMembers(pArchive, offsets);
+  }
+
   for (uint32_t offset = begin_offset; offset < end_offset;
        offset += sizeof(Archive::MemberHeader)) {
     size_t size = includeMember(pConfig, pArchive, offset);
@@ -444,7 +690,83 @@ bool GNUArchiveReader::includeAllMembers(const LinkerConfig& pConfig,
     if ((offset & 1) != 0x0)
       ++offset;
   }
+  clearDecodedMembers();
   return true;
 }
 
+void GNUArchiveReader::decodeMembers(Archive& pArchive,
+                                     const std::vector<uint32_t>& pOffsets) {
+  Input& ar_file = pArchive.getARFile();
+  if (getThreadPool() == NULL || pOffsets.size() < 2 ||
+      isThinArchive(ar_file))
+    return;
+
+  // each task owns its buffer, and a byte per task tells whether it is used.
+  // The global names are interned as in ObjectLinker::decodeInputs().
+  std::vector<SymbolBuffer*> buffers(pOffsets.size());
+  for (size_t i = 0; i < pOffsets.size(); ++i)
+    buffers[i] = new SymbolBuffer();
+
+  NamePool& name_pool = m_Module.getNamePool();
+  std::vector<uint8_t> decoded(pOffsets.size(), 0);
+  getThreadPool()->parallelFor(0, pOffsets.size(), [&](size_t pIdx) {
+    // a view of the member as getMemberFile() creates it. The real input is
+    // created by includeMember(), since the InputFactory is not thread-safe.
+    Input member(ar_file.name(), ar_file.path(), Input::Unknown,
+                 pOffsets[pIdx] + sizeof(Archive::MemberHeader));
+    member.setMemArea(ar_file.memArea());
+    decoded[pIdx] = m_ELFObjectReader.decodeSymbols(member, *buffers[pIdx]);
+    if (!decoded[pIdx])
+      return;
+    SymbolBuffer::const_iterator entry, enEnd = buffers[pIdx]->end();
+    for (entry = buffers[pIdx]->begin(); entry != enEnd; ++entry) {
+      if ((entry->info >> 4) != llvm::ELF::STB_LOCAL && !entry->name.empty())
+        name_pool.intern(entry->name);
+    }
+  });
+
+  for (size_t i = 0; i < pOffsets.size(); ++i) {
+    if (decoded[i])
+      m_DecodedMembers[std::make_pair(&ar_file, pOffsets[i])] = buffers[i];
+    else
+      delete buffers[i];
+  }
+}
+
+/// decodeCandidates - the members of the unknown entries whose names are
+/// undefined now are decoded. An earlier member of the same scan may define
+/// such a name, in which case the buffer is released unused.
+void GNUArchiveReader::decodeCandidates(ArchiveWorklist& pWorklist,
+                                        size_t pIdx) {
+  if (getThreadPool() == NULL)
+    return;
+
+  Archive& archive = pWorklist.archive(pIdx);
+  const Input* ar_file = &archive.getARFile();
+  std::set<uint32_t> candidates;
+  ArchiveWorklist::Worklist::const_iterator idx,
+      idxEnd = pWorklist.worklist(pIdx).end();
+  for (idx = pWorklist.worklist(pIdx).begin(); idx != idxEnd; ++idx) {
+    if (Archive::Symbol::Unknown != archive.getSymbolStatus(*idx))
+      continue;
+    uint32_t file_offset = archive.getObjFileOffset(*idx);
+    if (archive.hasObjectMember(file_offset) ||
+        m_DecodedMembers.count(std::make_pair(ar_file, file_offset)) != 0)
+      continue;
+    if (Archive::Symbol::Include ==
+        shouldIncludeSymbol(archive.getSymbolName(*idx)))
+      candidates.insert(file_offset);
+  }
+
+  std::vector<uint32_t> offsets(candidates.begin(), candidates.end());
+  decodeMembers(archive, offsets);
+}
+
+void GNUArchiveReader::clearDecodedMembers() {
+  DecodedMembers::iterator member, memEnd = m_DecodedMembers.end();
+  for (member = m_DecodedMembers.begin(); member != memEnd; ++member)
+    delete member->second;
+  m_DecodedMembers.clear();
+}
+
 }  // namespace mcld
@@ -20,6 +20,7 @@
 #include "mcld/LinkerScript.h"
 #include "mcld/Module.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/TargetLDBackend.h"
 
 #include <llvm/Support/Casting.h>
@@ -105,6 +106,7 @@ GarbageCollection::~GarbageCollection() {
 }
 
 bool GarbageCollection::run() {
+  TimeTrace::Scope trace("gcSections");
   // 1. traverse all the relocations to set up the reached sections of each
   // section
   setUpReachedSections();
@@ -207,7 +209,7 @@ void GarbageCollection::getEntrySections(SectionVecTy& pEntry) {
         info_end = m_Module.getNamePool().syminfo_end();
     for (info_it = m_Module.getNamePool().syminfo_begin(); info_it != info_end;
          ++info_it) {
-      ResolveInfo* info = info_it.getEntry();
+      ResolveInfo* info = *info_it;
       if (!info->isDefine() || info->isLocal() ||
           info->shouldForceLocal(m_Config))
         continue;
@@ -229,10 +231,15 @@ void GarbageCollection::getEntrySections(SectionVecTy& pEntry) {
   if (LinkerConfig::Exec == m_Config.codeGenType() ||
       m_Config.options().isPIE()) {
     // 1. the entry symbol is the entry
-    LDSymbol* entry_sym =
-        m_Module.getNamePool().findSymbol(m_Backend.getEntry(m_Module));
+    llvm::StringRef entry_name = m_Backend.getEntry(m_Module);
+    m_Module.getNamePool().import(entry_name);
+    LDSymbol* entry_sym = m_Module.getNamePool().findSymbol(entry_name);
     assert(entry_sym != NULL);
-    pEntry.push_back(&entry_sym->fragRef()->frag()->getParent()->getSection());
+    // the entry defined by a shared object has no section to keep
+    if (entry_sym->hasFragRef()) {
+      pEntry.push_back(
+          &entry_sym->fragRef()->frag()->getParent()->getSection());
+    }
 
     // 2. the symbols have been seen in dynamic objects are entries. If
     // --export-dynamic is set, then these sections already been added. No need
@@ -242,7 +249,7 @@ void GarbageCollection::getEntrySections(SectionVecTy& pEntry) {
           info_end = m_Module.getNamePool().syminfo_end();
       for (info_it = m_Module.getNamePool().syminfo_begin();
            info_it != info_end; ++info_it) {
-        ResolveInfo* info = info_it.getEntry();
+        ResolveInfo* info = *info_it;
         if (!info->isDefine() || info->isLocal())
           continue;
 
@@ -270,6 +277,7 @@ void GarbageCollection::getEntrySections(SectionVecTy& pEntry) {
   GeneralOptions::const_undef_sym_iterator usymEnd =
       m_Config.options().undef_sym_end();
   for (usym = m_Config.options().undef_sym_begin(); usym != usymEnd; ++usym) {
+    m_Module.getNamePool().import(*usym);
     LDSymbol* sym = m_Module.getNamePool().findSymbol(*usym);
     assert(sym);
     ResolveInfo* info = sym->resolveInfo();
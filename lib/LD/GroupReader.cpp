@@ -40,8 +40,6 @@ bool GroupReader::readGroup(Module::input_iterator pRoot,
                             const LinkerConfig& pConfig) {
   // record the number of total objects included in this sub-tree
   size_t cur_obj_cnt = 0;
-  size_t last_obj_cnt = 0;
-  size_t non_ar_obj_cnt = 0;
 
   // record the archive files in this sub-tree
   typedef std::vector<ArchiveListEntry*> ArchiveListType;
@@ -94,7 +92,6 @@ bool GroupReader::readGroup(Module::input_iterator pRoot,
       m_ObjectReader.readSymbols(**input);
       m_Module.getObjectList().push_back(*input);
       ++cur_obj_cnt;
-      ++non_ar_obj_cnt;
     } else if (doContinue && m_DynObjReader.isMyFormat(**input, doContinue)) {
       // is a shared object file
       (*input)->setType(Input::DynObj);
@@ -108,21 +105,16 @@ bool GroupReader::readGroup(Module::input_iterator pRoot,
     ++input;
   }
 
-  // after read in all the archives, traverse the archive list in a loop until
-  // there is no unresolved symbols added
+  // after read in all the archives, read them again in a loop until there is
+  // no unresolved symbols added. As before, they are not read again if no
+  // object is included so far.
   ArchiveListType::iterator it = ar_list.begin();
   ArchiveListType::iterator end = ar_list.end();
-  while (cur_obj_cnt != last_obj_cnt) {
-    last_obj_cnt = cur_obj_cnt;
-    cur_obj_cnt = non_ar_obj_cnt;
-    for (it = ar_list.begin(); it != end; ++it) {
-      Archive& ar = (*it)->archive;
-      // if --whole-archive is given to this archive, no need to read it again
-      if (ar.getARFile().attribute()->isWholeArchive())
-        continue;
-      m_ArchiveReader.readArchive(pConfig, ar);
-      cur_obj_cnt += ar.numOfObjectMember();
-    }
+  if (cur_obj_cnt != 0) {
+    std::vector<Archive*> archives;
+    for (it = ar_list.begin(); it != end; ++it)
+      archives.push_back(&(*it)->archive);
+    m_ArchiveReader.readArchives(pConfig, archives);
   }
 
   // after all needed member included, merge the archive sub-tree to main
@@ -21,6 +21,7 @@
 #include "mcld/MC/Input.h"
 #include "mcld/Support/Demangle.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
@@ -52,6 +53,7 @@ IdenticalCodeFolding::IdenticalCodeFolding(const LinkerConfig& pConfig,
 }
 
 void IdenticalCodeFolding::foldIdenticalCode() {
+  TimeTrace::Scope trace("icf");
   // 1. Find folding candidates.
   FoldingCandidates candidate_list;
   findCandidates(candidate_list);
@@ -65,6 +67,7 @@ void IdenticalCodeFolding::foldIdenticalCode() {
   bool converged = false;
   size_t iterations = 0;
   while (!converged && (iterations < m_Config.options().getICFIterations())) {
+    TimeTrace::Scope iteration("icfIteration");
     converged = matchCandidates(candidate_list);
     ++iterations;
   }
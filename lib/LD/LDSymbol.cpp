@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/LDSymbol.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Config/Config.h"
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/Fragment/NullFragment.h"
@@ -23,7 +24,7 @@ typedef GCFactory<LDSymbol, MCLD_SYMBOLS_PER_INPUT> LDSymbolFactory;
 
 static llvm::ManagedStatic<LDSymbol> g_NullSymbol;
 static llvm::ManagedStatic<NullFragment> g_NullSymbolFragment;
-static llvm::ManagedStatic<LDSymbolFactory> g_LDSymbolFactory;
+static LinkStatic<LDSymbolFactory> g_LDSymbolFactory;
 
 //===----------------------------------------------------------------------===//
 // LDSymbol
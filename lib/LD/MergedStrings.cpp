@@ -0,0 +1,312 @@
+//===- MergedStrings.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/MergedStrings.h"
+
+#include "mcld/Support/ThreadPool.h"
+
+#include <llvm/ADT/Hashing.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mcld {
+
+/// the number of shards of the pieces when they are merged on threads. The
+/// shard of a piece is chosen by the high bits of its hash, and its slot in
+/// the table of the shard by the low bits.
+static const unsigned int NumOfShards = 32;
+static const uint32_t EmptySlot = ~static_cast<uint32_t>(0);
+
+/// forEach - run pTask(i) for every i in [0, pSize), on pThreadPool if any
+static void forEach(ThreadPool* pThreadPool,
+                    size_t pSize,
+                    const ThreadPool::IndexedTask& pTask) {
+  if (pThreadPool != NULL) {
+    pThreadPool->parallelFor(0, pSize, pTask);
+    return;
+  }
+  for (size_t i = 0; i < pSize; ++i)
+    pTask(i);
+}
+
+/// isSameRecord - compare two constants of pSize bytes. The usual sizes are
+/// compared in 8-byte words, which the compiler turns into vector compares.
+static bool isSameRecord(const char* pA, const char* pB, uint32_t pSize) {
+  switch (pSize) {
+    case 4:
+    case 8:
+    case 16:
+    case 32: {
+      uint64_t a[4] = {0, 0, 0, 0}, b[4] = {0, 0, 0, 0};
+      std::memcpy(a, pA, pSize);
+      std::memcpy(b, pB, pSize);
+      return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3])) ==
+             0;
+    }
+    default:
+      return std::memcmp(pA, pB, pSize) == 0;
+  }
+}
+
+/// isTailBefore - the order of the pieces for tail merging. The strings are
+/// compared from their ends, in the descending order, so that a string comes
+/// right after a string which ends with it.
+static bool isTailBefore(llvm::StringRef pA, llvm::StringRef pB) {
+  size_t size = std::min(pA.size(), pB.size());
+  for (size_t n = 1; n <= size; ++n) {
+    unsigned char a = pA[pA.size() - n];
+    unsigned char b = pB[pB.size() - n];
+    if (a != b)
+      return a > b;
+  }
+  return pA.size() > pB.size();
+}
+
+//===----------------------------------------------------------------------===//
+// MergedStrings
+//===----------------------------------------------------------------------===//
+MergedStrings::MergedStrings(uint32_t pEntSize, uint32_t pAlign, bool pStrings)
+    : m_EntSize(pEntSize),
+      m_Align(pAlign > 1 ? pAlign : 1),
+      m_Size(0),
+      m_bStrings(pStrings) {
+  assert(m_EntSize != 0 && "the pieces must have a size");
+}
+
+bool MergedStrings::canMerge(llvm::StringRef pContents,
+                             uint32_t pEntSize,
+                             bool pStrings) {
+  if (pEntSize == 0 || (pContents.size() % pEntSize) != 0 ||
+      pContents.size() > static_cast<uint64_t>(EmptySlot))
+    return false;
+
+  if (!pStrings)
+    return true;
+
+  // the last string must be terminated
+  for (size_t n = 1; n <= pEntSize && n <= pContents.size(); ++n) {
+    if (pContents[pContents.size() - n] != '\0')
+      return false;
+  }
+  return true;
+}
+
+unsigned int MergedStrings::addSection(llvm::StringRef pContents) {
+  assert(canMerge(pContents, m_EntSize, m_bStrings));
+  m_Sections.push_back(pContents);
+  return m_Sections.size() - 1;
+}
+
+llvm::StringRef MergedStrings::getString(const Piece& pPiece) const {
+  return llvm::StringRef(pPiece.data, pPiece.size);
+}
+
+bool MergedStrings::isSame(const Piece& pA, const Piece& pB) const {
+  if (!m_bStrings)
+    return isSameRecord(pA.data, pB.data, m_EntSize);
+  return getString(pA) == getString(pB);
+}
+
+void MergedStrings::split(llvm::StringRef pContents, PieceList& pPieces) const {
+  size_t offset = 0;
+  while (offset < pContents.size()) {
+    // find the terminator of a string, which canMerge() has made sure of. A
+    // constant is a piece of one entry.
+    size_t end = offset;
+    if (m_bStrings && m_EntSize == 1) {
+      end = pContents.find('\0', offset);
+    } else if (m_bStrings) {
+      while (true) {
+        bool zero = true;
+        for (uint32_t n = 0; n < m_EntSize && zero; ++n)
+          zero = (pContents[end + n] == '\0');
+        if (zero)
+          break;
+        end += m_EntSize;
+      }
+    }
+
+    Piece piece;
+    piece.outputOffset = 0;
+    piece.data = pContents.data() + offset;
+    piece.size = end + m_EntSize - offset;
+    piece.hash = llvm::hash_value(getString(piece));
+    piece.leader = 0;
+    pPieces.push_back(piece);
+    offset = end + m_EntSize;
+  }
+}
+
+void MergedStrings::findLeaders(unsigned int pShard,
+                                unsigned int pNumOfShards) {
+  // an open addressing table of the leaders of this shard
+  std::vector<uint32_t> table(64, EmptySlot);
+  size_t count = 0;
+  for (uint32_t idx = 0; idx < m_Pieces.size(); ++idx) {
+    Piece& piece = m_Pieces[idx];
+    if (((piece.hash >> 24) % pNumOfShards) != pShard)
+      continue;
+
+    if (2 * (count + 1) > table.size()) {
+      std::vector<uint32_t> larger(2 * table.size(), EmptySlot);
+      size_t mask = larger.size() - 1;
+      for (size_t n = 0; n < table.size(); ++n) {
+        if (table[n] == EmptySlot)
+          continue;
+        size_t slot = m_Pieces[table[n]].hash & mask;
+        while (larger[slot] != EmptySlot)
+          slot = (slot + 1) & mask;
+        larger[slot] = table[n];
+      }
+      table.swap(larger);
+    }
+
+    size_t mask = table.size() - 1;
+    for (size_t slot = piece.hash & mask;; slot = (slot + 1) & mask) {
+      if (table[slot] == EmptySlot) {
+        table[slot] = idx;
+        piece.leader = idx;
+        ++count;
+        break;
+      }
+      const Piece& other = m_Pieces[table[slot]];
+      if (other.hash == piece.hash && isSame(other, piece)) {
+        piece.leader = table[slot];
+        break;
+      }
+    }
+  }
+}
+
+void MergedStrings::assignOffsets(bool pTailMerge) {
+  // the leader that a leader is kept in the end of, or itself
+  std::vector<uint32_t> parents;
+  std::vector<uint32_t> tails;
+  pTailMerge = pTailMerge && m_bStrings;
+  if (pTailMerge) {
+    parents.resize(m_Pieces.size());
+    for (uint32_t idx = 0; idx < m_Pieces.size(); ++idx) {
+      parents[idx] = idx;
+      if (m_Pieces[idx].leader == idx)
+        tails.push_back(idx);
+    }
+
+    std::sort(tails.begin(), tails.end(), [this](uint32_t pA, uint32_t pB) {
+      return isTailBefore(getString(m_Pieces[pA]), getString(m_Pieces[pB]));
+    });
+
+    // a string can only be kept at an aligned offset of the previous one
+    for (size_t n = 1; n < tails.size(); ++n) {
+      llvm::StringRef prev = getString(m_Pieces[tails[n - 1]]);
+      llvm::StringRef str = getString(m_Pieces[tails[n]]);
+      if (prev.endswith(str) && ((prev.size() - str.size()) % m_Align) == 0)
+        parents[tails[n]] = tails[n - 1];
+    }
+  }
+
+  // the other leaders are placed in the order of the sections
+  uint64_t offset = 0;
+  for (uint32_t idx = 0; idx < m_Pieces.size(); ++idx) {
+    Piece& piece = m_Pieces[idx];
+    if (piece.leader != idx || (pTailMerge && parents[idx] != idx))
+      continue;
+    offset = (offset + m_Align - 1) / m_Align * m_Align;
+    piece.outputOffset = offset;
+    offset += piece.size;
+  }
+  m_Size = offset;
+
+  // a parent comes before its tails
+  for (size_t n = 0; n < tails.size(); ++n) {
+    Piece& piece = m_Pieces[tails[n]];
+    const Piece& parent = m_Pieces[parents[tails[n]]];
+    if (&piece != &parent)
+      piece.outputOffset = parent.outputOffset + (parent.size - piece.size);
+  }
+}
+
+void MergedStrings::finalize(ThreadPool* pThreadPool, bool pTailMerge) {
+  // split the sections into pieces
+  std::vector<PieceList> pieces(m_Sections.size());
+  forEach(pThreadPool, m_Sections.size(), [&](size_t pIdx) {
+    split(m_Sections[pIdx], pieces[pIdx]);
+  });
+
+  m_SectionBegins.resize(m_Sections.size() + 1);
+  size_t count = 0;
+  for (size_t sect = 0; sect < pieces.size(); ++sect) {
+    m_SectionBegins[sect] = count;
+    count += pieces[sect].size();
+  }
+  m_SectionBegins[pieces.size()] = count;
+
+  m_Pieces.reserve(count);
+  for (size_t sect = 0; sect < pieces.size(); ++sect) {
+    m_Pieces.insert(m_Pieces.end(), pieces[sect].begin(), pieces[sect].end());
+    PieceList().swap(pieces[sect]);
+  }
+
+  // find the first of the same pieces, one shard per task
+  unsigned int shards = (pThreadPool != NULL) ? NumOfShards : 1;
+  forEach(pThreadPool, shards, [&](size_t pShard) {
+    findLeaders(pShard, shards);
+  });
+
+  assignOffsets(pTailMerge);
+
+  // the other pieces share the offsets of their leaders
+  forEach(pThreadPool, m_Sections.size(), [&](size_t pIdx) {
+    for (uint32_t idx = m_SectionBegins[pIdx]; idx < m_SectionBegins[pIdx + 1];
+         ++idx) {
+      Piece& piece = m_Pieces[idx];
+      if (piece.leader != idx)
+        piece.outputOffset = m_Pieces[piece.leader].outputOffset;
+    }
+  });
+}
+
+uint64_t MergedStrings::getOutputOffset(unsigned int pSection,
+                                        uint64_t pOffset) const {
+  assert(pSection < m_Sections.size() && "no such section");
+  const Piece* begin = m_Pieces.data() + m_SectionBegins[pSection];
+  const Piece* end = m_Pieces.data() + m_SectionBegins[pSection + 1];
+  if (begin == end)
+    return 0;
+
+  // the last piece starting at or before the offset
+  const char* pos = m_Sections[pSection].data() + pOffset;
+  const Piece* piece =
+      std::upper_bound(begin, end, pos, [](const char* pPos, const Piece& pP) {
+        return pPos < pP.data;
+      });
+  if (piece != begin)
+    --piece;
+  return piece->outputOffset + (pos - piece->data);
+}
+
+void MergedStrings::emit(char* pBuffer) const {
+  std::memset(pBuffer, 0, m_Size);
+  for (uint32_t idx = 0; idx < m_Pieces.size(); ++idx) {
+    const Piece& piece = m_Pieces[idx];
+    if (piece.leader == idx)
+      std::memcpy(pBuffer + piece.outputOffset, piece.data, piece.size);
+  }
+}
+
+llvm::StringRef MergedStrings::getContents() {
+  if (m_Contents.size() != m_Size) {
+    m_Contents.resize(m_Size);
+    if (m_Size != 0)
+      emit(m_Contents.data());
+  }
+  return llvm::StringRef(m_Contents.data(), m_Size);
+}
+
+}  // namespace mcld
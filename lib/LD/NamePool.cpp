@@ -18,16 +18,18 @@ namespace mcld {
 // NamePool
 //===----------------------------------------------------------------------===//
 NamePool::NamePool(NamePool::size_type pSize)
-    : m_pResolver(new StaticResolver()), m_Table(pSize) {
+    : m_pResolver(new StaticResolver()), m_pImporter(NULL) {
+  for (unsigned int i = 0; i < NumOfShards; ++i)
+    m_Shards[i] = new Shard(pSize / NumOfShards);
 }
 
 NamePool::~NamePool() {
   delete m_pResolver;
 
-  FreeInfoSet::iterator info, iEnd = m_FreeInfoSet.end();
-  for (info = m_FreeInfoSet.begin(); info != iEnd; ++info) {
-    ResolveInfo::Destroy(*info);
-  }
+  for (unsigned int i = 0; i < NumOfShards; ++i)
+    delete m_Shards[i];
+
+  // the ResolveInfo in m_FreeInfoSet are released with m_FreeInfoAllocator
 }
 
 /// createSymbol - create a symbol
@@ -37,9 +39,13 @@ ResolveInfo* NamePool::createSymbol(const llvm::StringRef& pName,
                                     ResolveInfo::Desc pDesc,
                                     ResolveInfo::Binding pBinding,
                                     ResolveInfo::SizeType pSize,
-                                    ResolveInfo::Visibility pVisibility) {
+                                    ResolveInfo::Visibility pVisibility,
+                                    bool pReferName) {
   ResolveInfo** result = m_FreeInfoSet.allocate();
-  (*result) = ResolveInfo::Create(pName);
+  if (pReferName)
+    (*result) = ResolveInfo::CreateRef(pName, m_FreeInfoAllocator);
+  else
+    (*result) = ResolveInfo::Create(pName, m_FreeInfoAllocator);
   (*result)->setIsSymbol(true);
   (*result)->setSource(pIsDyn);
   (*result)->setType(pType);
@@ -62,19 +68,34 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
                             LDSymbol::ValueType pValue,
                             ResolveInfo::Visibility pVisibility,
                             ResolveInfo* pOldInfo,
-                            Resolver::Result& pResult) {
+                            Resolver::Result& pResult,
+                            bool pReferName) {
+  // the symbols read on demand come first, as if they had been read in full
+  unsigned int hash = hashOf(pName);
+  if (m_pImporter != NULL) {
+    ResolveInfo* info = findName(pName, hash);
+    if (info == NULL || !info->isSymbol())
+      m_pImporter->import(pName);
+  }
+
   // We should check if there is any symbol with the same name existed.
   // If it already exists, we should use resolver to decide which symbol
   // should be reserved. Otherwise, we insert the symbol and set up its
   // attributes.
   bool exist = false;
-  ResolveInfo* old_symbol = m_Table.insert(pName, exist);
+  ResolveInfo* old_symbol = insertName(pName, hash, pReferName, exist);
+  // a duplicate is described by a temporary on the stack, which shares the
+  // name of the existing symbol
+  ResolveInfo duplicate;
   ResolveInfo* new_symbol = NULL;
   if (exist && old_symbol->isSymbol()) {
-    new_symbol = m_Table.getEntryFactory().produce(pName);
+    duplicate.setName(
+        llvm::StringRef(old_symbol->name(), old_symbol->nameSize()));
+    new_symbol = &duplicate;
   } else {
     exist = false;
     new_symbol = old_symbol;
+    m_Symbols.push_back(new_symbol);
   }
 
   new_symbol->setIsSymbol(true);
@@ -107,35 +128,77 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
   } else {
     m_pResolver->resolveAgain(*this, action, *old_symbol, *new_symbol, pResult);
   }
-
-  m_Table.getEntryFactory().destroy(new_symbol);
   return;
 }
 
+/// intern - insert pName into its shard without making it a symbol
+void NamePool::intern(const llvm::StringRef& pName) {
+  bool exist = false;
+  insertName(pName, hashOf(pName), true, exist);
+}
+
+/// import - the importer is not asked again once pName is a symbol
+void NamePool::import(const llvm::StringRef& pName) {
+  if (m_pImporter != NULL && findInfo(pName) == NULL)
+    m_pImporter->import(pName);
+}
+
 llvm::StringRef NamePool::insertString(const llvm::StringRef& pString) {
   bool exist = false;
-  ResolveInfo* resolve_info = m_Table.insert(pString, exist);
+  ResolveInfo* resolve_info =
+      insertName(pString, hashOf(pString), false, exist);
   return llvm::StringRef(resolve_info->name(), resolve_info->nameSize());
 }
 
 void NamePool::reserve(NamePool::size_type pSize) {
-  m_Table.rehash(pSize);
+  // the names are spread evenly, leave some room for the unlucky shards
+  size_type per_shard = pSize / NumOfShards;
+  per_shard += per_shard / 8;
+  for (unsigned int i = 0; i < NumOfShards; ++i)
+    m_Shards[i]->table.reserve(per_shard);
 }
 
 NamePool::size_type NamePool::capacity() const {
-  return (m_Table.numOfBuckets() - m_Table.numOfEntries());
+  size_type result = 0;
+  for (unsigned int i = 0; i < NumOfShards; ++i)
+    result += m_Shards[i]->table.numOfBuckets() -
+              m_Shards[i]->table.numOfEntries();
+  return result;
 }
 
-/// findInfo - find the resolved ResolveInfo
+ResolveInfo* NamePool::insertName(const llvm::StringRef& pName,
+                                  unsigned int pHash,
+                                  bool pReferName,
+                                  bool& pExist) {
+  Shard& shard = shardOf(pHash);
+  std::lock_guard<std::mutex> guard(shard.lock);
+  shard.table.getEntryFactory().setReferName(pReferName);
+  ResolveInfo* info = shard.table.insert(pName, pHash, pExist);
+  shard.table.getEntryFactory().setReferName(false);
+  return info;
+}
+
+ResolveInfo* NamePool::findName(const llvm::StringRef& pName,
+                                unsigned int pHash) const {
+  const Shard& shard = shardOf(pHash);
+  return const_cast<ResolveInfo*>(shard.table.find(pName, pHash).getEntry());
+}
+
+/// findInfo - find the resolved ResolveInfo. The names interned but not
+/// inserted as symbols yet are not found.
 ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName) {
-  Table::iterator iter = m_Table.find(pName);
-  return iter.getEntry();
+  ResolveInfo* info = findName(pName, hashOf(pName));
+  if (info == NULL || !info->isSymbol())
+    return NULL;
+  return info;
 }
 
 /// findInfo - find the resolved ResolveInfo
 const ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName) const {
-  Table::const_iterator iter = m_Table.find(pName);
-  return iter.getEntry();
+  const ResolveInfo* info = findName(pName, hashOf(pName));
+  if (info == NULL || !info->isSymbol())
+    return NULL;
+  return info;
 }
 
 /// findSymbol - find the resolved output LDSymbol
@@ -12,7 +12,7 @@ namespace mcld {
 
 //==========================
 // ObjectWriter
-ObjectWriter::ObjectWriter() {
+ObjectWriter::ObjectWriter() : m_pThreadPool(NULL) {
 }
 
 ObjectWriter::~ObjectWriter() {
@@ -8,15 +8,14 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/RelocData.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 namespace mcld {
 
 typedef GCFactory<RelocData, MCLD_SECTIONS_PER_INPUT> RelocDataFactory;
 
-static llvm::ManagedStatic<RelocDataFactory> g_RelocDataFactory;
+static LinkStatic<RelocDataFactory> g_RelocDataFactory;
 
 //===----------------------------------------------------------------------===//
 // RelocData
@@ -28,6 +28,35 @@ namespace mcld {
 Relocator::~Relocator() {
 }
 
+void Relocator::issueResult(const Relocation& pReloc, Result pResult) const {
+  switch (pResult) {
+    case Relocator::OK: {
+      // do nothing
+      return;
+    }
+    case Relocator::Overflow: {
+      error(diag::result_overflow) << getName(pReloc.type())
+                                   << pReloc.symInfo()->name();
+      return;
+    }
+    case Relocator::BadReloc: {
+      error(diag::result_badreloc) << getName(pReloc.type())
+                                   << pReloc.symInfo()->name();
+      return;
+    }
+    case Relocator::Unsupported: {
+      fatal(diag::unsupported_relocation) << pReloc.type()
+                                          << "mclinker@googlegroups.com";
+      return;
+    }
+    case Relocator::Unknown: {
+      fatal(diag::unknown_relocation) << pReloc.type()
+                                      << pReloc.symInfo()->name();
+      return;
+    }
+  }  // end of switch
+}
+
 void Relocator::partialScanRelocation(Relocation& pReloc,
                                       Module& pModule) {
   // if we meet a section symbol
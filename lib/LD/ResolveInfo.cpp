@@ -9,11 +9,13 @@
 #include "mcld/LD/ResolveInfo.h"
 
 #include "mcld/LinkerConfig.h"
+#include "mcld/ADT/StringHash.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
+#include <cassert>
 #include <cstdlib>
 #include <cstring>
 
@@ -25,8 +27,14 @@ static ResolveInfo* g_NullResolveInfo = NULL;
 //===----------------------------------------------------------------------===//
 // ResolveInfo
 //===----------------------------------------------------------------------===//
-ResolveInfo::ResolveInfo() : m_Size(0), m_BitField(0) {
+ResolveInfo::ResolveInfo()
+    : m_Size(0),
+      m_pName(m_Name),
+      m_BitField(0),
+      m_ELFHash(NoHash),
+      m_GNUHash(0) {
   m_Ptr.sym_ptr = 0;
+  m_Name[0] = '\0';
 }
 
 ResolveInfo::~ResolveInfo() {
@@ -214,7 +222,13 @@ bool ResolveInfo::compare(const ResolveInfo::key_type& pKey) {
   size_t length = nameSize();
   if (length != pKey.size())
     return false;
-  return (std::memcmp(m_Name, pKey.data(), length) == 0);
+  return (std::memcmp(m_pName, pKey.data(), length) == 0);
+}
+
+void ResolveInfo::computeHashes() const {
+  llvm::StringRef name(m_pName, nameSize());
+  m_GNUHash = hash::StringHash<hash::DJB>()(name);
+  m_ELFHash = hash::StringHash<hash::ELF>()(name);
 }
 
 bool ResolveInfo::shouldForceLocal(const LinkerConfig& pConfig) {
@@ -234,19 +248,57 @@ bool ResolveInfo::shouldForceLocal(const LinkerConfig& pConfig) {
 // ResolveInfo Factory Methods
 //===----------------------------------------------------------------------===//
 ResolveInfo* ResolveInfo::Create(const ResolveInfo::key_type& pKey) {
-  ResolveInfo* info =
-      static_cast<ResolveInfo*>(malloc(sizeof(ResolveInfo) + pKey.size() + 1));
-  if (info == NULL)
+  void* storage = malloc(sizeof(ResolveInfo) + pKey.size());
+  if (storage == NULL)
     return NULL;
+  return construct(storage, pKey, true);
+}
+
+ResolveInfo* ResolveInfo::CreateRef(const ResolveInfo::key_type& pKey) {
+  void* storage = malloc(sizeof(ResolveInfo));
+  if (storage == NULL)
+    return NULL;
+  return construct(storage, pKey, false);
+}
+
+ResolveInfo* ResolveInfo::Create(const ResolveInfo::key_type& pKey,
+                                 llvm::BumpPtrAllocator& pAllocator) {
+  void* storage = pAllocator.Allocate(sizeof(ResolveInfo) + pKey.size(),
+                                      alignof(ResolveInfo));
+  return construct(storage, pKey, true);
+}
+
+ResolveInfo* ResolveInfo::CreateRef(const ResolveInfo::key_type& pKey,
+                                    llvm::BumpPtrAllocator& pAllocator) {
+  void* storage =
+      pAllocator.Allocate(sizeof(ResolveInfo), alignof(ResolveInfo));
+  return construct(storage, pKey, false);
+}
 
-  new (info) ResolveInfo();  // call constructor at the `result` address.
+ResolveInfo* ResolveInfo::construct(void* pStorage,
+                                    const ResolveInfo::key_type& pKey,
+                                    bool pCopy) {
+  // call constructor at the `pStorage` address.
+  ResolveInfo* info = new (pStorage) ResolveInfo();
+  if (!pCopy) {
+    info->setName(pKey);
+    return info;
+  }
+
+  // m_Name has room for the terminator
   std::memcpy(info->m_Name, pKey.data(), pKey.size());
   info->m_Name[pKey.size()] = '\0';
-  info->m_BitField &= ~ResolveInfo::RESOLVE_MASK;
-  info->m_BitField |= (pKey.size() << ResolveInfo::NAME_LENGTH_OFFSET);
+  info->setName(llvm::StringRef(info->m_Name, pKey.size()));
   return info;
 }
 
+void ResolveInfo::setName(const ResolveInfo::key_type& pName) {
+  assert(pName.data()[pName.size()] == '\0' && "name is not null-terminated");
+  m_pName = pName.data();
+  m_BitField &= ~ResolveInfo::RESOLVE_MASK;
+  m_BitField |= (pName.size() << ResolveInfo::NAME_LENGTH_OFFSET);
+}
+
 void ResolveInfo::Destroy(ResolveInfo*& pInfo) {
   if (pInfo->isNull())
     return;
@@ -264,7 +316,6 @@ ResolveInfo* ResolveInfo::Null() {
     g_NullResolveInfo =
         static_cast<ResolveInfo*>(malloc(sizeof(ResolveInfo) + 1));
     new (g_NullResolveInfo) ResolveInfo();
-    g_NullResolveInfo->m_Name[0] = '\0';
     g_NullResolveInfo->m_BitField = 0x0;
     g_NullResolveInfo->setBinding(Local);
   }
@@ -8,24 +8,27 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/SectionData.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
+#include <algorithm>
+#include <cassert>
 
 namespace mcld {
 
 typedef GCFactory<SectionData, MCLD_SECTIONS_PER_INPUT> SectDataFactory;
 
-static llvm::ManagedStatic<SectDataFactory> g_SectDataFactory;
+static LinkStatic<SectDataFactory> g_SectDataFactory;
 
 //===----------------------------------------------------------------------===//
 // SectionData
 //===----------------------------------------------------------------------===//
-SectionData::SectionData() : m_pSection(NULL) {
+SectionData::SectionData() : m_pSection(NULL), m_bIndexValid(false) {
 }
 
-SectionData::SectionData(LDSection& pSection) : m_pSection(&pSection) {
+SectionData::SectionData(LDSection& pSection)
+    : m_pSection(&pSection), m_bIndexValid(false) {
 }
 
 SectionData* SectionData::Create(LDSection& pSection) {
@@ -44,4 +47,54 @@ void SectionData::Clear() {
   g_SectDataFactory->clear();
 }
 
+Fragment* SectionData::findFragment(const Fragment& pFrag,
+                                    uint64_t pOffset,
+                                    uint64_t& pFragOffset) {
+  if (!m_bIndexValid)
+    buildIndex();
+
+  llvm::DenseMap<const Fragment*, size_t>::const_iterator position =
+      m_FragmentPositions.find(&pFrag);
+  assert(position != m_FragmentPositions.end() &&
+         "the fragment is not in this section");
+  size_t first = position->second;
+  uint64_t target = pOffset;
+  if (first != 0)
+    target += m_FragmentEnds[first - 1];
+
+  // the first fragment from pFrag on which ends at or after the target
+  std::vector<uint64_t>::const_iterator end = std::lower_bound(
+      m_FragmentEnds.begin() + first, m_FragmentEnds.end(), target);
+  if (end == m_FragmentEnds.end())
+    return NULL;
+
+  size_t idx = end - m_FragmentEnds.begin();
+  uint64_t start = (idx == 0) ? 0 : m_FragmentEnds[idx - 1];
+  if (*end == target && *end != start) {
+    pFragOffset = 0;
+    if (idx + 1 == m_IndexedFragments.size())
+      return NULL;
+    return m_IndexedFragments[idx + 1];
+  }
+
+  pFragOffset = target - start;
+  return m_IndexedFragments[idx];
+}
+
+void SectionData::buildIndex() {
+  m_IndexedFragments.clear();
+  m_FragmentEnds.clear();
+  m_FragmentPositions.clear();
+
+  uint64_t offset = 0;
+  iterator frag, fragEnd = m_Fragments.end();
+  for (frag = m_Fragments.begin(); frag != fragEnd; ++frag) {
+    offset += frag->size();
+    m_FragmentPositions[&*frag] = m_IndexedFragments.size();
+    m_IndexedFragments.push_back(&*frag);
+    m_FragmentEnds.push_back(offset);
+  }
+  m_bIndexValid = true;
+}
+
 }  // namespace mcld
@@ -0,0 +1,275 @@
+//===- ShlibSymbolCache.cpp -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/ShlibSymbolCache.h"
+
+#include "mcld/ADT/StringHash.h"
+#include "mcld/LD/SymbolBuffer.h"
+#include "mcld/MC/Input.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstring>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace mcld {
+
+static const char CacheMagic[8] = {'M', 'C', 'L', 'D', 'S', 'Y', 'M', 'C'};
+static const uint32_t CacheVersion = 1;
+static const uint32_t CacheByteOrder = 0x01020304;
+
+//===----------------------------------------------------------------------===//
+// ShlibSymbolCache::Header and Entry
+//===----------------------------------------------------------------------===//
+/// Header - the header of a cache file, in host byte order. It is followed
+/// by the key string (the path and the triple, separated by '\0' and padded
+/// to 8 bytes), the entries, and the words of the alias groups.
+struct ShlibSymbolCache::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t device;
+  uint64_t inode;
+  uint64_t size;
+  uint64_t mtime;  // nanoseconds since the epoch
+  uint32_t keySize;
+  uint32_t strtabSize;
+  uint32_t numOfEntries;
+  uint32_t numOfAliasWords;
+};
+
+/// Entry - a SymbolBuffer::Entry whose name is an offset into .dynstr
+struct ShlibSymbolCache::Entry {
+  uint64_t value;
+  uint64_t size;
+  uint32_t name;
+  uint32_t nameSize;
+  uint16_t shndx;
+  uint8_t info;
+  uint8_t other;
+  uint32_t padding;
+};
+
+static size_t alignTo8(size_t pSize) {
+  return (pSize + 7) & ~static_cast<size_t>(7);
+}
+
+//===----------------------------------------------------------------------===//
+// ShlibSymbolCache
+//===----------------------------------------------------------------------===//
+ShlibSymbolCache::ShlibSymbolCache(const std::string& pDirectory,
+                                   const std::string& pTriple)
+    : m_Directory(pDirectory), m_Triple(pTriple) {
+}
+
+bool ShlibSymbolCache::getKey(const Input& pInput, Header& pHeader) const {
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(pInput.path().native(), status))
+    return false;
+
+  std::memcpy(pHeader.magic, CacheMagic, sizeof(CacheMagic));
+  pHeader.version = CacheVersion;
+  pHeader.byteOrder = CacheByteOrder;
+  pHeader.device = status.getUniqueID().getDevice();
+  pHeader.inode = status.getUniqueID().getFile();
+  pHeader.size = status.getSize();
+  llvm::sys::TimeValue mtime = status.getLastModificationTime();
+  pHeader.mtime = static_cast<uint64_t>(mtime.toEpochTime()) * 1000000000ULL +
+                  mtime.nanoseconds();
+  pHeader.keySize = pInput.path().native().size() + 1 + m_Triple.size();
+  return true;
+}
+
+std::string ShlibSymbolCache::getCacheFile(const Input& pInput) const {
+  // the name of the shared object keeps the directory readable, and the
+  // hash of the path and the triple tells the files of the same name apart
+  std::string key = pInput.path().native();
+  key += '\0';
+  key += m_Triple;
+  uint64_t hash =
+      (static_cast<uint64_t>(hash::StringHash<hash::FNV>()(key)) << 32) |
+      hash::StringHash<hash::DJB>()(key);
+
+  llvm::SmallString<256> file(m_Directory);
+  llvm::sys::path::append(file,
+                          llvm::sys::path::filename(pInput.path().native()) +
+                              "-" + llvm::utohexstr(hash) + ".dynsym");
+  return file.str().str();
+}
+
+bool ShlibSymbolCache::load(const Input& pInput,
+                            llvm::StringRef pStrTab,
+                            SymbolBuffer& pBuffer) const {
+  Header key;
+  if (!getKey(pInput, key))
+    return false;
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer_or_error =
+      llvm::MemoryBuffer::getFile(getCacheFile(pInput),
+                                  /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
+  if (!buffer_or_error)
+    return false;
+
+  llvm::StringRef file = buffer_or_error.get()->getBuffer();
+  if (file.size() < sizeof(Header))
+    return false;
+
+  Header header;
+  std::memcpy(&header, file.data(), sizeof(Header));
+  if (std::memcmp(header.magic, key.magic, sizeof(key.magic)) != 0 ||
+      header.version != key.version || header.byteOrder != key.byteOrder ||
+      header.device != key.device || header.inode != key.inode ||
+      header.size != key.size || header.mtime != key.mtime ||
+      header.keySize != key.keySize || header.strtabSize != pStrTab.size())
+    return false;
+
+  size_t key_offset = sizeof(Header);
+  size_t entry_offset = key_offset + alignTo8(header.keySize);
+  size_t alias_offset =
+      entry_offset + static_cast<size_t>(header.numOfEntries) * sizeof(Entry);
+  if (file.size() != alias_offset + static_cast<size_t>(
+                                        header.numOfAliasWords) *
+                                        sizeof(uint32_t))
+    return false;
+
+  llvm::StringRef path = pInput.path().native();
+  llvm::StringRef key_str = file.substr(key_offset, header.keySize);
+  if (key_str.substr(0, path.size()) != path ||
+      key_str[path.size()] != '\0' ||
+      key_str.substr(path.size() + 1) != m_Triple)
+    return false;
+
+  pBuffer.clear();
+  pBuffer.reserve(header.numOfEntries);
+  const char* entries = file.data() + entry_offset;
+  for (uint32_t n = 0; n < header.numOfEntries; ++n) {
+    Entry entry;
+    std::memcpy(&entry, entries + n * sizeof(Entry), sizeof(Entry));
+    if (entry.name > pStrTab.size() ||
+        entry.nameSize > pStrTab.size() - entry.name) {
+      pBuffer.clear();
+      return false;
+    }
+
+    SymbolBuffer::Entry symbol;
+    symbol.name = pStrTab.substr(entry.name, entry.nameSize);
+    symbol.value = entry.value;
+    symbol.size = entry.size;
+    symbol.shndx = entry.shndx;
+    symbol.info = entry.info;
+    symbol.other = entry.other;
+    pBuffer.append(symbol);
+  }
+
+  // check the groups, so that a broken file can not link up wrong symbols
+  SymbolBuffer::AliasList& aliases = pBuffer.aliases();
+  aliases.resize(header.numOfAliasWords);
+  if (header.numOfAliasWords != 0) {
+    std::memcpy(&aliases[0],
+                file.data() + alias_offset,
+                header.numOfAliasWords * sizeof(uint32_t));
+  }
+  for (size_t group = 0; group < aliases.size(); group += aliases[group] + 1) {
+    bool valid = (aliases[group] >= 2 &&
+                  aliases[group] < aliases.size() - group);
+    for (uint32_t n = 1; valid && n <= aliases[group]; ++n)
+      valid = (aliases[group + n] < header.numOfEntries);
+    if (!valid) {
+      pBuffer.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ShlibSymbolCache::store(const Input& pInput,
+                             llvm::StringRef pStrTab,
+                             const SymbolBuffer& pBuffer) const {
+  Header header;
+  if (!getKey(pInput, header))
+    return false;
+  header.strtabSize = pStrTab.size();
+  header.numOfEntries = pBuffer.size();
+  header.numOfAliasWords = pBuffer.aliases().size();
+
+  std::vector<char> file(sizeof(Header) + alignTo8(header.keySize) +
+                             pBuffer.size() * sizeof(Entry) +
+                             pBuffer.aliases().size() * sizeof(uint32_t),
+                         '\0');
+  char* out = &file[0];
+  std::memcpy(out, &header, sizeof(Header));
+  out += sizeof(Header);
+  const std::string& path = pInput.path().native();
+  std::memcpy(out, path.data(), path.size());
+  std::memcpy(out + path.size() + 1, m_Triple.data(), m_Triple.size());
+  out += alignTo8(header.keySize);
+
+  SymbolBuffer::const_iterator symbol, symEnd = pBuffer.end();
+  for (symbol = pBuffer.begin(); symbol != symEnd; ++symbol) {
+    // the names decoded from .dynstr point into it
+    if (symbol->name.data() < pStrTab.begin() ||
+        symbol->name.data() + symbol->name.size() > pStrTab.end())
+      return false;
+
+    Entry entry;
+    std::memset(&entry, 0, sizeof(Entry));
+    entry.value = symbol->value;
+    entry.size = symbol->size;
+    entry.name = symbol->name.data() - pStrTab.begin();
+    entry.nameSize = symbol->name.size();
+    entry.shndx = symbol->shndx;
+    entry.info = symbol->info;
+    entry.other = symbol->other;
+    std::memcpy(out, &entry, sizeof(Entry));
+    out += sizeof(Entry);
+  }
+  if (!pBuffer.aliases().empty()) {
+    std::memcpy(out,
+                &pBuffer.aliases()[0],
+                pBuffer.aliases().size() * sizeof(uint32_t));
+  }
+
+  // write a temporary file in the cache directory and rename it, which
+  // replaces the cache file at once
+  if (llvm::sys::fs::create_directories(m_Directory))
+    return false;
+
+  int fd = -1;
+  llvm::SmallString<256> temp;
+  if (llvm::sys::fs::createUniqueFile(
+          getCacheFile(pInput) + ".tmp-%%%%%%%%", fd, temp))
+    return false;
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose*/ true);
+    os.write(&file[0], file.size());
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp.str());
+      return false;
+    }
+  }
+
+  if (llvm::sys::fs::rename(temp.str(), getCacheFile(pInput))) {
+    llvm::sys::fs::remove(temp.str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace mcld
@@ -0,0 +1,160 @@
+//===- StringTableBuilder.cpp ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/StringTableBuilder.h"
+
+#include <llvm/ADT/Hashing.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mcld {
+
+static const uint32_t EmptySlot = ~static_cast<uint32_t>(0);
+
+/// isTailBefore - the order of the strings for tail merging. The strings are
+/// compared from their ends, in the descending order, so that a string comes
+/// right after a string which ends with it.
+static bool isTailBefore(llvm::StringRef pA, llvm::StringRef pB) {
+  size_t size = std::min(pA.size(), pB.size());
+  for (size_t n = 1; n <= size; ++n) {
+    unsigned char a = pA[pA.size() - n];
+    unsigned char b = pB[pB.size() - n];
+    if (a != b)
+      return a > b;
+  }
+  return pA.size() > pB.size();
+}
+
+//===----------------------------------------------------------------------===//
+// StringTableBuilder
+//===----------------------------------------------------------------------===//
+StringTableBuilder::StringTableBuilder(bool pTailMerge)
+    : m_bTailMerge(pTailMerge),
+      m_bFinalized(false),
+      m_Size(0),
+      m_Table(64, EmptySlot) {
+}
+
+size_t StringTableBuilder::findSlot(llvm::StringRef pString,
+                                    uint32_t pHash) const {
+  size_t mask = m_Table.size() - 1;
+  for (size_t slot = pHash & mask;; slot = (slot + 1) & mask) {
+    uint32_t idx = m_Table[slot];
+    if (idx == EmptySlot ||
+        (m_Strings[idx].hash == pHash && m_Strings[idx].str == pString))
+      return slot;
+  }
+}
+
+uint32_t StringTableBuilder::insert(size_t pSlot,
+                                    llvm::StringRef pString,
+                                    uint32_t pHash) {
+  Entry entry;
+  entry.str = pString;
+  entry.offset = 0;
+  entry.hash = pHash;
+  m_Table[pSlot] = m_Strings.size();
+  m_Strings.push_back(entry);
+
+  // keep the table at most half full
+  if (2 * m_Strings.size() > m_Table.size()) {
+    std::vector<uint32_t> larger(2 * m_Table.size(), EmptySlot);
+    size_t mask = larger.size() - 1;
+    for (uint32_t idx = 0; idx < m_Strings.size(); ++idx) {
+      size_t slot = m_Strings[idx].hash & mask;
+      while (larger[slot] != EmptySlot)
+        slot = (slot + 1) & mask;
+      larger[slot] = idx;
+    }
+    m_Table.swap(larger);
+  }
+  return m_Strings.size() - 1;
+}
+
+void StringTableBuilder::add(llvm::StringRef pString) {
+  assert(!m_bFinalized && "the table is finalized");
+  uint32_t hash = llvm::hash_value(pString);
+  size_t slot = findSlot(pString, hash);
+  if (m_Table[slot] == EmptySlot)
+    insert(slot, pString, hash);
+}
+
+uint64_t StringTableBuilder::finalize() {
+  // the string that a string is kept in the end of, or itself
+  std::vector<uint32_t> parents(m_Strings.size());
+  std::vector<uint32_t> tails;
+  for (uint32_t idx = 0; idx < m_Strings.size(); ++idx)
+    parents[idx] = idx;
+
+  if (m_bTailMerge) {
+    tails.resize(m_Strings.size());
+    for (uint32_t idx = 0; idx < m_Strings.size(); ++idx)
+      tails[idx] = idx;
+    std::sort(tails.begin(), tails.end(), [this](uint32_t pA, uint32_t pB) {
+      return isTailBefore(m_Strings[pA].str, m_Strings[pB].str);
+    });
+    for (size_t n = 1; n < tails.size(); ++n) {
+      llvm::StringRef str = m_Strings[tails[n]].str;
+      if (!str.empty() && m_Strings[tails[n - 1]].str.endswith(str))
+        parents[tails[n]] = tails[n - 1];
+    }
+  }
+
+  // the empty string is the leading '\0'
+  uint64_t offset = 1;
+  for (uint32_t idx = 0; idx < m_Strings.size(); ++idx) {
+    Entry& entry = m_Strings[idx];
+    if (parents[idx] != idx || entry.str.empty())
+      continue;
+    entry.offset = offset;
+    offset += entry.str.size() + 1;
+  }
+  m_Size = offset;
+  m_bFinalized = true;
+
+  // a parent comes before its tails
+  for (size_t n = 0; n < tails.size(); ++n) {
+    Entry& entry = m_Strings[tails[n]];
+    const Entry& parent = m_Strings[parents[tails[n]]];
+    if (&entry != &parent)
+      entry.offset = parent.offset + (parent.str.size() - entry.str.size());
+  }
+  return m_Size;
+}
+
+uint64_t StringTableBuilder::getOffset(llvm::StringRef pString) const {
+  assert(m_bFinalized && "the table is not finalized");
+  size_t slot = findSlot(pString, llvm::hash_value(pString));
+  assert(m_Table[slot] != EmptySlot && "no such string");
+  return m_Strings[m_Table[slot]].offset;
+}
+
+uint64_t StringTableBuilder::append(llvm::StringRef pString) {
+  assert(m_bFinalized && "the table is not finalized");
+  uint32_t hash = llvm::hash_value(pString);
+  size_t slot = findSlot(pString, hash);
+  if (m_Table[slot] != EmptySlot)
+    return m_Strings[m_Table[slot]].offset;
+
+  Entry& entry = m_Strings[insert(slot, pString, hash)];
+  entry.offset = pString.empty() ? 0 : m_Size;
+  m_Size += pString.empty() ? 0 : pString.size() + 1;
+  return entry.offset;
+}
+
+void StringTableBuilder::emit(char* pBuffer) const {
+  std::memset(pBuffer, 0, m_Size);
+  for (size_t idx = 0; idx < m_Strings.size(); ++idx) {
+    const Entry& entry = m_Strings[idx];
+    std::memcpy(pBuffer + entry.offset, entry.str.data(), entry.str.size());
+  }
+}
+
+}  // namespace mcld
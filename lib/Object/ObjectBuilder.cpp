@@ -46,7 +46,7 @@ LDSection* ObjectBuilder::CreateSection(const std::string& pName,
   if (output_sect == NULL) {
     output_sect = LDSection::Create(pName, pKind, pType, pFlag);
     output_sect->setAlign(pAlign);
-    m_Module.getSectionTable().push_back(output_sect);
+    m_Module.addSection(*output_sect);
   }
   return output_sect;
 }
@@ -62,17 +62,26 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
     return NULL;
   }
 
-  std::string output_name =
-      (pair.first == NULL) ? pInputSection.name() : pair.first->name();
-  LDSection* target = m_Module.getSection(output_name);
-
-  if (target == NULL) {
-    target = LDSection::Create(output_name,
-                               pInputSection.kind(),
-                               pInputSection.type(),
-                               pInputSection.flag());
-    target->setAlign(pInputSection.align());
-    m_Module.getSectionTable().push_back(target);
+  // the same description maps the same input section name to the same
+  // output section
+  LastMatch& last = m_LastMatches[pInputSection.name()];
+  LDSection* target = NULL;
+  if (last.second != NULL && last.first == pair.first) {
+    target = last.second;
+  } else {
+    std::string output_name =
+        (pair.first == NULL) ? pInputSection.name() : pair.first->name();
+    target = m_Module.getSection(output_name);
+
+    if (target == NULL) {
+      target = LDSection::Create(output_name,
+                                 pInputSection.kind(),
+                                 pInputSection.type(),
+                                 pInputSection.flag());
+      target->setAlign(pInputSection.align());
+      m_Module.addSection(*target);
+    }
+    last = LastMatch(pair.first, target);
   }
 
   switch (target->kind()) {
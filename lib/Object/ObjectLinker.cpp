@@ -13,6 +13,8 @@
 #include "mcld/LinkerConfig.h"
 #include "mcld/LinkerScript.h"
 #include "mcld/Module.h"
+#include "mcld/Fragment/FragmentRef.h"
+#include "mcld/Fragment/RegionFragment.h"
 #include "mcld/Fragment/Relocation.h"
 #include "mcld/LD/Archive.h"
 #include "mcld/LD/ArchiveReader.h"
@@ -25,6 +27,8 @@
 #include "mcld/LD/IdenticalCodeFolding.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/LDSection.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/MergedStrings.h"
 #include "mcld/LD/ObjectReader.h"
 #include "mcld/LD/ObjectWriter.h"
 #include "mcld/LD/Relocator.h"
@@ -40,12 +44,20 @@
 #include "mcld/Support/FileOutputBuffer.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/RealPath.h"
+#include "mcld/Support/ThreadPool.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/TargetLDBackend.h"
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/Host.h>
 
 #include <system_error>
+#include <utility>
+#include <vector>
 
 namespace mcld {
 
@@ -64,7 +76,8 @@ ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
       m_pGroupReader(NULL),
       m_pBinaryReader(NULL),
       m_pScriptReader(NULL),
-      m_pWriter(NULL) {
+      m_pWriter(NULL),
+      m_pThreadPool(NULL) {
 }
 
 ObjectLinker::~ObjectLinker() {
@@ -75,9 +88,13 @@ ObjectLinker::~ObjectLinker() {
   delete m_pBinaryReader;
   delete m_pScriptReader;
   delete m_pWriter;
+  delete m_pThreadPool;
+  for (size_t n = 0; n < m_MergedStrings.size(); ++n)
+    delete m_MergedStrings[n];
 }
 
 bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder) {
+  TimeTrace::Scope trace("initialize");
   m_pModule = &pModule;
   m_pBuilder = &pBuilder;
 
@@ -95,6 +112,13 @@ bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder) {
       *m_pObjectReader, *m_pArchiveReader, *m_pDynObjReader, *m_pGroupReader);
   m_pWriter = m_LDBackend.createWriter();
 
+  // initialize the worker threads
+  if (m_Config.options().numThreads() > 1) {
+    m_pThreadPool = new ThreadPool(m_Config.options().numThreads());
+    m_pWriter->setThreadPool(m_pThreadPool);
+    m_pArchiveReader->setThreadPool(m_pThreadPool);
+  }
+
   // initialize Relocator
   m_LDBackend.initRelocator();
 
@@ -103,6 +127,7 @@ bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder) {
 
 /// initStdSections - initialize standard sections
 bool ObjectLinker::initStdSections() {
+  TimeTrace::Scope trace("initStdSections");
   ObjectBuilder builder(*m_pModule);
 
   // initialize standard sections
@@ -116,6 +141,7 @@ bool ObjectLinker::initStdSections() {
 }
 
 void ObjectLinker::addUndefinedSymbols() {
+  TimeTrace::Scope trace("addUndefinedSymbols");
   // Add the symbol set by -u as an undefind global symbol into symbol pool
   GeneralOptions::const_undef_sym_iterator usym;
   GeneralOptions::const_undef_sym_iterator usymEnd =
@@ -143,7 +169,95 @@ void ObjectLinker::addUndefinedSymbols() {
   }
 }
 
+void ObjectLinker::reserveNamePool() {
+  size_t num_of_symbols = 0;
+  InputTree::dfs_iterator input, inEnd = m_pModule->getInputTree().dfs_end();
+  for (input = m_pModule->getInputTree().dfs_begin(); input != inEnd;
+       ++input) {
+    if ((*input)->type() != Input::Unknown || !(*input)->hasMemArea())
+      continue;
+
+    bool doContinue = false;
+    if (getBinaryReader()->isMyFormat(**input, doContinue) || !doContinue)
+      continue;
+
+    if (getObjectReader()->isMyFormat(**input, doContinue))
+      num_of_symbols += getObjectReader()->countSymbols(**input);
+    else if (doContinue && getDynObjReader()->isMyFormat(**input, doContinue))
+      num_of_symbols += getDynObjReader()->countSymbols(**input);
+  }
+
+  // local symbols are not inserted, so this over-estimates a little.
+  if (num_of_symbols > 0)
+    m_pModule->getNamePool().reserve(num_of_symbols);
+}
+
+void ObjectLinker::decodeInputs() {
+  TimeTrace::Scope trace("decodeInputs");
+  // collect the inputs which are not typed yet. Binary inputs are read as a
+  // whole, and the others are decoded only if they are relocatable objects.
+  std::vector<Input*> inputs;
+  InputTree::dfs_iterator input, inEnd = m_pModule->getInputTree().dfs_end();
+  for (input = m_pModule->getInputTree().dfs_begin(); input != inEnd;
+       ++input) {
+    if ((*input)->type() != Input::Unknown || !(*input)->hasMemArea())
+      continue;
+
+    bool doContinue = false;
+    if (getBinaryReader()->isMyFormat(**input, doContinue) || !doContinue)
+      continue;
+    inputs.push_back(*input);
+  }
+
+  if (inputs.size() < 2)
+    return;
+
+  // each task owns its buffer, so that no lock is needed.
+  std::vector<SymbolBuffer*> buffers(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i)
+    buffers[i] = new SymbolBuffer();
+
+  // std::vector<bool> packs bits, so use a byte per task to avoid races.
+  ObjectReader* reader = getObjectReader();
+  std::vector<uint8_t> decoded(inputs.size(), 0);
+  m_pThreadPool->parallelFor(0, inputs.size(), [&](size_t pIdx) {
+    decoded[pIdx] = reader->decodeSymbols(*inputs[pIdx], *buffers[pIdx]);
+  });
+
+  // The global names are also interned here: hashing and allocating the
+  // entries is done in parallel, while resolving them is left to the serial
+  // replay in command-line order.
+  {
+    TimeTrace::Scope trace("internNames");
+    NamePool& name_pool = m_pModule->getNamePool();
+    m_pThreadPool->parallelFor(0, inputs.size(), [&](size_t pIdx) {
+      if (!decoded[pIdx])
+        return;
+      SymbolBuffer::const_iterator entry, enEnd = buffers[pIdx]->end();
+      for (entry = buffers[pIdx]->begin(); entry != enEnd; ++entry) {
+        if ((entry->info >> 4) != llvm::ELF::STB_LOCAL && !entry->name.empty())
+          name_pool.intern(entry->name);
+      }
+    });
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (decoded[i])
+      reader->symbolBuffers()[inputs[i]] = buffers[i];
+    else
+      delete buffers[i];
+  }
+}
+
 void ObjectLinker::normalize() {
+  TimeTrace::Scope trace("normalize");
+  // -----  size the symbol table ahead  ----- //
+  reserveNamePool();
+
+  // -----  decode symbol tables concurrently  ----- //
+  if (m_pThreadPool != NULL)
+    decodeInputs();
+
   // -----  set up inputs  ----- //
   Module::input_iterator input, inEnd = m_pModule->input_end();
   for (input = m_pModule->input_begin(); input != inEnd; ++input) {
@@ -183,14 +297,20 @@ void ObjectLinker::normalize() {
       (*input)->setType(Input::Object);
       getObjectReader()->readHeader(**input);
       getObjectReader()->readSections(**input);
-      getObjectReader()->readSymbols(**input);
+      {
+        TimeTrace::Scope trace("readSymbols", (*input)->name());
+        getObjectReader()->readSymbols(**input);
+      }
       m_pModule->getObjectList().push_back(*input);
     } else if (doContinue &&
                getDynObjReader()->isMyFormat(**input, doContinue)) {
       // is a shared object file
       (*input)->setType(Input::DynObj);
       getDynObjReader()->readHeader(**input);
-      getDynObjReader()->readSymbols(**input);
+      {
+        TimeTrace::Scope trace("readSymbols", (*input)->name());
+        getDynObjReader()->readSymbols(**input);
+      }
       m_pModule->getLibraryList().push_back(*input);
     } else if (doContinue &&
                getArchiveReader()->isMyFormat(**input, doContinue)) {
@@ -224,6 +344,10 @@ void ObjectLinker::normalize() {
             << (*input)->path() << m_Config.targets().triple().str();
     }
   }  // end of for
+
+  // the entry is looked up only when the ELF header is written, too late to
+  // import the symbols of shared objects
+  m_pModule->getNamePool().import(m_LDBackend.getEntry(*m_pModule));
 }
 
 bool ObjectLinker::linkable() const {
@@ -262,6 +386,7 @@ bool ObjectLinker::linkable() const {
 }
 
 void ObjectLinker::dataStrippingOpt() {
+  TimeTrace::Scope trace("dataStrippingOpt");
   if (m_Config.codeGenType() == LinkerConfig::Object) {
     return;
   }
@@ -284,6 +409,7 @@ void ObjectLinker::dataStrippingOpt() {
 ///
 /// All symbols should be read and resolved before this function.
 bool ObjectLinker::readRelocations() {
+  TimeTrace::Scope trace("readRelocations");
   // Bitcode is read by the other path. This function reads relocation sections
   // in object files.
   mcld::InputTree::bfs_iterator input,
@@ -300,6 +426,7 @@ bool ObjectLinker::readRelocations() {
 
 /// mergeSections - put allinput sections into output sections
 bool ObjectLinker::mergeSections() {
+  TimeTrace::Scope trace("mergeSections");
   // run the target-dependent hooks before merging sections
   m_LDBackend.preMergeSections(*m_pModule);
 
@@ -335,6 +462,11 @@ bool ObjectLinker::mergeSections() {
     }  // for each output section description
   }
 
+  // A partial link keeps the SHF_MERGE sections as they are, with their
+  // flags, so that the final link merges them along with its other inputs.
+  if (LinkerConfig::Object != m_Config.codeGenType())
+    mergeStrings();
+
   ObjectBuilder builder(*m_pModule);
   Module::obj_iterator obj, objEnd = m_pModule->obj_end();
   for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
@@ -440,6 +572,202 @@ bool ObjectLinker::mergeSections() {
   return true;
 }
 
+/// getMergeableRegion - the only region of pSection, or NULL if the contents
+/// are not in one region. The reader appends a NullFragment after the region,
+/// and an empty AlignFragment may come before it.
+static RegionFragment* getMergeableRegion(LDSection& pSection) {
+  RegionFragment* region = NULL;
+  SectionData::iterator frag, fragEnd = pSection.getSectionData()->end();
+  for (frag = pSection.getSectionData()->begin(); frag != fragEnd; ++frag) {
+    if (frag->getKind() == Fragment::Null || frag->size() == 0)
+      continue;
+    if (region != NULL || frag->getKind() != Fragment::Region)
+      return NULL;
+    region = llvm::cast<RegionFragment>(&*frag);
+  }
+  if (region == NULL || region->getRegion().size() != pSection.size())
+    return NULL;
+  return region;
+}
+
+/// mergeStrings - merge the strings and the constants of the SHF_MERGE
+/// sections
+void ObjectLinker::mergeStrings() {
+  TimeTrace::Scope trace("mergeStrings");
+  // the sections whose strings can be merged, with the group and the index
+  // of each one in the group
+  typedef std::pair<unsigned int, unsigned int> Member;
+  llvm::DenseMap<const LDSection*, Member> members;
+  std::vector<LDSection*> candidates;
+  std::vector<llvm::StringRef> regions;
+  std::vector<const Input*> files;
+
+  const uint32_t mergeable = llvm::ELF::SHF_ALLOC | llvm::ELF::SHF_MERGE;
+  Module::obj_iterator obj, objEnd = m_pModule->obj_end();
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if ((*sect)->kind() != LDFileFormat::DATA ||
+          ((*sect)->flag() & mergeable) != mergeable ||
+          (*sect)->entSize() == 0 || !(*sect)->hasSectionData())
+        continue;
+
+      // the contents must be read as one region
+      RegionFragment* region = getMergeableRegion(**sect);
+      bool strings = ((*sect)->flag() & llvm::ELF::SHF_STRINGS) != 0;
+      if (region == NULL ||
+          !MergedStrings::canMerge(
+              region->getRegion(), (*sect)->entSize(), strings))
+        continue;
+
+      members[*sect] = Member(0, 0);
+      candidates.push_back(*sect);
+      regions.push_back(region->getRegion());
+      files.push_back(*obj);
+    }
+  }
+  if (candidates.empty())
+    return;
+
+  // A section with relocations is left as is. A relocation against the
+  // section symbol of a merged section is moved by its addend, which must
+  // be in the relocation entry and in the section.
+  std::vector<Relocation*> relocs;
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if ((*rs)->kind() == LDFileFormat::Ignore || !(*rs)->hasRelocData())
+        continue;
+      members.erase((*rs)->getLink());
+
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        ResolveInfo* info = reloc->symInfo();
+        if (info == NULL || info->type() != ResolveInfo::Section ||
+            info->outSymbol() == NULL || !info->outSymbol()->hasFragRef())
+          continue;
+        const LDSection& target =
+            info->outSymbol()->fragRef()->frag()->getParent()->getSection();
+        if ((target.flag() & llvm::ELF::SHF_MERGE) == 0 ||
+            members.find(&target) == members.end())
+          continue;
+        int64_t addend = static_cast<int64_t>(reloc->addend());
+        if ((*rs)->type() == llvm::ELF::SHT_REL || addend < 0 ||
+            static_cast<uint64_t>(addend) >= target.size()) {
+          members.erase(&target);
+          continue;
+        }
+        relocs.push_back(&*reloc);
+      }
+    }
+  }
+
+  // group the sections by their output sections and their layout, in the
+  // order of the inputs
+  std::vector<LDSection*> leaders;
+  llvm::StringMap<unsigned int> groups;
+  for (size_t n = 0; n < candidates.size(); ++n) {
+    LDSection* sect = candidates[n];
+    llvm::DenseMap<const LDSection*, Member>::iterator member =
+        members.find(sect);
+    if (member == members.end())
+      continue;
+
+    SectionMap::mapping pair = m_pModule->getScript().sectionMap().find(
+        files[n]->path().native(), sect->name());
+    if (pair.first != NULL && pair.first->isDiscard()) {
+      members.erase(member);
+      continue;
+    }
+
+    std::string key =
+        (pair.first == NULL) ? sect->name() : pair.first->name();
+    key += '\0';
+    key += llvm::utostr(sect->flag()) + ":" + llvm::utostr(sect->entSize()) +
+           ":" + llvm::utostr(sect->align());
+    llvm::StringMap<unsigned int>::iterator group = groups.find(key);
+    if (group == groups.end()) {
+      group = groups.insert(std::make_pair(key, leaders.size())).first;
+      leaders.push_back(sect);
+      m_MergedStrings.push_back(new MergedStrings(
+          sect->entSize(),
+          sect->align(),
+          (sect->flag() & llvm::ELF::SHF_STRINGS) != 0));
+    }
+
+    MergedStrings* strings = m_MergedStrings[group->getValue()];
+    member->second =
+        Member(group->getValue(), strings->addSection(regions[n]));
+  }
+  if (leaders.empty())
+    return;
+
+  size_t first = m_MergedStrings.size() - leaders.size();
+  for (size_t n = 0; n < leaders.size(); ++n) {
+    m_MergedStrings[first + n]->finalize(m_pThreadPool,
+                                         m_Config.options().tailMergeStrings());
+  }
+
+  // move the relocations against the section symbols to the merged pieces
+  for (size_t n = 0; n < relocs.size(); ++n) {
+    const LDSection& target = relocs[n]->symInfo()->outSymbol()->fragRef()
+                                  ->frag()->getParent()->getSection();
+    llvm::DenseMap<const LDSection*, Member>::iterator member =
+        members.find(&target);
+    if (member == members.end())
+      continue;
+    MergedStrings* strings = m_MergedStrings[first + member->second.first];
+    relocs[n]->setAddend(
+        strings->getOutputOffset(member->second.second, relocs[n]->addend()));
+  }
+
+  std::vector<Fragment*> frags(leaders.size());
+  for (size_t n = 0; n < leaders.size(); ++n)
+    frags[n] = new RegionFragment(m_MergedStrings[first + n]->getContents());
+
+  // move the symbols. A symbol may be shared by the input and the output, so
+  // those already moved, which are not in any section yet, are skipped.
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sym_iterator sym, symEnd = (*obj)->context()->symTabEnd();
+    for (sym = (*obj)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (*sym == NULL || !(*sym)->hasFragRef())
+        continue;
+      FragmentRef* ref = (*sym)->fragRef();
+      if (ref->frag()->getParent() == NULL)
+        continue;
+      llvm::DenseMap<const LDSection*, Member>::iterator member =
+          members.find(&ref->frag()->getParent()->getSection());
+      if (member == members.end())
+        continue;
+
+      Member pos = member->second;
+      if ((*sym)->resolveInfo()->type() == ResolveInfo::Section) {
+        ref->assign(*frags[pos.first], 0);
+      } else {
+        uint64_t offset = ref->frag()->getOffset() + ref->offset();
+        ref->assign(*frags[pos.first],
+                    m_MergedStrings[first + pos.first]->getOutputOffset(
+                        pos.second, offset));
+      }
+    }
+  }
+
+  // the first section of a group keeps the merged pieces
+  for (size_t n = 0; n < leaders.size(); ++n) {
+    SectionData* sd = leaders[n]->getSectionData();
+    sd->getFragmentList().clear();
+    ObjectBuilder::AppendFragment(*frags[n], *sd);
+    leaders[n]->setSize(m_MergedStrings[first + n]->size());
+  }
+  llvm::DenseMap<const LDSection*, Member>::iterator member,
+      mEnd = members.end();
+  for (member = members.begin(); member != mEnd; ++member) {
+    LDSection* sect = const_cast<LDSection*>(member->first);
+    if (sect != leaders[member->second.first])
+      sect->setKind(LDFileFormat::Folded);
+  }
+}
+
 void ObjectLinker::addSymbolToOutput(ResolveInfo& pInfo, Module& pModule) {
   // section symbols will be defined by linker later, we should not add section
   // symbols to output here
@@ -477,6 +805,7 @@ void ObjectLinker::addSymbolToOutput(ResolveInfo& pInfo, Module& pModule) {
 }
 
 void ObjectLinker::addSymbolsToOutput(Module& pModule) {
+  TimeTrace::Scope trace("addSymbolsToOutput");
   // Traverse all the free ResolveInfo and add the output symobols to output
   NamePool::freeinfo_iterator free_it,
       free_end = pModule.getNamePool().freeinfo_end();
@@ -489,7 +818,7 @@ void ObjectLinker::addSymbolsToOutput(Module& pModule) {
       info_end = pModule.getNamePool().syminfo_end();
   for (info_it = pModule.getNamePool().syminfo_begin(); info_it != info_end;
        ++info_it)
-    addSymbolToOutput(*info_it.getEntry(), pModule);
+    addSymbolToOutput(**info_it, pModule);
 }
 
 /// addStandardSymbols - shared object and executable files need some
@@ -497,6 +826,7 @@ void ObjectLinker::addSymbolsToOutput(Module& pModule) {
 ///   @return if there are some input symbols with the same name to the
 ///   standard symbols, return false
 bool ObjectLinker::addStandardSymbols() {
+  TimeTrace::Scope trace("addStandardSymbols");
   // create and add section symbols for each output section
   Module::iterator iter, iterEnd = m_pModule->end();
   for (iter = m_pModule->begin(); iter != iterEnd; ++iter) {
@@ -511,6 +841,7 @@ bool ObjectLinker::addStandardSymbols() {
 ///   @return if there are some input symbols with the same name to the
 ///   target symbols, return false
 bool ObjectLinker::addTargetSymbols() {
+  TimeTrace::Scope trace("addTargetSymbols");
   m_LDBackend.initTargetSymbols(*m_pBuilder, *m_pModule);
   return true;
 }
@@ -518,6 +849,7 @@ bool ObjectLinker::addTargetSymbols() {
 /// addScriptSymbols - define symbols from the command line option or linker
 /// scripts.
 bool ObjectLinker::addScriptSymbols() {
+  TimeTrace::Scope trace("addScriptSymbols");
   LinkerScript& script = m_pModule->getScript();
   LinkerScript::Assignments::iterator it, ie = script.assignments().end();
   // go through the entire symbol assignments
@@ -528,6 +860,7 @@ bool ObjectLinker::addScriptSymbols() {
     ResolveInfo::Type type = ResolveInfo::NoType;
     ResolveInfo::Visibility vis = ResolveInfo::Default;
     size_t size = 0;
+    m_pModule->getNamePool().import(symName);
     ResolveInfo* old_info = m_pModule->getNamePool().findInfo(symName);
     // if the symbol does not exist, we can set type to NOTYPE
     // else we retain its type, same goes for size - 0 or retain old value
@@ -578,7 +911,30 @@ bool ObjectLinker::addScriptSymbols() {
   return true;
 }
 
+/// isDiscardedReloc - the reloc is against a symbol in a discarded section
+static bool isDiscardedReloc(Relocation& pReloc) {
+  ResolveInfo* info = pReloc.symInfo();
+  return (!info->outSymbol()->hasFragRef() &&
+          ResolveInfo::Section == info->type() &&
+          ResolveInfo::Undefined == info->desc());
+}
+
+/// isDebugStringReloc - the reloc is against a symbol in DebugString
+static bool isDebugStringReloc(Relocation& pReloc) {
+  ResolveInfo* info = pReloc.symInfo();
+  return (info->outSymbol()->hasFragRef() &&
+          info->outSymbol()->fragRef()->frag()->getKind() ==
+              Fragment::Region &&
+          info->outSymbol()->fragRef()->frag()->getParent()->getSection()
+                  .kind() == LDFileFormat::DebugString);
+}
+
 bool ObjectLinker::scanRelocations() {
+  TimeTrace::Scope trace("scanRelocations");
+  if (m_pThreadPool != NULL &&
+      LinkerConfig::Object != m_Config.codeGenType())
+    return scanRelocationsConcurrently();
+
   // apply all relocations of all inputs
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
   for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
@@ -597,10 +953,7 @@ bool ObjectLinker::scanRelocations() {
         Relocation* relocation = llvm::cast<Relocation>(reloc);
 
         // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
+        if (isDiscardedReloc(*relocation))
           continue;
 
         // scan relocation
@@ -618,8 +971,64 @@ bool ObjectLinker::scanRelocations() {
   return true;
 }
 
+bool ObjectLinker::scanRelocationsConcurrently() {
+  Relocator& relocator = *m_LDBackend.getRelocator();
+
+  // one task per relocation section. Workers only classify relocations and
+  // record those which may reserve GOT, PLT or dynamic relocation entries.
+  struct ScanTask {
+    Input* input;
+    LDSection* section;
+    std::vector<Relocation*> requests;
+  };
+
+  std::vector<ScanTask> tasks;
+  Module::obj_iterator input, inEnd = m_pModule->obj_end();
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      ScanTask task;
+      task.input = *input;
+      task.section = *rs;
+      tasks.push_back(task);
+    }
+  }
+
+  m_pThreadPool->parallelFor(0, tasks.size(), [&](size_t pIdx) {
+    ScanTask& task = tasks[pIdx];
+    RelocData::iterator reloc, rEnd = task.section->getRelocData()->end();
+    for (reloc = task.section->getRelocData()->begin(); reloc != rEnd;
+         ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+      if (isDiscardedReloc(*relocation))
+        continue;
+      if (relocator.needsScan(*relocation, *task.section))
+        task.requests.push_back(relocation);
+    }
+  });
+
+  // merge the requests in input order, so that the entries are allocated
+  // exactly as a serial scan does.
+  std::vector<ScanTask>::iterator task = tasks.begin(), taskEnd = tasks.end();
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+    relocator.initializeScan(**input);
+    for (; task != taskEnd && task->input == *input; ++task) {
+      std::vector<Relocation*>::iterator reloc, rEnd = task->requests.end();
+      for (reloc = task->requests.begin(); reloc != rEnd; ++reloc) {
+        relocator.scanRelocation(
+            **reloc, *m_pBuilder, *m_pModule, *task->section, **input);
+      }
+    }
+    relocator.finalizeScan(**input);
+  }
+  return true;
+}
+
 /// initStubs - initialize stub-related stuff.
 bool ObjectLinker::initStubs() {
+  TimeTrace::Scope trace("initStubs");
   // initialize BranchIslandFactory
   m_LDBackend.initBRIslandFactory();
 
@@ -634,6 +1043,7 @@ bool ObjectLinker::initStubs() {
 /// allocateCommonSymobols - allocate fragments for common symbols to the
 /// corresponding sections
 bool ObjectLinker::allocateCommonSymbols() {
+  TimeTrace::Scope trace("allocateCommonSymbols");
   if (LinkerConfig::Object != m_Config.codeGenType() ||
       m_Config.options().isDefineCommon())
     return m_LDBackend.allocateCommonSymbols(*m_pModule);
@@ -642,6 +1052,7 @@ bool ObjectLinker::allocateCommonSymbols() {
 
 /// prelayout - help backend to do some modification before layout
 bool ObjectLinker::prelayout() {
+  TimeTrace::Scope trace("prelayout");
   // finalize the section symbols, set their fragment reference and push them
   // into output symbol table
   Module::iterator sect, sEnd = m_pModule->end();
@@ -685,7 +1096,8 @@ bool ObjectLinker::prelayout() {
   if (LinkerConfig::Object != m_Config.codeGenType()) {
     LDSection* debug_str_sect = m_pModule->getSection(".debug_str");
     if (debug_str_sect && debug_str_sect->hasDebugString())
-      debug_str_sect->getDebugString()->computeOffsetSize();
+      debug_str_sect->getDebugString()->computeOffsetSize(
+          m_pThreadPool, m_Config.options().tailMergeStrings());
   }
   return true;
 }
@@ -696,12 +1108,14 @@ bool ObjectLinker::prelayout() {
 ///   if there is a branch can not jump to its target, we return false
 ///   directly
 bool ObjectLinker::layout() {
+  TimeTrace::Scope trace("layout");
   m_LDBackend.layout(*m_pModule);
   return true;
 }
 
 /// prelayout - help backend to do some modification after layout
 bool ObjectLinker::postlayout() {
+  TimeTrace::Scope trace("postlayout");
   m_LDBackend.postLayout(*m_pModule, *m_pBuilder);
   return true;
 }
@@ -711,6 +1125,7 @@ bool ObjectLinker::postlayout() {
 ///   all
 ///   symbol.
 bool ObjectLinker::finalizeSymbolValue() {
+  TimeTrace::Scope trace("finalizeSymbolValue");
   Module::sym_iterator symbol, symEnd = m_pModule->sym_end();
   for (symbol = m_pModule->sym_begin(); symbol != symEnd; ++symbol) {
     if ((*symbol)->resolveInfo()->isAbsolute() ||
@@ -777,6 +1192,7 @@ bool ObjectLinker::finalizeSymbolValue() {
 /// read the relocation information into RelocationEntry
 /// and push_back into the relocation section
 bool ObjectLinker::relocation() {
+  TimeTrace::Scope trace("relocation");
   // when producing relocatables, no need to apply relocation
   if (LinkerConfig::Object == m_Config.codeGenType())
     return true;
@@ -784,47 +1200,44 @@ bool ObjectLinker::relocation() {
   LDSection* debug_str_sect = m_pModule->getSection(".debug_str");
 
   // apply all relocations of all inputs
-  Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    m_LDBackend.getRelocator()->initializeApply(**input);
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
-
-        // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
-          continue;
-
-        // apply the relocation aginst symbol on DebugString
-        if (info->outSymbol()->hasFragRef() &&
-            info->outSymbol()->fragRef()->frag()->getKind()
-                == Fragment::Region &&
-            info->outSymbol()->fragRef()->frag()->getParent()->getSection()
-                .kind() == LDFileFormat::DebugString) {
-          assert(debug_str_sect != NULL);
-          assert(debug_str_sect->hasDebugString());
-          debug_str_sect->getDebugString()->applyOffset(*relocation,
-                                                        m_LDBackend);
+  if (m_pThreadPool != NULL) {
+    applyRelocationsConcurrently(debug_str_sect);
+  } else {
+    Module::obj_iterator input, inEnd = m_pModule->obj_end();
+    for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+      m_LDBackend.getRelocator()->initializeApply(**input);
+      LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+      for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+        // bypass the reloc section if
+        // 1. its section kind is changed to Ignore. (The target section is a
+        // discarded group section.)
+        // 2. it has no reloc data. (All symbols in the input relocs are in the
+        // discarded group sections)
+        if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
           continue;
-        }
+        RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+        for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+          Relocation* relocation = llvm::cast<Relocation>(reloc);
+
+          // bypass the reloc if the symbol is in the discarded input section
+          if (isDiscardedReloc(*relocation))
+            continue;
+
+          // apply the relocation aginst symbol on DebugString
+          if (isDebugStringReloc(*relocation)) {
+            assert(debug_str_sect != NULL);
+            assert(debug_str_sect->hasDebugString());
+            debug_str_sect->getDebugString()->applyOffset(*relocation,
+                                                          m_LDBackend);
+            continue;
+          }
 
-        relocation->apply(*m_LDBackend.getRelocator());
-      }  // for all relocations
-    }    // for all relocation section
-    m_LDBackend.getRelocator()->finalizeApply(**input);
-  }  // for all inputs
+          relocation->apply(*m_LDBackend.getRelocator());
+        }  // for all relocations
+      }    // for all relocation section
+      m_LDBackend.getRelocator()->finalizeApply(**input);
+    }  // for all inputs
+  }
 
   // apply relocations created by relaxation
   BranchIslandFactory* br_factory = m_LDBackend.getBRIslandFactory();
@@ -846,13 +1259,90 @@ bool ObjectLinker::relocation() {
   return true;
 }
 
+void ObjectLinker::applyRelocationsConcurrently(LDSection* pDebugStr) {
+  Relocator& relocator = *m_LDBackend.getRelocator();
+
+  // one task per relocation section. Each task records the relocations which
+  // must be applied in order, and the failures to be reported in order.
+  struct ApplyTask {
+    Input* input;
+    RelocData* data;
+    std::vector<Relocation*> deferred;
+    std::vector<std::pair<Relocation*, Relocator::Result> > failures;
+  };
+
+  std::vector<ApplyTask> tasks;
+  Module::obj_iterator input, inEnd = m_pModule->obj_end();
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      ApplyTask task;
+      task.input = *input;
+      task.data = (*rs)->getRelocData();
+      tasks.push_back(task);
+    }
+  }
+
+  m_pThreadPool->parallelFor(0, tasks.size(), [&](size_t pIdx) {
+    ApplyTask& task = tasks[pIdx];
+    RelocData::iterator reloc, rEnd = task.data->end();
+    for (reloc = task.data->begin(); reloc != rEnd; ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+      if (isDiscardedReloc(*relocation))
+        continue;
+
+      if (isDebugStringReloc(*relocation) ||
+          !relocator.mayApplyConcurrently(*relocation)) {
+        task.deferred.push_back(relocation);
+        continue;
+      }
+
+      Relocator::Result result = relocator.applyRelocation(*relocation);
+      if (Relocator::OK != result)
+        task.failures.push_back(std::make_pair(relocation, result));
+    }
+  });
+
+  // report failures and apply the remaining relocations in input order.
+  Input* current = NULL;
+  std::vector<ApplyTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task) {
+    if (task->input != current) {
+      if (current != NULL)
+        relocator.finalizeApply(*current);
+      current = task->input;
+      relocator.initializeApply(*current);
+    }
+
+    for (size_t i = 0; i < task->failures.size(); ++i)
+      relocator.issueResult(*task->failures[i].first, task->failures[i].second);
+
+    std::vector<Relocation*>::iterator reloc, rEnd = task->deferred.end();
+    for (reloc = task->deferred.begin(); reloc != rEnd; ++reloc) {
+      if (isDebugStringReloc(**reloc)) {
+        assert(pDebugStr != NULL);
+        assert(pDebugStr->hasDebugString());
+        pDebugStr->getDebugString()->applyOffset(**reloc, m_LDBackend);
+        continue;
+      }
+      (*reloc)->apply(relocator);
+    }
+  }
+  if (current != NULL)
+    relocator.finalizeApply(*current);
+}
+
 /// emitOutput - emit the output file.
 bool ObjectLinker::emitOutput(FileOutputBuffer& pOutput) {
+  TimeTrace::Scope trace("emitOutput");
   return std::error_code() == getWriter()->writeObject(*m_pModule, pOutput);
 }
 
 /// postProcessing - do modification after all processes
 bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput) {
+  TimeTrace::Scope trace("postProcessing");
   if (LinkerConfig::Object != m_Config.codeGenType())
     normalSyncRelocationResult(pOutput);
   else
@@ -23,14 +23,6 @@
 #include <cassert>
 #include <cstring>
 #include <climits>
-#if !defined(MCLD_ON_WIN32)
-#include <fnmatch.h>
-#define fnmatch0(pattern, string) (fnmatch(pattern, string, 0) == 0)
-#else
-#include <windows.h>
-#include <shlwapi.h>
-#define fnmatch0(pattern, string) (PathMatchSpec(string, pattern) == true)
-#endif
 
 namespace mcld {
 
@@ -155,6 +147,9 @@ SectionMap::Output::dot_iterator SectionMap::Output::find_last_explicit_dot() {
 //===----------------------------------------------------------------------===//
 // SectionMap
 //===----------------------------------------------------------------------===//
+SectionMap::SectionMap() : m_bIndexValid(false) {
+}
+
 SectionMap::~SectionMap() {
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
@@ -172,29 +167,13 @@ SectionMap::~SectionMap() {
 SectionMap::const_mapping SectionMap::find(
     const std::string& pInputFile,
     const std::string& pInputSection) const {
-  const_iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::const_iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair((const Output*)NULL, (const Input*)NULL);
+  mapping result = lookup(pInputFile, pInputSection);
+  return std::make_pair(result.first, result.second);
 }
 
 SectionMap::mapping SectionMap::find(const std::string& pInputFile,
                                      const std::string& pInputSection) {
-  iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair(reinterpret_cast<Output*>(NULL),
-                        reinterpret_cast<Input*>(NULL));
+  return lookup(pInputFile, pInputSection);
 }
 
 SectionMap::const_iterator SectionMap::find(
@@ -220,6 +199,7 @@ std::pair<SectionMap::mapping, bool> SectionMap::insert(
     const std::string& pInputSection,
     const std::string& pOutputSection,
     InputSectDesc::KeepPolicy pPolicy) {
+  m_bIndexValid = false;
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if ((*out)->name().compare(pOutputSection) == 0)
@@ -252,6 +232,7 @@ std::pair<SectionMap::mapping, bool> SectionMap::insert(
 std::pair<SectionMap::mapping, bool> SectionMap::insert(
     const InputSectDesc& pInputDesc,
     const OutputSectDesc& pOutputDesc) {
+  m_bIndexValid = false;
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if ((*out)->name().compare(pOutputDesc.name()) == 0 &&
@@ -287,50 +268,147 @@ std::pair<SectionMap::mapping, bool> SectionMap::insert(
 
 SectionMap::iterator SectionMap::insert(iterator pPosition,
                                         LDSection* pSection) {
+  m_bIndexValid = false;
   Output* output = new Output(pSection->name());
   output->append(new Input(pSection->name(), InputSectDesc::NoKeep));
   output->setSection(pSection);
   return m_OutputDescList.insert(pPosition, output);
 }
 
-bool SectionMap::matched(const SectionMap::Input& pInput,
-                         const std::string& pInputFile,
-                         const std::string& pInputSection) const {
-  if (pInput.spec().hasFile() && !matched(pInput.spec().file(), pInputFile))
+void SectionMap::buildIndex() const {
+  m_Candidates.clear();
+  for (unsigned int ch = 0; ch < 256; ++ch)
+    m_FirstCharIndex[ch].clear();
+  m_AnyCharIndex.clear();
+  m_SectionMemo.clear();
+  m_FileMemo.clear();
+
+  const_iterator out, outEnd = m_OutputDescList.end();
+  for (out = m_OutputDescList.begin(); out != outEnd; ++out) {
+    Output::iterator in, inEnd = (*out)->end();
+    for (in = (*out)->begin(); in != inEnd; ++in) {
+      const InputSectDesc::Spec& spec = (*in)->spec();
+      if (!spec.hasSections())
+        continue;
+
+      Candidate candidate;
+      candidate.output = *out;
+      candidate.input = *in;
+      candidate.anyFile = (!spec.hasFile() || spec.file().matchesAll()) &&
+                          (!spec.hasExcludeFiles() ||
+                           spec.excludeFiles().empty());
+      uint32_t pos = m_Candidates.size();
+      m_Candidates.push_back(candidate);
+
+      // a description goes to the lists of the first characters of its
+      // patterns, unless one of them starts with a wildcard
+      bool anyChar = false;
+      StringList::const_iterator sect, sectEnd = spec.sections().end();
+      for (sect = spec.sections().begin(); sect != sectEnd; ++sect) {
+        if (llvm::cast<WildcardPattern>(**sect).prefix().empty())
+          anyChar = true;
+      }
+      if (anyChar) {
+        m_AnyCharIndex.push_back(pos);
+        continue;
+      }
+      for (sect = spec.sections().begin(); sect != sectEnd; ++sect) {
+        unsigned char ch = llvm::cast<WildcardPattern>(**sect).prefix()[0];
+        if (m_FirstCharIndex[ch].empty() || m_FirstCharIndex[ch].back() != pos)
+          m_FirstCharIndex[ch].push_back(pos);
+      }
+    }
+  }
+  m_bIndexValid = true;
+}
+
+SectionMap::mapping SectionMap::lookup(
+    const std::string& pInputFile,
+    const std::string& pInputSection) const {
+  if (!m_bIndexValid)
+    buildIndex();
+
+  llvm::StringMap<mapping>::const_iterator memo =
+      m_SectionMemo.find(pInputSection);
+  if (memo != m_SectionMemo.end())
+    return memo->getValue();
+
+  std::string key = pInputFile;
+  key += '\0';
+  key += pInputSection;
+  memo = m_FileMemo.find(key);
+  if (memo != m_FileMemo.end())
+    return memo->getValue();
+
+  // try the candidates of both lists in the order of the descriptions, so
+  // that the first match is the same as a walk over all of them
+  static const CandidateIndex NoCandidates;
+  const CandidateIndex& chars =
+      pInputSection.empty()
+          ? NoCandidates
+          : m_FirstCharIndex[static_cast<unsigned char>(pInputSection[0])];
+  const CandidateIndex& wilds = m_AnyCharIndex;
+
+  mapping result(reinterpret_cast<Output*>(NULL),
+                 reinterpret_cast<Input*>(NULL));
+  bool anyFile = true;
+  size_t i = 0, j = 0;
+  while (i < chars.size() || j < wilds.size()) {
+    uint32_t pos;
+    if (j == wilds.size() || (i < chars.size() && chars[i] < wilds[j]))
+      pos = chars[i++];
+    else
+      pos = wilds[j++];
+
+    const Candidate& candidate = m_Candidates[pos];
+    if (!matchedSection(*candidate.input, pInputSection))
+      continue;
+
+    // the result depends on the file once a matched description does
+    anyFile = anyFile && candidate.anyFile;
+    if (matchedFile(*candidate.input, pInputFile)) {
+      result = std::make_pair(candidate.output, candidate.input);
+      break;
+    }
+  }
+
+  if (anyFile)
+    m_SectionMemo.insert(std::make_pair(pInputSection, result));
+  else
+    m_FileMemo.insert(std::make_pair(key, result));
+  return result;
+}
+
+bool SectionMap::matchedFile(const SectionMap::Input& pInput,
+                             const std::string& pInputFile) const {
+  if (pInput.spec().hasFile() && !pInput.spec().file().matches(pInputFile))
     return false;
 
   if (pInput.spec().hasExcludeFiles()) {
     StringList::const_iterator file, fileEnd;
     fileEnd = pInput.spec().excludeFiles().end();
     for (file = pInput.spec().excludeFiles().begin(); file != fileEnd; ++file) {
-      if (matched(llvm::cast<WildcardPattern>(**file), pInputFile)) {
+      if (llvm::cast<WildcardPattern>(**file).matches(pInputFile)) {
         return false;
       }
     }
   }
+  return true;
+}
 
+bool SectionMap::matchedSection(const SectionMap::Input& pInput,
+                                const std::string& pInputSection) const {
   if (pInput.spec().hasSections()) {
     StringList::const_iterator sect, sectEnd = pInput.spec().sections().end();
     for (sect = pInput.spec().sections().begin(); sect != sectEnd; ++sect) {
-      if (matched(llvm::cast<WildcardPattern>(**sect), pInputSection)) {
+      if (llvm::cast<WildcardPattern>(**sect).matches(pInputSection)) {
         return true;
       }
     }
   }
-
   return false;
 }
 
-bool SectionMap::matched(const WildcardPattern& pPattern,
-                         const std::string& pName) const {
-  if (pPattern.isPrefix()) {
-    llvm::StringRef name(pName);
-    return name.startswith(pPattern.prefix());
-  } else {
-    return fnmatch0(pPattern.name().c_str(), pName.c_str());
-  }
-}
-
 // fixupDotSymbols - ensure the dot symbols are valid
 void SectionMap::fixupDotSymbols() {
   for (iterator it = begin() + 1, ie = end(); it != ie; ++it) {
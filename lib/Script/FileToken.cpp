@@ -8,14 +8,13 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/FileToken.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 namespace mcld {
 
 typedef GCFactory<FileToken, MCLD_SYMBOLS_PER_INPUT> FileTokenFactory;
-static llvm::ManagedStatic<FileTokenFactory> g_FileTokenFactory;
+static LinkStatic<FileTokenFactory> g_FileTokenFactory;
 
 //===----------------------------------------------------------------------===//
 // FileToken
@@ -8,14 +8,13 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/NameSpec.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 namespace mcld {
 
 typedef GCFactory<NameSpec, MCLD_SYMBOLS_PER_INPUT> NameSpecFactory;
-static llvm::ManagedStatic<NameSpecFactory> g_NameSpecFactory;
+static LinkStatic<NameSpecFactory> g_NameSpecFactory;
 
 //===----------------------------------------------------------------------===//
 // NameSpec
@@ -25,7 +25,7 @@
 
 namespace mcld {
 
-RpnEvaluator::RpnEvaluator(const Module& pModule,
+RpnEvaluator::RpnEvaluator(Module& pModule,
                            const TargetLDBackend& pBackend)
     : m_Module(pModule), m_Backend(pBackend) {
 }
@@ -84,6 +84,7 @@ bool RpnEvaluator::eval(const RpnExpr& pExpr, uint64_t& pResult) {
             // we set up symbol operand here.
             if (!opd->isDot()) {
               SymOperand* sym_opd = llvm::cast<SymOperand>(opd);
+              m_Module.getNamePool().import(sym_opd->name());
               const LDSymbol* symbol =
                   m_Module.getNamePool().findSymbol(sym_opd->name());
               if (symbol == NULL) {
@@ -8,19 +8,19 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/RpnExpr.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Script/ExprToken.h"
 #include "mcld/Script/Operand.h"
 #include "mcld/Script/Operator.h"
 #include "mcld/Support/GCFactory.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
 #include <llvm/Support/Casting.h>
 
 namespace mcld {
 
 typedef GCFactory<RpnExpr, MCLD_SYMBOLS_PER_INPUT> ExprFactory;
-static llvm::ManagedStatic<ExprFactory> g_ExprFactory;
+static LinkStatic<ExprFactory> g_ExprFactory;
 
 //===----------------------------------------------------------------------===//
 // RpnExpr
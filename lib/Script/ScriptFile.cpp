@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/ScriptFile.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/ADT/HashEntry.h"
 #include "mcld/ADT/HashTable.h"
 #include "mcld/ADT/StringHash.h"
@@ -31,7 +32,6 @@
 #include "mcld/InputTree.h"
 
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
 
 #include <cassert>
 
@@ -42,7 +42,7 @@ typedef HashEntry<std::string, void*, hash::StringCompare<std::string> >
 typedef HashTable<ParserStrEntry,
                   hash::StringHash<hash::DJB>,
                   EntryFactory<ParserStrEntry> > ParserStrPool;
-static llvm::ManagedStatic<ParserStrPool> g_ParserStrPool;
+static LinkStatic<ParserStrPool> g_ParserStrPool;
 
 //===----------------------------------------------------------------------===//
 // ScriptFile
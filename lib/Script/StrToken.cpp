@@ -8,14 +8,13 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/StrToken.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Support/GCFactory.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 namespace mcld {
 
 typedef GCFactory<StrToken, MCLD_SYMBOLS_PER_INPUT> StrTokenFactory;
-static llvm::ManagedStatic<StrTokenFactory> g_StrTokenFactory;
+static LinkStatic<StrTokenFactory> g_StrTokenFactory;
 
 //===----------------------------------------------------------------------===//
 // StrToken
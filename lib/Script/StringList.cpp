@@ -8,16 +8,15 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/StringList.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Script/StrToken.h"
 #include "mcld/Support/GCFactory.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
-
 namespace mcld {
 
 typedef GCFactory<StringList, MCLD_SYMBOLS_PER_INPUT> StringListFactory;
-static llvm::ManagedStatic<StringListFactory> g_StringListFactory;
+static LinkStatic<StringListFactory> g_StringListFactory;
 
 //===----------------------------------------------------------------------===//
 // StringList
@@ -8,41 +8,132 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Script/WildcardPattern.h"
 
+#include "mcld/LinkContext.h"
 #include "mcld/Support/GCFactory.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
+#include <algorithm>
 #include <cassert>
+#if !defined(MCLD_ON_WIN32)
+#include <fnmatch.h>
+#define fnmatch0(pattern, string) (fnmatch(pattern, string, 0) == 0)
+#else
+#include <windows.h>
+#include <shlwapi.h>
+#define fnmatch0(pattern, string) (PathMatchSpec(string, pattern) == true)
+#endif
 
 namespace mcld {
 
 typedef GCFactory<WildcardPattern, MCLD_SYMBOLS_PER_INPUT>
     WildcardPatternFactory;
-static llvm::ManagedStatic<WildcardPatternFactory> g_WildcardPatternFactory;
+static LinkStatic<WildcardPatternFactory> g_WildcardPatternFactory;
 
 //===----------------------------------------------------------------------===//
 // WildcardPattern
 //===----------------------------------------------------------------------===//
-WildcardPattern::WildcardPattern() : m_bIsPrefix(false) {
+WildcardPattern::WildcardPattern()
+    : m_MatchKind(MATCH_LITERAL),
+      m_PrefixSize(0),
+      m_LiteralBegin(0),
+      m_LiteralSize(0) {
 }
 
 WildcardPattern::WildcardPattern(const std::string& pPattern,
                                  SortPolicy pPolicy)
     : StrToken(StrToken::Wildcard, pPattern), m_SortPolicy(pPolicy) {
-  if (pPattern.find_first_of('*') == (pPattern.size() - 1))
-    m_bIsPrefix = true;
-  else
-    m_bIsPrefix = false;
+  compile();
 }
 
 WildcardPattern::~WildcardPattern() {
 }
 
+void WildcardPattern::compile() {
+  llvm::StringRef pattern(name());
+  m_PrefixSize = std::min(pattern.find_first_of("*?[\\"), pattern.size());
+  m_LiteralBegin = 0;
+  m_LiteralSize = pattern.size();
+
+  if (pattern.find_first_of("[\\") != llvm::StringRef::npos) {
+    m_MatchKind = MATCH_FNMATCH;
+    return;
+  }
+
+  size_t first = pattern.find_first_of("*?");
+  if (first == llvm::StringRef::npos) {
+    m_MatchKind = MATCH_LITERAL;
+    return;
+  }
+
+  // the stars at both ends of a pattern with only one run of literal
+  // characters
+  llvm::StringRef literal = pattern.trim('*');
+  if (literal.find_first_of("*?") == llvm::StringRef::npos) {
+    bool leading = pattern.startswith("*");
+    bool trailing = pattern.endswith("*");
+    if (leading && trailing)
+      m_MatchKind = MATCH_CONTAINS;
+    else if (leading)
+      m_MatchKind = MATCH_SUFFIX;
+    else
+      m_MatchKind = MATCH_PREFIX;
+    m_LiteralBegin = literal.data() - pattern.data();
+    m_LiteralSize = literal.size();
+    return;
+  }
+
+  m_MatchKind = MATCH_GLOB;
+}
+
 llvm::StringRef WildcardPattern::prefix() const {
-  if (isPrefix())
-    return llvm::StringRef(name().c_str(), name().size() - 1);
+  return llvm::StringRef(name().data(), m_PrefixSize);
+}
+
+bool WildcardPattern::matches(llvm::StringRef pName) const {
+  llvm::StringRef literal(name().data() + m_LiteralBegin, m_LiteralSize);
+  switch (m_MatchKind) {
+    case MATCH_LITERAL:
+      return pName == literal;
+    case MATCH_PREFIX:
+      return pName.startswith(literal);
+    case MATCH_SUFFIX:
+      return pName.endswith(literal);
+    case MATCH_CONTAINS:
+      return pName.find(literal) != llvm::StringRef::npos;
+    case MATCH_GLOB:
+      return globMatch(name(), pName);
+    case MATCH_FNMATCH:
+    default:
+      break;
+  }
+  return fnmatch0(name().c_str(), pName.str().c_str());
+}
 
-  return llvm::StringRef(name());
+bool WildcardPattern::globMatch(llvm::StringRef pPattern,
+                                llvm::StringRef pName) {
+  // a '*' matches as few characters as it can, and when the rest fails, the
+  // last '*' takes one more character. The earlier stars never have to be
+  // retried.
+  size_t pat = 0, str = 0;
+  size_t star = llvm::StringRef::npos, resume = 0;
+  while (str < pName.size()) {
+    if (pat < pPattern.size() && pPattern[pat] == '*') {
+      star = pat++;
+      resume = str;
+    } else if (pat < pPattern.size() &&
+               (pPattern[pat] == '?' || pPattern[pat] == pName[str])) {
+      ++pat;
+      ++str;
+    } else if (star != llvm::StringRef::npos) {
+      pat = star + 1;
+      str = ++resume;
+    } else {
+      return false;
+    }
+  }
+  while (pat < pPattern.size() && pPattern[pat] == '*')
+    ++pat;
+  return pat == pPattern.size();
 }
 
 WildcardPattern* WildcardPattern::create(const std::string& pPattern,
@@ -46,4 +46,9 @@ size_t MemoryArea::size() const {
   return m_pMemoryBuffer->getBufferSize();
 }
 
+bool MemoryArea::contains(llvm::StringRef pRegion) const {
+  return (pRegion.begin() >= m_pMemoryBuffer->getBufferStart() &&
+          pRegion.end() <= m_pMemoryBuffer->getBufferEnd());
+}
+
 }  // namespace mcld
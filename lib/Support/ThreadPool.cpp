@@ -0,0 +1,98 @@
+//===- ThreadPool.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/ThreadPool.h"
+
+#include <cassert>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// ThreadPool
+//===----------------------------------------------------------------------===//
+ThreadPool::ThreadPool(unsigned int pNumThreads)
+    : m_NumOfActive(0), m_bStop(false) {
+  assert(pNumThreads > 0 && "a thread pool needs at least one worker");
+  m_Workers.reserve(pNumThreads);
+  for (unsigned int i = 0; i < pNumThreads; ++i)
+    m_Workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_bStop = true;
+  }
+  m_TaskCond.notify_all();
+
+  std::vector<std::thread>::iterator worker, wEnd = m_Workers.end();
+  for (worker = m_Workers.begin(); worker != wEnd; ++worker)
+    worker->join();
+}
+
+void ThreadPool::async(const Task& pTask) {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Tasks.push_back(pTask);
+  }
+  m_TaskCond.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (!m_Tasks.empty() || m_NumOfActive != 0)
+    m_DoneCond.wait(lock);
+}
+
+void ThreadPool::parallelFor(size_t pBegin,
+                             size_t pEnd,
+                             const IndexedTask& pTask,
+                             size_t pGrainSize) {
+  if (pGrainSize == 0)
+    pGrainSize = 1;
+
+  for (size_t begin = pBegin; begin < pEnd; begin += pGrainSize) {
+    size_t end = begin + pGrainSize;
+    if (end > pEnd)
+      end = pEnd;
+    async([&pTask, begin, end]() {
+      for (size_t idx = begin; idx < end; ++idx)
+        pTask(idx);
+    });
+  }
+  wait();
+}
+
+void ThreadPool::work() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      while (!m_bStop && m_Tasks.empty())
+        m_TaskCond.wait(lock);
+
+      if (m_bStop && m_Tasks.empty())
+        return;
+
+      task = m_Tasks.front();
+      m_Tasks.pop_front();
+      ++m_NumOfActive;
+    }
+
+    task();
+
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      --m_NumOfActive;
+      if (m_Tasks.empty() && m_NumOfActive == 0)
+        m_DoneCond.notify_all();
+    }
+  }
+}
+
+}  // namespace mcld
@@ -0,0 +1,195 @@
+//===- TimeTrace.cpp ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/TimeTrace.h"
+
+#include "mcld/LinkContext.h"
+#include "mcld/Support/SystemUtils.h"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cassert>
+#include <chrono>
+#include <map>
+
+namespace mcld {
+
+static void printJSONString(llvm::raw_ostream& pOS, llvm::StringRef pStr) {
+  pOS << '"';
+  for (size_t i = 0; i < pStr.size(); ++i) {
+    unsigned char c = pStr[i];
+    switch (c) {
+      case '"':
+        pOS << "\\\"";
+        break;
+      case '\\':
+        pOS << "\\\\";
+        break;
+      case '\n':
+        pOS << "\\n";
+        break;
+      case '\t':
+        pOS << "\\t";
+        break;
+      default:
+        if (c < 0x20)
+          pOS << llvm::format("\\u%04x", c);
+        else
+          pOS << c;
+        break;
+    }
+  }
+  pOS << '"';
+}
+
+//===----------------------------------------------------------------------===//
+// TimeTrace::Scope
+//===----------------------------------------------------------------------===//
+TimeTrace::Scope::Scope(llvm::StringRef pName, llvm::StringRef pDetail)
+    : m_pTrace(NULL) {
+  TimeTrace& trace = TimeTrace::current();
+  if (trace.isEnabled()) {
+    m_pTrace = &trace;
+    m_pTrace->begin(pName, pDetail);
+  }
+}
+
+TimeTrace::Scope::~Scope() {
+  if (m_pTrace != NULL)
+    m_pTrace->end();
+}
+
+//===----------------------------------------------------------------------===//
+// TimeTrace
+//===----------------------------------------------------------------------===//
+TimeTrace::TimeTrace() : m_bEnabled(false), m_Origin(0) {
+}
+
+TimeTrace& TimeTrace::current() {
+  return LinkContext::current().get<TimeTrace>();
+}
+
+void TimeTrace::enable() {
+  if (m_bEnabled)
+    return;
+  m_bEnabled = true;
+  m_Origin = now();
+}
+
+void TimeTrace::begin(llvm::StringRef pName, llvm::StringRef pDetail) {
+  Event event;
+  event.name = pName;
+  event.detail = pDetail;
+  event.start = now() - m_Origin;
+  event.wall = 0;
+  event.cpu = 0;
+  event.rss_delta = 0;
+  event.depth = m_Stack.size();
+
+  OpenEvent open;
+  open.index = m_Events.size();
+  open.cpu = sys::GetProcessCPUTime();
+  open.rss = sys::GetResidentSetSize();
+
+  m_Events.push_back(event);
+  m_Stack.push_back(open);
+}
+
+void TimeTrace::end() {
+  assert(!m_Stack.empty() && "unbalanced TimeTrace::end()");
+  OpenEvent open = m_Stack.back();
+  m_Stack.pop_back();
+
+  Event& event = m_Events[open.index];
+  event.wall = now() - m_Origin - event.start;
+  event.cpu = sys::GetProcessCPUTime() - open.cpu;
+  event.rss_delta = static_cast<int64_t>(sys::GetResidentSetSize()) -
+                    static_cast<int64_t>(open.rss);
+}
+
+uint64_t TimeTrace::now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TimeTrace::printJSON(llvm::raw_ostream& pOS) const {
+  pOS << "{\"traceEvents\":[\n";
+  EventList::const_iterator event, evEnd = m_Events.end();
+  for (event = m_Events.begin(); event != evEnd; ++event) {
+    if (event != m_Events.begin())
+      pOS << ",\n";
+    pOS << "{\"name\":";
+    printJSONString(pOS, event->name);
+    pOS << ",\"cat\":\"mcld\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+        << ",\"ts\":" << event->start << ",\"dur\":" << event->wall
+        << ",\"args\":{\"cpu_us\":" << event->cpu
+        << ",\"rss_delta_bytes\":" << event->rss_delta;
+    if (!event->detail.empty()) {
+      pOS << ",\"detail\":";
+      printJSONString(pOS, event->detail);
+    }
+    pOS << "}}";
+  }
+  pOS << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void TimeTrace::printSummary(llvm::raw_ostream& pOS) const {
+  struct Row {
+    llvm::StringRef name;
+    unsigned int depth;
+    unsigned int count;
+    uint64_t wall;
+    uint64_t cpu;
+    int64_t rss_delta;
+  };
+
+  // merge the events by their path in the phase tree, in order of first
+  // appearance
+  std::vector<Row> rows;
+  std::map<std::string, size_t> row_of_path;
+  std::vector<std::string> path;
+  EventList::const_iterator event, evEnd = m_Events.end();
+  for (event = m_Events.begin(); event != evEnd; ++event) {
+    path.resize(event->depth);
+    std::string key = path.empty() ? std::string() : path.back();
+    key += '/';
+    key += event->name;
+    path.push_back(key);
+
+    std::map<std::string, size_t>::iterator entry = row_of_path.find(key);
+    if (entry == row_of_path.end()) {
+      Row row = { event->name, event->depth, 0, 0, 0, 0 };
+      entry = row_of_path.insert(std::make_pair(key, rows.size())).first;
+      rows.push_back(row);
+    }
+    Row& row = rows[entry->second];
+    ++row.count;
+    row.wall += event->wall;
+    row.cpu += event->cpu;
+    row.rss_delta += event->rss_delta;
+  }
+
+  pOS << "===-------------------------------------------------------------"
+         "------------===\n"
+      << "                          MCLinker Time Trace\n"
+      << "===-------------------------------------------------------------"
+         "------------===\n"
+      << "   Wall (ms)    CPU (ms)  RSS delta (KB)  Count  Phase\n";
+  std::vector<Row>::const_iterator row, rowEnd = rows.end();
+  for (row = rows.begin(); row != rowEnd; ++row) {
+    pOS << llvm::format("%12.3f%12.3f%16lld%7u  ",
+                        row->wall / 1000.0,
+                        row->cpu / 1000.0,
+                        static_cast<long long>(row->rss_delta / 1024),
+                        row->count);
+    pOS.indent(row->depth * 2) << row->name << "\n";
+  }
+}
+
+}  // namespace mcld
@@ -77,8 +77,11 @@ Relocator::Result AArch64Relocator::applyRelocation(Relocation& pRelocation) {
       (type != R_AARCH64_REWRITE_INSN)) {
     return Relocator::Unknown;
   }
-  assert(ApplyFunctions.find(type) != ApplyFunctions.end());
-  return ApplyFunctions[type].func(pRelocation, *this);
+  // look up without operator[], which may insert, so that concurrent
+  // applications only read the table.
+  ApplyFunctionMap::const_iterator entry = ApplyFunctions.find(type);
+  assert(entry != ApplyFunctions.end());
+  return entry->second.func(pRelocation, *this);
 }
 
 const char* AArch64Relocator::getName(Relocator::Type pType) const {
@@ -426,6 +429,47 @@ AArch64Relocator::mayHaveFunctionPointerAccess(const Relocation& pReloc) const {
   return false;
 }
 
+bool AArch64Relocator::needsScan(const Relocation& pReloc,
+                                 const LDSection& pSection) const {
+  // scanRelocation() bypasses non-ALLOC sections
+  if (pSection.getLink() == NULL)
+    return true;
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return false;
+
+  // undefined references are reported during the scan
+  const ResolveInfo* rsym = pReloc.symInfo();
+  if (rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() && !rsym->isNull())
+    return true;
+
+  if (!rsym->isLocal())
+    return true;
+
+  // see scanLocalReloc()
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_ABS64:
+    case llvm::ELF::R_AARCH64_ABS32:
+    case llvm::ELF::R_AARCH64_ABS16:
+      return config().isCodeIndep();
+    case llvm::ELF::R_AARCH64_ADR_GOT_PAGE:
+    case llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool AArch64Relocator::mayApplyConcurrently(const Relocation& pReloc) const {
+  switch (pReloc.type()) {
+    // these fill the GOT entry shared by all references to the symbol.
+    case llvm::ELF::R_AARCH64_ADR_GOT_PAGE:
+    case llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC:
+      return false;
+    default:
+      return true;
+  }
+}
+
 uint32_t AArch64Relocator::getDebugStringOffset(Relocation& pReloc) const {
   if (pReloc.type() != llvm::ELF::R_AARCH64_ABS32)
     error(diag::unsupport_reloc_for_debug_string)
@@ -29,6 +29,7 @@
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/RelocationFactory.h"
+#include "mcld/LD/StringTableBuilder.h"
 #include "mcld/LD/StubFactory.h"
 #include "mcld/MC/Attribute.h"
 #include "mcld/Object/ObjectBuilder.h"
@@ -38,6 +39,7 @@
 #include "mcld/Script/RpnEvaluator.h"
 #include "mcld/Support/FileOutputBuffer.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/ELFAttribute.h"
 #include "mcld/Target/ELFDynamic.h"
 #include "mcld/Target/GNUInfo.h"
@@ -86,6 +88,9 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
       m_pELFSegmentTable(NULL),
       m_pBRIslandFactory(NULL),
       m_pStubFactory(NULL),
+      m_pStrTab(NULL),
+      m_pDynStrTab(NULL),
+      m_pShStrTab(NULL),
       m_pEhFrameHdr(NULL),
       m_pAttribute(NULL),
       m_bHasTextRel(false),
@@ -121,6 +126,9 @@ GNULDBackend::~GNULDBackend() {
   delete m_pExecFileFormat;
   delete m_pObjectFileFormat;
   delete m_pSymIndexMap;
+  delete m_pStrTab;
+  delete m_pDynStrTab;
+  delete m_pShStrTab;
   delete m_pEhFrameHdr;
   delete m_pAttribute;
   delete m_pBRIslandFactory;
@@ -697,13 +705,14 @@ const ELFFileFormat* GNULDBackend::getOutputFormat() const {
 
 /// sizeShstrtab - compute the size of .shstrtab
 void GNULDBackend::sizeShstrtab(Module& pModule) {
-  size_t shstrtab = 0;
-  // compute the size of .shstrtab section.
+  // the section names share their suffixes, such as .rela.text and .text
+  delete m_pShStrTab;
+  m_pShStrTab = new StringTableBuilder(/*pTailMerge*/ true);
   Module::const_iterator sect, sectEnd = pModule.end();
   for (sect = pModule.begin(); sect != sectEnd; ++sect) {
-    shstrtab += (*sect)->name().size() + 1;
+    m_pShStrTab->add((*sect)->name());
   }  // end of for
-  getOutputFormat()->getShStrTab().setSize(shstrtab);
+  getOutputFormat()->getShStrTab().setSize(m_pShStrTab->finalize());
 }
 
 /// sizeNamePools - compute the size of regular name pools
@@ -717,10 +726,14 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
   size_t symtab = 1;
   size_t dynsym = config().isCodeStatic() ? 0 : 1;
 
-  // size of string tables starts from 1 to hold the null character in their
-  // first byte
-  size_t strtab = 1;
-  size_t dynstr = config().isCodeStatic() ? 0 : 1;
+  // the string tables keep every name once, after the null character in
+  // their first byte
+  size_t strtab = 0;
+  size_t dynstr = 0;
+  delete m_pStrTab;
+  delete m_pDynStrTab;
+  m_pStrTab = new StringTableBuilder(config().options().tailMergeStrings());
+  m_pDynStrTab = new StringTableBuilder(/*pTailMerge*/ true);
   size_t hash = 0;
   size_t gnuhash = 0;
 
@@ -745,9 +758,12 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
       symEnd = symbols.end();
       for (symbol = symbols.begin(); symbol != symEnd; ++symbol) {
         ++symtab;
-        if (hasEntryInStrTab(**symbol))
-          strtab += (*symbol)->nameSize() + 1;
+        if (hasEntryInStrTab(**symbol)) {
+          m_pStrTab->add(
+              llvm::StringRef((*symbol)->name(), (*symbol)->nameSize()));
+        }
       }
+      strtab = m_pStrTab->finalize();
       symtab_local_cnt = 1 + symbols.numOfFiles() + symbols.numOfLocals() +
                          symbols.numOfLocalDyns();
       break;
@@ -757,11 +773,7 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
   ELFFileFormat* file_format = getOutputFormat();
 
   switch (config().codeGenType()) {
-    case LinkerConfig::DynObj: {
-      // soname
-      dynstr += config().options().soname().size() + 1;
-    }
-    /** fall through **/
+    case LinkerConfig::DynObj:
     case LinkerConfig::Exec:
     case LinkerConfig::Binary: {
       if (!config().isCodeStatic()) {
@@ -769,8 +781,10 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
         symEnd = symbols.dynamicEnd();
         for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
           ++dynsym;
-          if (hasEntryInStrTab(**symbol))
-            dynstr += (*symbol)->nameSize() + 1;
+          if (hasEntryInStrTab(**symbol)) {
+            m_pDynStrTab->add(
+                llvm::StringRef((*symbol)->name(), (*symbol)->nameSize()));
+          }
         }
         dynsym_local_cnt = 1 + symbols.numOfLocalDyns();
 
@@ -804,20 +818,30 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
         Module::const_lib_iterator lib, libEnd = pModule.lib_end();
         for (lib = pModule.lib_begin(); lib != libEnd; ++lib) {
           if (!(*lib)->attribute()->isAsNeeded() || (*lib)->isNeeded()) {
-            dynstr += (*lib)->name().size() + 1;
+            m_pDynStrTab->add((*lib)->name());
             dynamic().reserveNeedEntry();
           }
         }
 
+        // soname
+        if (LinkerConfig::DynObj == config().codeGenType())
+          m_pDynStrTab->add(config().options().soname());
+
         // add DT_RPATH
+        m_DynRPath.clear();
         if (!config().options().getRpathList().empty()) {
           dynamic().reserveNeedEntry();
           GeneralOptions::const_rpath_iterator rpath,
               rpathEnd = config().options().rpath_end();
           for (rpath = config().options().rpath_begin(); rpath != rpathEnd;
-               ++rpath)
-            dynstr += (*rpath).size() + 1;
+               ++rpath) {
+            if (rpath != config().options().rpath_begin())
+              m_DynRPath += ':';
+            m_DynRPath += *rpath;
+          }
+          m_pDynStrTab->add(m_DynRPath);
         }
+        dynstr = m_pDynStrTab->finalize();
 
         // set size
         if (config().targets().is32Bits()) {
@@ -954,7 +978,6 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
   }
 
   size_t symIdx = 1;
-  size_t strtabsize = 1;
 
   const Module::SymbolTable& symbols = pModule.getSymbolTable();
   Module::const_sym_iterator symbol, symEnd;
@@ -965,14 +988,20 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
       entry = m_pSymIndexMap->insert(*symbol, sym_exist);
       entry->setValue(symIdx);
     }
+    // the stubs of relaxation are added after sizeNamePools(), and their
+    // room is reserved by the target
+    size_t strtabsize = 0;
+    if (hasEntryInStrTab(**symbol)) {
+      strtabsize = m_pStrTab->append(
+          llvm::StringRef((*symbol)->name(), (*symbol)->nameSize()));
+    }
     if (config().targets().is32Bits())
       emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
     else
       emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
+  assert(m_pStrTab->size() <= strtab_sect.size());
 }
 
 /// emitDynNamePools - emit dynamic name pools - .dyntab, .dynstr, .hash
@@ -1020,7 +1049,6 @@ void GNULDBackend::emitDynNamePools(Module& pModule,
     emitSymbol64(symtab64[0], *LDSymbol::Null(), strtab, 0, 0);
 
   size_t symIdx = 1;
-  size_t strtabsize = 1;
 
   Module::SymbolTable& symbols = pModule.getSymbolTable();
   // emit .gnu.hash
@@ -1034,6 +1062,13 @@ void GNULDBackend::emitDynNamePools(Module& pModule,
   // emit .dynsym, and .dynstr (emit LocalDyn and Dynamic category)
   Module::const_sym_iterator symbol, symEnd = symbols.dynamicEnd();
   for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
+    // the symbols may be sorted after sizeNamePools(), so the names are
+    // looked up by themselves
+    size_t strtabsize = 0;
+    if (hasEntryInStrTab(**symbol)) {
+      strtabsize = m_pDynStrTab->append(
+          llvm::StringRef((*symbol)->name(), (*symbol)->nameSize()));
+    }
     if (config().targets().is32Bits())
       emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
     else
@@ -1043,8 +1078,6 @@ void GNULDBackend::emitDynNamePools(Module& pModule,
     entry->setValue(symIdx);
     // sum up counters
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 
   // emit DT_NEED
@@ -1053,51 +1086,50 @@ void GNULDBackend::emitDynNamePools(Module& pModule,
   Module::const_lib_iterator lib, libEnd = pModule.lib_end();
   for (lib = pModule.lib_begin(); lib != libEnd; ++lib) {
     if (!(*lib)->attribute()->isAsNeeded() || (*lib)->isNeeded()) {
+      size_t strtabsize = m_pDynStrTab->getOffset((*lib)->name());
       ::memcpy((strtab + strtabsize),
                (*lib)->name().c_str(),
                (*lib)->name().size());
       (*dt_need)->setValue(llvm::ELF::DT_NEEDED, strtabsize);
-      strtabsize += (*lib)->name().size() + 1;
       ++dt_need;
     }
   }
 
   if (!config().options().getRpathList().empty()) {
+    size_t strtabsize = m_pDynStrTab->getOffset(m_DynRPath);
     if (!config().options().hasNewDTags())
       (*dt_need)->setValue(llvm::ELF::DT_RPATH, strtabsize);
     else
       (*dt_need)->setValue(llvm::ELF::DT_RUNPATH, strtabsize);
     ++dt_need;
-
-    GeneralOptions::const_rpath_iterator rpath,
-        rpathEnd = config().options().rpath_end();
-    for (rpath = config().options().rpath_begin(); rpath != rpathEnd; ++rpath) {
-      memcpy((strtab + strtabsize), (*rpath).data(), (*rpath).size());
-      strtabsize += (*rpath).size();
-      strtab[strtabsize++] = (rpath + 1 == rpathEnd ? '\0' : ':');
-    }
+    memcpy((strtab + strtabsize), m_DynRPath.data(), m_DynRPath.size());
   }
+  assert(m_pDynStrTab->size() <= strtab_sect.size());
+
+  size_t soname = 0;
+  if (LinkerConfig::DynObj == config().codeGenType())
+    soname = m_pDynStrTab->getOffset(config().options().soname());
 
   // initialize value of ELF .dynamic section
   if (LinkerConfig::DynObj == config().codeGenType()) {
     // set pointer to SONAME entry in dynamic string table.
-    dynamic().applySoname(strtabsize);
+    dynamic().applySoname(soname);
   }
   dynamic().applyEntries(*file_format);
   dynamic().emit(dyn_sect, dyn_region);
 
   // emit soname
   if (LinkerConfig::DynObj == config().codeGenType()) {
-    ::memcpy((strtab + strtabsize),
+    ::memcpy((strtab + soname),
              config().options().soname().c_str(),
              config().options().soname().size());
-    strtabsize += config().options().soname().size() + 1;
   }
 }
 
 /// emitELFHashTab - emit .hash
 void GNULDBackend::emitELFHashTab(const Module::SymbolTable& pSymtab,
                                   FileOutputBuffer& pOutput) {
+  TimeTrace::Scope trace("emitELFHashTab");
   ELFFileFormat* file_format = getOutputFormat();
   if (!file_format->hasHashTab())
     return;
@@ -1120,13 +1152,10 @@ void GNULDBackend::emitELFHashTab(const Module::SymbolTable& pSymtab,
   // initialize bucket
   memset(reinterpret_cast<void*>(bucket), 0, nbucket);
 
-  hash::StringHash<hash::ELF> hash_func;
-
   size_t idx = 1;
   Module::const_sym_iterator symbol, symEnd = pSymtab.dynamicEnd();
   for (symbol = pSymtab.localDynBegin(); symbol != symEnd; ++symbol) {
-    llvm::StringRef name((*symbol)->name());
-    size_t bucket_pos = hash_func(name) % nbucket;
+    size_t bucket_pos = (*symbol)->resolveInfo()->elfHash() % nbucket;
     chain[idx] = bucket[bucket_pos];
     bucket[bucket_pos] = idx;
     ++idx;
@@ -1136,6 +1165,7 @@ void GNULDBackend::emitELFHashTab(const Module::SymbolTable& pSymtab,
 /// emitGNUHashTab - emit .gnu.hash
 void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
                                   FileOutputBuffer& pOutput) {
+  TimeTrace::Scope trace("emitGNUHashTab");
   ELFFileFormat* file_format = getOutputFormat();
   if (!file_format->hasGNUHashTab())
     return;
@@ -1207,8 +1237,7 @@ void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
   symEnd = pSymtab.dynamicEnd();
   for (symbol = pSymtab.localDynBegin() + symidx - 1; symbol != symEnd;
        ++symbol) {
-    hash::StringHash<hash::DJB> hasher;
-    uint32_t djbhash = hasher((*symbol)->name());
+    uint32_t djbhash = (*symbol)->resolveInfo()->gnuHash();
     uint32_t hash = djbhash % nbucket;
     symmap.insert(std::make_pair(hash, std::make_pair(*symbol, djbhash)));
   }
@@ -2449,7 +2478,7 @@ void GNULDBackend::layout(Module& pModule) {
 
   // 2. update output sections in Module
   SectionMap& sectionMap = pModule.getScript().sectionMap();
-  pModule.getSectionTable().clear();
+  pModule.clearSections();
   for (SectionMap::iterator out = sectionMap.begin(), outEnd = sectionMap.end();
        out != outEnd;
        ++out) {
@@ -2458,7 +2487,7 @@ void GNULDBackend::layout(Module& pModule) {
         (*out)->getSection()->kind() == LDFileFormat::StackNote ||
         config().codeGenType() == LinkerConfig::Object) {
       (*out)->getSection()->setIndex(pModule.size());
-      pModule.getSectionTable().push_back((*out)->getSection());
+      pModule.addSection(*(*out)->getSection());
     }
   }  // for each output section description
 
@@ -2527,7 +2556,7 @@ void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder) {
               (*rs)->name(), (*rs)->kind(), (*rs)->type(), (*rs)->flag());
 
           output_sect->setAlign((*rs)->align());
-          pModule.getSectionTable().push_back(output_sect);
+          pModule.addSection(*output_sect);
         }
 
         // set output relocation section link
@@ -2915,10 +2944,12 @@ bool GNULDBackend::relax(Module& pModule, IRBuilder& pBuilder) {
   if (!mayRelax())
     return true;
 
+  TimeTrace::Scope trace("relax");
   getBRIslandFactory()->group(pModule);
 
   bool finished = true;
   do {
+    TimeTrace::Scope iteration("doRelax");
     if (doRelax(pModule, pBuilder, finished)) {
       setOutputSectionAddress(pModule);
     }
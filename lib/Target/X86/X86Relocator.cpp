@@ -1286,6 +1286,45 @@ bool X86_64Relocator::mayHaveFunctionPointerAccess(
   }
 }
 
+bool X86_64Relocator::mayApplyConcurrently(const Relocation& pReloc) const {
+  // R_X86_64_GOTPCREL fills the GOT entry shared by all references to the
+  // symbol, so it has to be applied in order.
+  return (pReloc.type() != llvm::ELF::R_X86_64_GOTPCREL);
+}
+
+bool X86_64Relocator::needsScan(const Relocation& pReloc,
+                                const LDSection& pSection) const {
+  // scanRelocation() bypasses non-ALLOC sections
+  if (pSection.getLink() == NULL)
+    return true;
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return false;
+
+  // undefined references are reported during the scan
+  const ResolveInfo* rsym = pReloc.symInfo();
+  if (rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() && !rsym->isNull())
+    return true;
+
+  if (!rsym->isLocal())
+    return true;
+
+  // see scanLocalReloc()
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_PC32:
+    case llvm::ELF::R_X86_64_PC16:
+    case llvm::ELF::R_X86_64_PC8:
+      return false;
+    case llvm::ELF::R_X86_64_64:
+    case llvm::ELF::R_X86_64_32:
+    case llvm::ELF::R_X86_64_16:
+    case llvm::ELF::R_X86_64_8:
+    case llvm::ELF::R_X86_64_32S:
+      return config().isCodeIndep();
+    default:
+      return true;
+  }
+}
+
 void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
                                      IRBuilder& pBuilder,
                                      Module& pModule,
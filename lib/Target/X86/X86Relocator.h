@@ -213,6 +213,14 @@ class X86_64Relocator : public X86Relocator {
   /// access a function pointer.
   virtual bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
 
+  /// mayApplyConcurrently - check if the given reloc can be applied on a
+  /// worker thread.
+  virtual bool mayApplyConcurrently(const Relocation& pReloc) const;
+
+  /// needsScan - check if scanRelocation() may reserve entries for pReloc.
+  virtual bool needsScan(const Relocation& pReloc,
+                         const LDSection& pSection) const;
+
   /// getDebugStringOffset - get the offset from the relocation target. This is
   /// used to get the debug string offset.
   uint32_t getDebugStringOffset(Relocation& pReloc) const;
@@ -0,0 +1,15 @@
+; A member included late needs a member which comes earlier in the armap of
+; the same archive, so the members are found only after the scan wraps
+; around: _start needs back_d, back_d needs back_b, back_b needs back_c and
+; back_c needs back_a. The members are laid out in the order of inclusion.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu \
+; RUN: %p/worklist/worklist_main.o %p/worklist/libback.a -o %t.out
+; RUN: readelf -s -W %t.out | awk '$4 == "FUNC" {print $2, $8}' | sort \
+; RUN: | FileCheck %s
+
+; CHECK: _start
+; CHECK-NEXT: back_d
+; CHECK-NEXT: back_b
+; CHECK-NEXT: back_c
+; CHECK-NEXT: back_a
+; CHECK-NOT: back_unused
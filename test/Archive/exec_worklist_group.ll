@@ -0,0 +1,15 @@
+; A member of the second archive of a group needs a member of the first
+; archive, which needs another member of the second one again.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu \
+; RUN: %p/worklist/group_main.o \
+; RUN: --start-group %p/worklist/libgroup_a.a %p/worklist/libgroup_b.a \
+; RUN: --end-group -o %t.out
+; RUN: readelf -s -W %t.out | awk '$4 == "FUNC" {print $2, $8}' | sort \
+; RUN: | FileCheck %s
+
+; CHECK: _start
+; CHECK-NEXT: group_b1
+; CHECK-NEXT: group_a1
+; CHECK-NEXT: group_b2
+; CHECK-NOT: group_a2
+; CHECK-NOT: group_b3
@@ -0,0 +1,7 @@
+# Needed by back_d, which comes after it in the armap.
+        .text
+        .globl  back_b
+        .type   back_b,@function
+back_b:
+        call    back_c
+        ret
@@ -0,0 +1,7 @@
+# Needed by back_b, and needs back_a, which comes before it in the armap.
+        .text
+        .globl  back_c
+        .type   back_c,@function
+back_c:
+        call    back_a
+        ret
@@ -0,0 +1,7 @@
+# A member of libback.a which nothing needs.
+        .text
+        .globl  back_unused
+        .type   back_unused,@function
+back_unused:
+        call    back_a
+        ret
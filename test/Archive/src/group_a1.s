@@ -0,0 +1,7 @@
+# A member of libgroup_a.a, needed by group_b1 of libgroup_b.a.
+        .text
+        .globl  group_a1
+        .type   group_a1,@function
+group_a1:
+        call    group_b2
+        ret
@@ -0,0 +1,6 @@
+# A member of libgroup_a.a which nothing needs.
+        .text
+        .globl  group_a2
+        .type   group_a2,@function
+group_a2:
+        ret
@@ -0,0 +1,7 @@
+# A member of libgroup_b.a, needed by _start.
+        .text
+        .globl  group_b1
+        .type   group_b1,@function
+group_b1:
+        call    group_a1
+        ret
@@ -0,0 +1,6 @@
+# A member of libgroup_b.a, needed by group_a1 of libgroup_a.a.
+        .text
+        .globl  group_b2
+        .type   group_b2,@function
+group_b2:
+        ret
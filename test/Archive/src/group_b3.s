@@ -0,0 +1,7 @@
+# A member of libgroup_b.a which nothing needs.
+        .text
+        .globl  group_b3
+        .type   group_b3,@function
+group_b3:
+        call    group_a2
+        ret
@@ -0,0 +1,7 @@
+# _start refers a member of libgroup_b.a only.
+        .text
+        .globl  _start
+        .type   _start,@function
+_start:
+        call    group_b1
+        ret
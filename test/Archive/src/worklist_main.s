@@ -0,0 +1,7 @@
+# _start refers the last member of libback.a only.
+        .text
+        .globl  _start
+        .type   _start,@function
+_start:
+        call    back_d
+        ret
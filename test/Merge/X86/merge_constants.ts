@@ -0,0 +1,17 @@
+; The constants of .rodata.cst8 from two inputs are kept once, and the
+; symbols and the relocations against the section symbols are moved to them.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+; RUN: %p/obj/constants_a.o %p/obj/constants_b.o -o %t.so
+; RUN: readelf -x .rodata %t.so | FileCheck %s -check-prefix=DATA
+; RUN: readelf -r -s -W %t.so | FileCheck %s
+
+; the constants 1, 2 and 3, in 24 bytes
+; DATA: 0x{{[0-9a-f]+}} 01000000 00000000 02000000 00000000
+; DATA-NEXT: 0x{{[0-9a-f]+}} 03000000 00000000 ........{{ *$}}
+
+; both ptr_a and ptr_b refer to the constant 2 by the section symbols
+; CHECK: R_X86_64_RELATIVE {{ *}}[[TWO:[0-9a-f]+]]
+; CHECK: R_X86_64_RELATIVE {{ *}}[[TWO]]
+; CHECK: Symbol table '.symtab'
+; CHECK-DAG: {{0*}}[[TWO]] {{.*}} two_a
+; CHECK-DAG: {{0*}}[[TWO]] {{.*}} two_b
@@ -0,0 +1,20 @@
+; The strings of .rodata.str1.1 from two inputs are kept once, and the
+; symbols and the relocations against the section symbols are moved to them.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+; RUN: %p/obj/strings_a.o %p/obj/strings_b.o -o %t.so
+; RUN: readelf -p .rodata %t.so | FileCheck %s -check-prefix=STR
+; RUN: readelf -r -s -W %t.so | FileCheck %s
+
+; STR: [     0]  hello
+; STR-NEXT: [     6]  world
+; STR-NEXT: [     c]  linker
+; STR-NOT: {{[a-z]}}
+
+; ptr_a refers to "world" and ptr_b refers to "hello" by the section symbols
+; CHECK: R_X86_64_RELATIVE {{ *}}[[WORLD:[0-9a-f]+]]
+; CHECK: R_X86_64_RELATIVE {{ *}}[[HELLO:[0-9a-f]+]]
+; CHECK: Symbol table '.symtab'
+; CHECK-DAG: {{0*}}[[HELLO]] {{.*}} hello_a
+; CHECK-DAG: {{0*}}[[WORLD]] {{.*}} world_a
+; CHECK-DAG: {{0*}}[[WORLD]] {{.*}} world_b
+; CHECK-DAG: {{0*}}[[HELLO]] {{.*}} hello_b
@@ -0,0 +1,14 @@
+# The constants of .rodata.cst8, one of which is also in constants_b.s
+        .section .rodata.cst8,"aM",@progbits,8
+        .p2align 3
+        .globl  one_a
+one_a:
+        .quad   1
+        .globl  two_a
+two_a:
+        .quad   2
+
+        .data
+        .globl  ptr_a
+ptr_a:
+        .quad   .rodata.cst8+8
@@ -0,0 +1,14 @@
+# The constants of .rodata.cst8, one of which is also in constants_a.s
+        .section .rodata.cst8,"aM",@progbits,8
+        .p2align 3
+        .globl  three_b
+three_b:
+        .quad   3
+        .globl  two_b
+two_b:
+        .quad   2
+
+        .data
+        .globl  ptr_b
+ptr_b:
+        .quad   .rodata.cst8+8
@@ -0,0 +1,13 @@
+# The strings of .rodata.str1.1, some of which are also in strings_b.s
+        .section .rodata.str1.1,"aMS",@progbits,1
+        .globl  hello_a
+hello_a:
+        .asciz  "hello"
+        .globl  world_a
+world_a:
+        .asciz  "world"
+
+        .data
+        .globl  ptr_a
+ptr_a:
+        .quad   .rodata.str1.1+6
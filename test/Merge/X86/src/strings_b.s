@@ -0,0 +1,16 @@
+# The strings of .rodata.str1.1, some of which are also in strings_a.s
+        .section .rodata.str1.1,"aMS",@progbits,1
+        .globl  world_b
+world_b:
+        .asciz  "world"
+        .globl  linker_b
+linker_b:
+        .asciz  "linker"
+        .globl  hello_b
+hello_b:
+        .asciz  "hello"
+
+        .data
+        .globl  ptr_b
+ptr_b:
+        .quad   .rodata.str1.1+13
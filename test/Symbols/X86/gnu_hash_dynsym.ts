@@ -0,0 +1,18 @@
+; The symbols of .dynsym are sorted for .gnu.hash after .dynstr is laid out,
+; so every name must still point to its own string.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared --hash-style=gnu \
+; RUN: -soname=libgnu_hash.so %p/obj/gnu_hash.o -o %t.so
+; RUN: readelf --dyn-syms -W %t.so | FileCheck %s
+; RUN: readelf -d -W %t.so | FileCheck %s -check-prefix=SONAME
+
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} printf_chk{{$}}
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} chk{{$}}
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} vprintf_chk{{$}}
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} alpha{{$}}
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} beta{{$}}
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} gamma{{$}}
+; CHECK-DAG: FUNC    GLOBAL DEFAULT {{.*}} delta{{$}}
+; CHECK-DAG: OBJECT  GLOBAL DEFAULT {{.*}} omega{{$}}
+; CHECK-DAG: NOTYPE  GLOBAL DEFAULT  UND undefined_f{{$}}
+
+; SONAME: (SONAME) {{.*}}[libgnu_hash.so]
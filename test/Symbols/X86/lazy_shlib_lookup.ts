@@ -0,0 +1,18 @@
+; The entry point, the symbols of -u and the symbols of script expressions are
+; looked up by name, so with --lazy-shlib-symbols they are imported from the
+; shared objects first, and the output is the same as if it read all symbols.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --no-lazy-shlib-symbols \
+; RUN: --gc-sections -e lib_entry -u lib_func --defsym=alias=lib_value \
+; RUN: %p/obj/lazy_main.o %p/obj/liblazy.so.1 -o %t.eager
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --lazy-shlib-symbols \
+; RUN: --gc-sections -e lib_entry -u lib_func --defsym=alias=lib_value \
+; RUN: %p/obj/lazy_main.o %p/obj/liblazy.so.1 -o %t.lazy
+; RUN: readelf -h %t.eager | grep Entry > %t.eager.entry
+; RUN: readelf -h %t.lazy | grep Entry > %t.lazy.entry
+; RUN: diff %t.eager.entry %t.lazy.entry
+; RUN: readelf -s -W %t.eager | grep " alias$" > %t.eager.alias
+; RUN: readelf -s -W %t.lazy | grep " alias$" > %t.lazy.alias
+; RUN: diff %t.eager.alias %t.lazy.alias
+; RUN: readelf -h %t.lazy | FileCheck %s
+
+; CHECK-NOT: Entry point address: 0x0{{$}}
@@ -0,0 +1,39 @@
+# The names share their suffixes, and the symbols of .dynsym are sorted by
+# the buckets of .gnu.hash after .dynstr is laid out.
+        .text
+        .globl  printf_chk
+        .type   printf_chk,@function
+printf_chk:
+        ret
+        .globl  chk
+        .type   chk,@function
+chk:
+        ret
+        .globl  vprintf_chk
+        .type   vprintf_chk,@function
+vprintf_chk:
+        ret
+        .globl  alpha
+        .type   alpha,@function
+alpha:
+        ret
+        .globl  beta
+        .type   beta,@function
+beta:
+        ret
+        .globl  gamma
+        .type   gamma,@function
+gamma:
+        ret
+        .globl  delta
+        .type   delta,@function
+delta:
+        call    undefined_f@PLT
+        ret
+
+        .data
+        .globl  omega
+        .type   omega,@object
+        .size   omega, 4
+omega:
+        .long   1
@@ -0,0 +1,18 @@
+# A shared object whose symbols lib_entry and lib_value are referred only by
+# the entry point and by a script expression, never by an input object.
+# obj/liblazy.so.1 is linked by ld -shared --hash-style=gnu -soname=liblazy.so.1
+        .text
+        .globl  lib_func
+        .type   lib_func,@function
+lib_func:
+        ret
+        .globl  lib_entry
+        .type   lib_entry,@function
+lib_entry:
+        ret
+        .data
+        .globl  lib_value
+        .type   lib_value,@object
+        .size   lib_value,8
+lib_value:
+        .quad   42
@@ -0,0 +1,6 @@
+        .text
+        .globl  _start
+        .type   _start,@function
+_start:
+        call    lib_func@PLT
+        ret
@@ -277,6 +277,10 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
   // --trace
   config_.options().setTrace(args.hasArg(kOpt_Trace));
 
+  // --time-trace, --time-trace-file=file
+  config_.options().setTimeTrace(
+      args.hasArg(kOpt_TimeTrace) || args.hasArg(kOpt_TimeTraceFile));
+
   // --verbose=level
   if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Verbose)) {
     llvm::StringRef value = arg->getValue();
@@ -511,6 +515,13 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     }
   }
 
+  if (config_.options().timeTrace()) {
+    if (llvm::opt::Arg* arg = args.getLastArg(kOpt_TimeTraceFile))
+      config_.options().setTimeTraceFile(arg->getValue());
+    else
+      config_.options().setTimeTraceFile(module_.name() + ".time-trace.json");
+  }
+
   // --format=value
   if (llvm::opt::Arg* arg = args.getLastArg(kOpt_InputFormat)) {
     llvm::StringRef value = arg->getValue();
@@ -813,6 +824,36 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     }
   }
 
+  // --threads=N
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Threads)) {
+    llvm::StringRef value = arg->getValue();
+    unsigned int num;
+    if (value.getAsInteger(0, num) || (num == 0)) {
+      mcld::errs() << "Invalid value for" << arg->getOption().getPrefixedName()
+                   << ": " << arg->getValue() << "\n";
+      return false;
+    }
+    config_.options().setNumThreads(num);
+  }
+
+  // --lazy-shlib-symbols
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_LazyShlibSymbols,
+                                            kOpt_NoLazyShlibSymbols)) {
+    config_.options().setLazyShlibSymbols(
+        arg->getOption().matches(kOpt_LazyShlibSymbols));
+  }
+
+  // --shlib-symbol-cache=dir
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_ShlibSymbolCache))
+    config_.options().setShlibSymbolCache(arg->getValue());
+
+  // --tail-merge-strings
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_TailMergeStrings,
+                                            kOpt_NoTailMergeStrings)) {
+    config_.options().setTailMergeStrings(
+        arg->getOption().matches(kOpt_TailMergeStrings));
+  }
+
   //===--------------------------------------------------------------------===//
   // Positional
   //===--------------------------------------------------------------------===//
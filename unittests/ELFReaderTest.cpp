@@ -110,9 +110,8 @@ TEST_F(ELFReaderTest, read_symbol_and_rela) {
 
   llvm::StringRef strtab_region = m_pInput->memArea()->request(
       m_pInput->fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
-  const char* strtab = strtab_region.begin();
   bool result = m_pELFReader->readSymbols(
-      *m_pInput, *m_pIRBuilder, symtab_region, strtab);
+      *m_pInput, *m_pIRBuilder, symtab_region, strtab_region);
   ASSERT_TRUE(result);
   ASSERT_EQ("hello.c", std::string(m_pInput->context()->getSymbol(1)->name()));
   ASSERT_EQ("puts", std::string(m_pInput->context()->getSymbol(10)->name()));
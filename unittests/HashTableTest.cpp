@@ -57,6 +57,10 @@ struct IntMod3Hash {
   size_t operator()(int pKey) const { return pKey % 3; }
 };
 
+struct IntMulHash {
+  size_t operator()(int pKey) const { return pKey * 2654435761U; }
+};
+
 TEST_F(HashTableTest, ptr_entry) {
   int A = 1;
   int* pA = &A;
@@ -80,7 +84,7 @@ TEST_F(HashTableTest, ptr_entry) {
 TEST_F(HashTableTest, constructor) {
   typedef HashEntry<int, int, IntCompare> HashEntryType;
   HashTable<HashEntryType, IntHash, EntryFactory<HashEntryType> > hashTable(16);
-  EXPECT_TRUE(17 == hashTable.numOfBuckets());
+  EXPECT_TRUE(32 == hashTable.numOfBuckets());
   EXPECT_TRUE(hashTable.empty());
   EXPECT_TRUE(0 == hashTable.numOfEntries());
 }
@@ -122,7 +126,7 @@ TEST_F(HashTableTest, alloc100) {
 
   EXPECT_FALSE(hashTable->empty());
   EXPECT_TRUE(100 == hashTable->numOfEntries());
-  EXPECT_TRUE(197 == hashTable->numOfBuckets());
+  EXPECT_TRUE(256 == hashTable->numOfBuckets());
   delete hashTable;
 }
 
@@ -205,7 +209,7 @@ TEST_F(HashTableTest, tombstone) {
     hashTable->insert(key, exist);
   }
   EXPECT_TRUE(100 == hashTable->numOfEntries());
-  EXPECT_TRUE(197 == hashTable->numOfBuckets());
+  EXPECT_TRUE(256 == hashTable->numOfBuckets());
 
   delete hashTable;
 }
@@ -297,7 +301,7 @@ TEST_F(HashTableTest, chain_iterator_list) {
     entry->setValue(key);
   }
   ASSERT_TRUE(16 == hashTable->numOfEntries());
-  ASSERT_TRUE(37 == hashTable->numOfBuckets());
+  ASSERT_TRUE(32 == hashTable->numOfBuckets());
 
   unsigned int key = 0;
   int count = 0;
@@ -308,3 +312,69 @@ TEST_F(HashTableTest, chain_iterator_list) {
   ASSERT_EQ(16, count);
   delete hashTable;
 }
+
+TEST_F(HashTableTest, reserve) {
+  typedef HashEntry<int, int, IntCompare> HashEntryType;
+  typedef HashTable<HashEntryType, IntHash, EntryFactory<HashEntryType> >
+      HashTableTy;
+  HashTableTy* hashTable = new HashTableTy();
+
+  hashTable->reserve(1000);
+  unsigned int buckets = hashTable->numOfBuckets();
+  EXPECT_TRUE(2048 == buckets);
+
+  bool exist;
+  for (int key = 0; key < 1000; ++key)
+    hashTable->insert(key, exist);
+  EXPECT_TRUE(1000 == hashTable->numOfEntries());
+  EXPECT_TRUE(buckets == hashTable->numOfBuckets());
+
+  // never shrinks
+  hashTable->reserve(10);
+  EXPECT_TRUE(buckets == hashTable->numOfBuckets());
+  for (int key = 0; key < 1000; ++key)
+    EXPECT_TRUE(hashTable->find(key) != hashTable->end());
+  delete hashTable;
+}
+
+TEST_F(HashTableTest, erase_and_reinsert) {
+  typedef HashEntry<int, int, IntCompare> HashEntryType;
+  typedef HashTable<HashEntryType, IntMulHash, EntryFactory<HashEntryType> >
+      HashTableTy;
+  HashTableTy* hashTable = new HashTableTy();
+
+  bool exist;
+  for (int key = 0; key < 5000; ++key)
+    hashTable->insert(key, exist)->setValue(key);
+
+  // leave tombstones on the probe sequences of the remaining keys
+  for (int key = 0; key < 5000; key += 2)
+    EXPECT_TRUE(1 == hashTable->erase(key));
+  EXPECT_TRUE(2500 == hashTable->numOfEntries());
+
+  for (int key = 0; key < 5000; ++key) {
+    HashTableTy::iterator iter = hashTable->find(key);
+    if (key % 2 == 0) {
+      EXPECT_TRUE(iter == hashTable->end());
+    } else {
+      ASSERT_TRUE(iter != hashTable->end());
+      EXPECT_EQ(key, iter.getEntry()->value());
+    }
+  }
+
+  for (int key = 0; key < 5000; ++key) {
+    HashTableTy::entry_type* entry = hashTable->insert(key, exist);
+    EXPECT_EQ(key % 2 == 1, exist);
+    entry->setValue(key + 1);
+  }
+  EXPECT_TRUE(5000 == hashTable->numOfEntries());
+
+  int count = 0;
+  HashTableTy::iterator iter, iEnd = hashTable->end();
+  for (iter = hashTable->begin(); iter != iEnd; ++iter) {
+    EXPECT_EQ(iter.getEntry()->key() + 1, iter.getEntry()->value());
+    ++count;
+  }
+  EXPECT_EQ(5000, count);
+  delete hashTable;
+}
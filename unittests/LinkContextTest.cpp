@@ -0,0 +1,100 @@
+//===- LinkContextTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LinkContext.h"
+#include "LinkContextTest.h"
+
+#include <thread>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+struct Counter {
+  Counter() : value(0) { ++alive; }
+  ~Counter() { --alive; }
+
+  int value;
+  static int alive;
+};
+
+int Counter::alive = 0;
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+LinkContextTest::LinkContextTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+LinkContextTest::~LinkContextTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void LinkContextTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void LinkContextTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(LinkContextTest, get_creates_once_and_release_destroys) {
+  LinkContext context;
+  ASSERT_EQ(0, Counter::alive);
+
+  context.get<Counter>().value = 7;
+  ASSERT_EQ(7, context.get<Counter>().value);
+  ASSERT_EQ(1, Counter::alive);
+
+  context.release();
+  ASSERT_EQ(0, Counter::alive);
+
+  // a released context can be used again
+  ASSERT_EQ(0, context.get<Counter>().value);
+  ASSERT_EQ(1, Counter::alive);
+}
+
+TEST_F(LinkContextTest, scope_switches_current_context) {
+  static LinkStatic<Counter> counter;
+  LinkContext first, second;
+
+  {
+    LinkContext::Scope scope(first);
+    ASSERT_EQ(&first, &LinkContext::current());
+    counter->value = 1;
+    {
+      LinkContext::Scope inner(second);
+      ASSERT_EQ(&second, &LinkContext::current());
+      counter->value = 2;
+    }
+    ASSERT_EQ(&first, &LinkContext::current());
+    ASSERT_EQ(1, counter->value);
+  }
+  ASSERT_EQ(2, second.get<Counter>().value);
+  ASSERT_NE(&first, &LinkContext::current());
+}
+
+TEST_F(LinkContextTest, threads_use_their_own_context) {
+  static LinkStatic<Counter> counter;
+  LinkContext main_context, thread_context;
+  LinkContext::Scope scope(main_context);
+  counter->value = 1;
+
+  std::thread worker([&thread_context]() {
+    LinkContext::Scope scope(thread_context);
+    counter->value = 2;
+  });
+  worker.join();
+
+  ASSERT_EQ(1, counter->value);
+  ASSERT_EQ(2, thread_context.get<Counter>().value);
+}
@@ -0,0 +1,145 @@
+//===- MergedStringsTest.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/MergedStrings.h"
+#include "mcld/Support/ThreadPool.h"
+#include "MergedStringsTest.h"
+
+#include <llvm/ADT/StringRef.h>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+MergedStringsTest::MergedStringsTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+MergedStringsTest::~MergedStringsTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void MergedStringsTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void MergedStringsTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(MergedStringsTest, can_merge_only_terminated_strings) {
+  ASSERT_TRUE(MergedStrings::canMerge(llvm::StringRef("ab\0c\0", 5), 1));
+  ASSERT_FALSE(MergedStrings::canMerge(llvm::StringRef("ab\0c", 4), 1));
+  ASSERT_TRUE(MergedStrings::canMerge(llvm::StringRef("a\0\0\0", 4), 2));
+  ASSERT_FALSE(MergedStrings::canMerge(llvm::StringRef("a\0\0", 3), 2));
+  ASSERT_FALSE(MergedStrings::canMerge(llvm::StringRef("a\0", 2), 0));
+}
+
+TEST_F(MergedStringsTest, same_strings_are_kept_once) {
+  llvm::StringRef first("foo\0bar\0", 8);
+  llvm::StringRef second("bar\0baz\0foo\0", 12);
+
+  MergedStrings strings(1, 1);
+  unsigned int a = strings.addSection(first);
+  unsigned int b = strings.addSection(second);
+  strings.finalize(NULL, false);
+
+  ASSERT_EQ(12u, strings.size());
+  ASSERT_TRUE(llvm::StringRef("foo\0bar\0baz\0", 12) == strings.getContents());
+  ASSERT_EQ(0u, strings.getOutputOffset(a, 0));
+  ASSERT_EQ(5u, strings.getOutputOffset(a, 5));
+  ASSERT_EQ(4u, strings.getOutputOffset(b, 0));
+  ASSERT_EQ(8u, strings.getOutputOffset(b, 4));
+  ASSERT_EQ(1u, strings.getOutputOffset(b, 9));
+}
+
+TEST_F(MergedStringsTest, tail_merge_keeps_suffixes_in_longer_strings) {
+  llvm::StringRef first("bar\0", 4);
+  llvm::StringRef second("foobar\0ar\0", 10);
+
+  MergedStrings strings(1, 1);
+  unsigned int a = strings.addSection(first);
+  unsigned int b = strings.addSection(second);
+  strings.finalize(NULL, true);
+
+  ASSERT_EQ(7u, strings.size());
+  ASSERT_TRUE(llvm::StringRef("foobar\0", 7) == strings.getContents());
+  ASSERT_EQ(3u, strings.getOutputOffset(a, 0));
+  ASSERT_EQ(0u, strings.getOutputOffset(b, 0));
+  ASSERT_EQ(4u, strings.getOutputOffset(b, 7));
+}
+
+TEST_F(MergedStringsTest, tail_merge_respects_alignment) {
+  llvm::StringRef contents("abc\0bc\0", 7);
+
+  MergedStrings strings(1, 2);
+  unsigned int a = strings.addSection(contents);
+  strings.finalize(NULL, true);
+
+  // "bc" would start at an odd offset of "abc"
+  ASSERT_EQ(7u, strings.size());
+  ASSERT_EQ(0u, strings.getOutputOffset(a, 0));
+  ASSERT_EQ(4u, strings.getOutputOffset(a, 4));
+}
+
+TEST_F(MergedStringsTest, threads_give_the_same_layout) {
+  std::string contents;
+  for (unsigned int n = 0; n < 500; ++n) {
+    contents += "str";
+    contents += static_cast<char>('a' + n % 26);
+    contents += static_cast<char>('a' + n % 7);
+    contents += '\0';
+  }
+
+  MergedStrings serial(1, 1);
+  MergedStrings parallel(1, 1);
+  for (unsigned int n = 0; n < 4; ++n) {
+    serial.addSection(contents);
+    parallel.addSection(contents);
+  }
+
+  ThreadPool pool(4);
+  serial.finalize(NULL, true);
+  parallel.finalize(&pool, true);
+
+  ASSERT_TRUE(serial.getContents() == parallel.getContents());
+  for (uint64_t offset = 0; offset < contents.size(); ++offset)
+    ASSERT_EQ(serial.getOutputOffset(3, offset),
+              parallel.getOutputOffset(3, offset));
+}
+
+TEST_F(MergedStringsTest, same_constants_are_kept_once) {
+  // two sections of 16-byte constants
+  std::string first(32, '\0'), second(48, '\0');
+  first[0] = 1;
+  first[16] = 2;
+  second[0] = 2;
+  second[16] = 3;
+  second[32] = 1;
+
+  // the constants must fill the section, but need no terminator
+  ASSERT_FALSE(MergedStrings::canMerge(llvm::StringRef("\1\0\0", 3), 2, false));
+  ASSERT_TRUE(MergedStrings::canMerge(llvm::StringRef("\1\1", 2), 2, false));
+  ASSERT_TRUE(MergedStrings::canMerge(first, 16, false));
+
+  MergedStrings constants(16, 16, false);
+  unsigned int a = constants.addSection(first);
+  unsigned int b = constants.addSection(second);
+  constants.finalize(NULL, true);
+
+  ASSERT_FALSE(constants.isStrings());
+  ASSERT_EQ(48u, constants.size());
+  ASSERT_EQ(16u, constants.getOutputOffset(b, 0));
+  ASSERT_EQ(32u, constants.getOutputOffset(b, 16));
+  ASSERT_EQ(4u, constants.getOutputOffset(b, 36));
+  ASSERT_EQ(20u, constants.getOutputOffset(a, 20));
+  ASSERT_TRUE(llvm::StringRef(first.data(), 32) ==
+              constants.getContents().substr(0, 32));
+}
@@ -0,0 +1,140 @@
+//===- ModuleTest.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Module.h"
+#include "ModuleTest.h"
+
+#include "mcld/LinkerScript.h"
+#include "mcld/LD/LDFileFormat.h"
+#include "mcld/LD/LDSection.h"
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+ModuleTest::ModuleTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ModuleTest::~ModuleTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ModuleTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void ModuleTest::TearDown() {
+}
+
+static LDSection* createSection(const std::string& pName) {
+  return LDSection::Create(pName, LDFileFormat::DATA, 0, 0);
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ModuleTest, first_section_of_a_name) {
+  LinkerScript script;
+  Module module(script);
+  LDSection* text = createSection(".text");
+  LDSection* data = createSection(".data");
+  LDSection* text2 = createSection(".text");
+
+  module.addSection(*text);
+  module.addSection(*data);
+  module.addSection(*text2);
+  ASSERT_EQ(3u, module.size());
+
+  const Module& const_module = module;
+  ASSERT_TRUE(text == module.getSection(".text"));
+  ASSERT_TRUE(text == const_module.getSection(".text"));
+  ASSERT_TRUE(data == module.getSection(".data"));
+  ASSERT_TRUE(NULL == module.getSection(".bss"));
+  ASSERT_TRUE(NULL == const_module.getSection(".bss"));
+
+  // the same while the index is stale and after it is rebuilt
+  module.getSectionTable();
+  ASSERT_TRUE(text == const_module.getSection(".text"));
+  ASSERT_TRUE(text == module.getSection(".text"));
+
+  LDSection::Destroy(text);
+  LDSection::Destroy(data);
+  LDSection::Destroy(text2);
+}
+
+TEST_F(ModuleTest, write_through_section_table) {
+  LinkerScript script;
+  Module module(script);
+  LDSection* text = createSection(".text");
+  LDSection* data = createSection(".data");
+  LDSection* bss = createSection(".bss");
+
+  module.addSection(*text);
+  module.addSection(*data);
+  ASSERT_TRUE(data == module.getSection(".data"));
+
+  // reorder the table, drop .data and add .bss behind the index's back
+  Module::SectionTable& table = module.getSectionTable();
+  table.clear();
+  table.push_back(bss);
+  table.push_back(text);
+
+  const Module& const_module = module;
+  ASSERT_TRUE(NULL == const_module.getSection(".data"));
+  ASSERT_TRUE(bss == const_module.getSection(".bss"));
+  ASSERT_TRUE(NULL == module.getSection(".data"));
+  ASSERT_TRUE(bss == module.getSection(".bss"));
+  ASSERT_TRUE(text == module.getSection(".text"));
+
+  // a section added after the rebuild is found as well
+  module.addSection(*data);
+  ASSERT_TRUE(data == module.getSection(".data"));
+  ASSERT_TRUE(data == const_module.getSection(".data"));
+
+  LDSection::Destroy(text);
+  LDSection::Destroy(data);
+  LDSection::Destroy(bss);
+}
+
+TEST_F(ModuleTest, clear_then_add_sections) {
+  LinkerScript script;
+  Module module(script);
+  LDSection* text = createSection(".text");
+  LDSection* data = createSection(".data");
+  LDSection* text2 = createSection(".text");
+
+  module.addSection(*text);
+  module.addSection(*data);
+  ASSERT_TRUE(text == module.getSection(".text"));
+
+  module.clearSections();
+  ASSERT_TRUE(module.empty());
+  ASSERT_TRUE(NULL == module.getSection(".text"));
+  ASSERT_TRUE(NULL == module.getSection(".data"));
+
+  // a new section of an old name replaces the old one
+  module.addSection(*text2);
+  module.addSection(*data);
+  const Module& const_module = module;
+  ASSERT_TRUE(text2 == module.getSection(".text"));
+  ASSERT_TRUE(text2 == const_module.getSection(".text"));
+  ASSERT_TRUE(data == module.getSection(".data"));
+
+  // also when the index was stale before the sections were cleared
+  module.getSectionTable();
+  module.clearSections();
+  module.addSection(*text);
+  ASSERT_TRUE(text == module.getSection(".text"));
+  ASSERT_TRUE(text == const_module.getSection(".text"));
+  ASSERT_TRUE(NULL == module.getSection(".data"));
+
+  LDSection::Destroy(text);
+  LDSection::Destroy(data);
+  LDSection::Destroy(text2);
+}
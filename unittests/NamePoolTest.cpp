@@ -12,8 +12,11 @@
 #include "mcld/LD/StaticResolver.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/LDSymbol.h"
+#include "mcld/Support/ThreadPool.h"
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringRef.h>
 #include <string>
+#include <vector>
 #include <cstdio>
 
 using namespace mcld;
@@ -205,3 +208,75 @@ TEST_F(NamePoolTest, insert_16384_weak_reference_symbols) {
     }
   }
 }
+
+/// internInParallel - intern each of pNames four times with four threads,
+/// starting from pNames[pFirst]
+static void internInParallel(NamePool& pPool,
+                             const std::vector<std::string>& pNames,
+                             size_t pFirst) {
+  ThreadPool threads(4);
+  threads.parallelFor(0, 4 * pNames.size(), [&](size_t pIdx) {
+    pPool.intern(pNames[(pFirst + pIdx) % pNames.size()]);
+  }, /*pGrainSize*/ 7);
+}
+
+/// insertInOrder - insert pNames as global references, in their order
+static void insertInOrder(NamePool& pPool,
+                          const std::vector<std::string>& pNames) {
+  for (size_t n = 0; n < pNames.size(); ++n) {
+    Resolver::Result result;
+    pPool.insertSymbol(pNames[n], false, ResolveInfo::NoType,
+                       ResolveInfo::Undefined, ResolveInfo::Global, 0, 0,
+                       ResolveInfo::Default, NULL, result);
+  }
+}
+
+TEST_F(NamePoolTest, intern_in_parallel) {
+  std::vector<std::string> names;
+  for (unsigned int n = 0; n < 5000; ++n)
+    names.push_back("sym" + llvm::utostr(n));
+
+  NamePool pool(10);
+  internInParallel(pool, names, 0);
+
+  // every name is kept once, and none of them is a symbol yet
+  for (size_t n = 0; n < names.size(); ++n) {
+    ASSERT_TRUE(pool.findInfo(names[n]) == NULL);
+    llvm::StringRef name = pool.insertString(names[n]);
+    ASSERT_TRUE(name == names[n]);
+    ASSERT_EQ(name.data(), pool.insertString(names[n]).data());
+  }
+  ASSERT_EQ(0u, pool.size());
+
+  insertInOrder(pool, names);
+  ASSERT_EQ(names.size(), pool.size());
+  for (size_t n = 0; n < names.size(); ++n) {
+    const ResolveInfo* info = pool.findInfo(names[n]);
+    ASSERT_TRUE(info != NULL);
+    ASSERT_EQ(pool.insertString(names[n]).data(), info->name());
+  }
+}
+
+TEST_F(NamePoolTest, symbols_in_insertion_order) {
+  // the order of the symbols depends on the insertions only, and not on the
+  // threads which have interned the names
+  std::vector<std::string> names;
+  for (unsigned int n = 0; n < 3000; ++n)
+    names.push_back("_Z" + llvm::utostr((n * 7919) % 3000) + "name");
+
+  NamePool first(10);
+  NamePool second(10);
+  internInParallel(first, names, 0);
+  internInParallel(second, names, 1234);
+  insertInOrder(first, names);
+  insertInOrder(second, names);
+
+  ASSERT_EQ(names.size(), first.size());
+  ASSERT_EQ(names.size(), second.size());
+  NamePool::syminfo_iterator a = first.syminfo_begin();
+  NamePool::syminfo_iterator b = second.syminfo_begin();
+  for (size_t n = 0; n < names.size(); ++n, ++a, ++b) {
+    ASSERT_TRUE(names[n] == (*a)->name());
+    ASSERT_TRUE(names[n] == (*b)->name());
+  }
+}
@@ -0,0 +1,174 @@
+//===- ObjectBuilderTest.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/ObjectBuilder.h"
+#include "ObjectBuilderTest.h"
+
+#include "mcld/LinkerScript.h"
+#include "mcld/Module.h"
+#include "mcld/LD/LDFileFormat.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Object/SectionMap.h"
+#include "mcld/Script/InputSectDesc.h"
+#include "mcld/Script/OutputSectDesc.h"
+#include "mcld/Script/StringList.h"
+#include "mcld/Script/WildcardPattern.h"
+#include "mcld/Support/Path.h"
+
+#include <llvm/Support/ELF.h>
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+ObjectBuilderTest::ObjectBuilderTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ObjectBuilderTest::~ObjectBuilderTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ObjectBuilderTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void ObjectBuilderTest::TearDown() {
+}
+
+/// createInputSection - an empty allocatable input section named pName
+static LDSection* createInputSection(const std::string& pName) {
+  LDSection* sect = LDSection::Create(pName,
+                                      LDFileFormat::DATA,
+                                      llvm::ELF::SHT_PROGBITS,
+                                      llvm::ELF::SHF_ALLOC);
+  sect->setSectionData(SectionData::Create(*sect));
+  return sect;
+}
+
+static OutputSectDesc* createOutputDesc(const std::string& pName) {
+  OutputSectDesc::Prolog prolog;
+  prolog.m_pVMA = NULL;
+  prolog.m_Type = OutputSectDesc::LOAD;
+  prolog.m_pLMA = NULL;
+  prolog.m_pAlign = NULL;
+  prolog.m_pSubAlign = NULL;
+  prolog.m_Constraint = OutputSectDesc::NO_CONSTRAINT;
+
+  OutputSectDesc::Epilog epilog;
+  epilog.m_pRegion = NULL;
+  epilog.m_pLMARegion = NULL;
+  epilog.m_pPhdrs = NULL;
+  epilog.m_pFillExp = NULL;
+
+  OutputSectDesc* desc = new OutputSectDesc(pName, prolog);
+  desc->setEpilog(epilog);
+  return desc;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ObjectBuilderTest, orphan_sections) {
+  LinkerScript script;
+  Module module(script);
+  ObjectBuilder builder(module);
+  Input a("a.o", sys::fs::Path("a.o"), Input::Object);
+  Input b("b.o", sys::fs::Path("b.o"), Input::Object);
+
+  LDSection* text = builder.MergeSection(a, *createInputSection(".text.f"));
+  ASSERT_TRUE(NULL != text);
+  ASSERT_EQ(".text.f", text->name());
+  ASSERT_TRUE(text == module.getSection(".text.f"));
+
+  LDSection* data = builder.MergeSection(a, *createInputSection(".data"));
+  ASSERT_TRUE(NULL != data);
+  ASSERT_TRUE(text != data);
+
+  // the remembered output sections are the ones the module has
+  ASSERT_TRUE(text == builder.MergeSection(b, *createInputSection(".text.f")));
+  ASSERT_TRUE(data == builder.MergeSection(b, *createInputSection(".data")));
+  ASSERT_EQ(2u, module.size());
+}
+
+TEST_F(ObjectBuilderTest, mapped_and_orphan_sections) {
+  // .text : { *(.text.hot) }
+  LinkerScript script;
+  script.sectionMap().insert(".text.hot", ".text");
+  Module module(script);
+  ObjectBuilder builder(module);
+  Input a("a.o", sys::fs::Path("a.o"), Input::Object);
+
+  LDSection* text = builder.MergeSection(a, *createInputSection(".text.hot"));
+  ASSERT_TRUE(NULL != text);
+  ASSERT_EQ(".text", text->name());
+
+  // an orphan .text goes to the same output section, and .text.hot still
+  // does after it
+  ASSERT_TRUE(text == builder.MergeSection(a, *createInputSection(".text")));
+  ASSERT_TRUE(text ==
+              builder.MergeSection(a, *createInputSection(".text.hot")));
+  ASSERT_EQ(1u, module.size());
+}
+
+TEST_F(ObjectBuilderTest, same_name_different_descriptions) {
+  // .ctors : { *(EXCLUDE_FILE(crt*.o) .ctors) }
+  // .ctors.crt : { *(.ctors) }
+  OutputSectDesc* ctors = createOutputDesc(".ctors");
+  OutputSectDesc* crt = createOutputDesc(".ctors.crt");
+
+  InputSectDesc::Spec spec;
+  spec.m_pWildcardFile =
+      WildcardPattern::create("*", WildcardPattern::SORT_NONE);
+  spec.m_pExcludeFiles = StringList::create();
+  spec.m_pExcludeFiles->push_back(
+      WildcardPattern::create("crt*.o", WildcardPattern::SORT_NONE));
+  spec.m_pWildcardSections = StringList::create();
+  spec.m_pWildcardSections->push_back(
+      WildcardPattern::create(".ctors", WildcardPattern::SORT_NONE));
+  InputSectDesc exclude(InputSectDesc::NoKeep, spec, *ctors);
+
+  spec.m_pExcludeFiles = NULL;
+  spec.m_pWildcardSections = StringList::create();
+  spec.m_pWildcardSections->push_back(
+      WildcardPattern::create(".ctors", WildcardPattern::SORT_NONE));
+  InputSectDesc all(InputSectDesc::NoKeep, spec, *crt);
+
+  LinkerScript script;
+  script.sectionMap().insert(exclude, *ctors);
+  script.sectionMap().insert(all, *crt);
+  Module module(script);
+  ObjectBuilder builder(module);
+  Input main("main.o", sys::fs::Path("main.o"), Input::Object);
+  Input crtbegin("crtbegin.o", sys::fs::Path("crtbegin.o"), Input::Object);
+  Input foo("foo.o", sys::fs::Path("foo.o"), Input::Object);
+
+  // the input section name is the same, but the description it last matched
+  // changes from one file to the next
+  LDSection* out = builder.MergeSection(main, *createInputSection(".ctors"));
+  ASSERT_TRUE(NULL != out);
+  ASSERT_EQ(".ctors", out->name());
+
+  LDSection* out_crt =
+      builder.MergeSection(crtbegin, *createInputSection(".ctors"));
+  ASSERT_TRUE(NULL != out_crt);
+  ASSERT_EQ(".ctors.crt", out_crt->name());
+
+  ASSERT_TRUE(out == builder.MergeSection(foo, *createInputSection(".ctors")));
+  ASSERT_TRUE(out == builder.MergeSection(foo, *createInputSection(".ctors")));
+  ASSERT_TRUE(out_crt ==
+              builder.MergeSection(crtbegin, *createInputSection(".ctors")));
+  ASSERT_EQ(2u, module.size());
+
+  delete ctors;
+  delete crt;
+}
@@ -0,0 +1,72 @@
+//===- ResolveInfoTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/ResolveInfo.h"
+#include "ResolveInfoTest.h"
+
+#include <llvm/Support/Allocator.h>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+ResolveInfoTest::ResolveInfoTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ResolveInfoTest::~ResolveInfoTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ResolveInfoTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void ResolveInfoTest::TearDown() {
+}
+
+/// the names and their hashes as the SysV and the GNU dynamic linkers
+/// compute them
+static const struct {
+  const char* name;
+  uint32_t elf_hash;
+  uint32_t gnu_hash;
+} g_Hashes[] = {
+  { "",                  0x00000000, 0x00001505 },
+  { "printf",            0x077905a6, 0x156b2bb8 },
+  { "exit",              0x0006cf04, 0x7c967e3f },
+  { "syscall",           0x0b09985c, 0xbac212a0 },
+  { "main",              0x000737fe, 0x7c9a7f6a },
+  { "__libc_start_main", 0x0177ff8e, 0xf63d4e2e },
+  // the bytes above 0x7f are not sign-extended
+  { "\xc3\xa9t\xc3\xa9", 0x00ce10d9, 0x16265db1 },
+};
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ResolveInfoTest, hashes) {
+  for (size_t n = 0; n < sizeof(g_Hashes) / sizeof(g_Hashes[0]); ++n) {
+    ResolveInfo* info = ResolveInfo::Create(g_Hashes[n].name);
+    EXPECT_EQ(g_Hashes[n].elf_hash, info->elfHash()) << g_Hashes[n].name;
+    EXPECT_EQ(g_Hashes[n].gnu_hash, info->gnuHash()) << g_Hashes[n].name;
+    ResolveInfo::Destroy(info);
+  }
+}
+
+TEST_F(ResolveInfoTest, hashes_of_referred_names) {
+  llvm::BumpPtrAllocator allocator;
+  for (size_t n = 0; n < sizeof(g_Hashes) / sizeof(g_Hashes[0]); ++n) {
+    ResolveInfo* info = ResolveInfo::CreateRef(g_Hashes[n].name, allocator);
+    // the hashes are cached, so that asking again gives the same answer
+    for (unsigned int i = 0; i < 2; ++i) {
+      EXPECT_EQ(g_Hashes[n].gnu_hash, info->gnuHash()) << g_Hashes[n].name;
+      EXPECT_EQ(g_Hashes[n].elf_hash, info->elfHash()) << g_Hashes[n].name;
+    }
+  }
+}
@@ -0,0 +1,41 @@
+//===- ResolveInfoTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef RESOLVEINFO_TEST_H
+#define RESOLVEINFO_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class ResolveInfo;
+
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class ResolveInfoTest
+ */
+class ResolveInfoTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  ResolveInfoTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ResolveInfoTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+}  // namespace of mcldtest
+
+#endif
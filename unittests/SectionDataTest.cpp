@@ -9,9 +9,13 @@
 #include "SectionDataTest.h"
 
 #include "mcld/LD/SectionData.h"
+#include "mcld/Fragment/FillFragment.h"
+#include "mcld/Fragment/FragmentRef.h"
 #include "mcld/LD/LDFileFormat.h"
 #include "mcld/LD/LDSection.h"
 
+#include <vector>
+
 using namespace mcld;
 using namespace mcldtest;
 
@@ -73,3 +77,38 @@ TEST_F(SectionDataTest, Fragment_list_and_iterator) {
 
   LDSection::Destroy(test);
 }
+
+TEST_F(SectionDataTest, fragment_offset_index) {
+  LDSection* test = LDSection::Create("test", LDFileFormat::Null, 0, 0);
+  SectionData* s = SectionData::Create(*test);
+
+  // 32 fragments of 4 bytes, but the 10th one is empty
+  std::vector<Fragment*> frags;
+  for (int i = 0; i < 32; ++i)
+    frags.push_back(new FillFragment(0x0, 1, (i == 10) ? 0 : 4, s));
+
+  FragmentRef* ref = FragmentRef::Create(s->front(), 0);
+  EXPECT_TRUE(frags[0] == ref->frag() && 0 == ref->offset());
+
+  // the end of a fragment refers to the start of the next one
+  ref = FragmentRef::Create(s->front(), 100);
+  EXPECT_TRUE(frags[26] == ref->frag() && 0 == ref->offset());
+
+  ref = FragmentRef::Create(s->front(), 102);
+  EXPECT_TRUE(frags[26] == ref->frag() && 2 == ref->offset());
+
+  ref = FragmentRef::Create(*frags[3], 50);
+  EXPECT_TRUE(frags[16] == ref->frag() && 2 == ref->offset());
+
+  EXPECT_TRUE(FragmentRef::Null() == FragmentRef::Create(s->front(), 124));
+  EXPECT_TRUE(FragmentRef::Null() == FragmentRef::Create(s->front(), 200));
+
+  // an inserted fragment drops the index
+  Fragment* inserted = new FillFragment(0x0, 1, 4);
+  inserted->setParent(s);
+  s->getFragmentList().insert(SectionData::iterator(frags[6]), inserted);
+  ref = FragmentRef::Create(s->front(), 100);
+  EXPECT_TRUE(frags[25] == ref->frag() && 0 == ref->offset());
+
+  LDSection::Destroy(test);
+}
@@ -0,0 +1,156 @@
+//===- SectionMapTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/SectionMap.h"
+#include "SectionMapTest.h"
+
+#include "mcld/LD/LDFileFormat.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/Script/InputSectDesc.h"
+#include "mcld/Script/OutputSectDesc.h"
+#include "mcld/Script/StringList.h"
+#include "mcld/Script/WildcardPattern.h"
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+SectionMapTest::SectionMapTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SectionMapTest::~SectionMapTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void SectionMapTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void SectionMapTest::TearDown() {
+}
+
+/// outputOf - the name of the output section which pSection of pFile goes
+/// to, or "" if none does
+static std::string outputOf(const SectionMap& pMap,
+                            const std::string& pFile,
+                            const std::string& pSection) {
+  SectionMap::const_mapping pair = pMap.find(pFile, pSection);
+  if (pair.first == NULL)
+    return std::string();
+  return pair.first->name();
+}
+
+static OutputSectDesc* createOutputDesc(const std::string& pName) {
+  OutputSectDesc::Prolog prolog;
+  prolog.m_pVMA = NULL;
+  prolog.m_Type = OutputSectDesc::LOAD;
+  prolog.m_pLMA = NULL;
+  prolog.m_pAlign = NULL;
+  prolog.m_pSubAlign = NULL;
+  prolog.m_Constraint = OutputSectDesc::NO_CONSTRAINT;
+
+  OutputSectDesc::Epilog epilog;
+  epilog.m_pRegion = NULL;
+  epilog.m_pLMARegion = NULL;
+  epilog.m_pPhdrs = NULL;
+  epilog.m_pFillExp = NULL;
+
+  OutputSectDesc* desc = new OutputSectDesc(pName, prolog);
+  desc->setEpilog(epilog);
+  return desc;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(SectionMapTest, first_match_in_order) {
+  // the patterns starting with '.' and those starting with a wildcard are
+  // kept in two lists, but are tried in the order of the descriptions
+  SectionMap map;
+  map.insert(".text.hot*", ".text");
+  map.insert("*hot*", ".hot");
+  map.insert(".text*", ".text");
+  map.insert("*.init", ".init");
+  map.insert(".ctors.init", ".ctors");
+  map.insert(".?tors", ".ctors");
+
+  ASSERT_EQ(".text", outputOf(map, "a.o", ".text.hot.f"));
+  ASSERT_EQ(".hot", outputOf(map, "a.o", ".data.hot"));
+  ASSERT_EQ(".hot", outputOf(map, "a.o", "hot"));
+  ASSERT_EQ(".text", outputOf(map, "a.o", ".text.cold"));
+  ASSERT_EQ(".init", outputOf(map, "a.o", ".ctors.init"));
+  ASSERT_EQ(".ctors", outputOf(map, "a.o", ".dtors"));
+  ASSERT_EQ("", outputOf(map, "a.o", ".data"));
+  ASSERT_EQ("", outputOf(map, "a.o", ""));
+
+  // the remembered results are the same
+  ASSERT_EQ(".init", outputOf(map, "b.o", ".ctors.init"));
+  ASSERT_EQ(".text", outputOf(map, "b.o", ".text.hot.f"));
+  ASSERT_EQ("", outputOf(map, "b.o", ".data"));
+}
+
+TEST_F(SectionMapTest, exclude_file) {
+  // .ctors : { *(EXCLUDE_FILE(crt*.o) .ctors) }
+  // .ctors.crt : { *(.ctors) }
+  OutputSectDesc* ctors = createOutputDesc(".ctors");
+  OutputSectDesc* crt = createOutputDesc(".ctors.crt");
+
+  InputSectDesc::Spec spec;
+  spec.m_pWildcardFile =
+      WildcardPattern::create("*", WildcardPattern::SORT_NONE);
+  spec.m_pExcludeFiles = StringList::create();
+  spec.m_pExcludeFiles->push_back(
+      WildcardPattern::create("crt*.o", WildcardPattern::SORT_NONE));
+  spec.m_pWildcardSections = StringList::create();
+  spec.m_pWildcardSections->push_back(
+      WildcardPattern::create(".ctors", WildcardPattern::SORT_NONE));
+  InputSectDesc exclude(InputSectDesc::NoKeep, spec, *ctors);
+
+  spec.m_pExcludeFiles = NULL;
+  spec.m_pWildcardSections = StringList::create();
+  spec.m_pWildcardSections->push_back(
+      WildcardPattern::create(".ctors", WildcardPattern::SORT_NONE));
+  InputSectDesc all(InputSectDesc::NoKeep, spec, *crt);
+
+  SectionMap map;
+  map.insert(exclude, *ctors);
+  map.insert(all, *crt);
+
+  // the results depend on the files, also when they are remembered
+  for (unsigned int n = 0; n < 2; ++n) {
+    ASSERT_EQ(".ctors", outputOf(map, "main.o", ".ctors"));
+    ASSERT_EQ(".ctors.crt", outputOf(map, "crtbegin.o", ".ctors"));
+    ASSERT_EQ(".ctors", outputOf(map, "foo.o", ".ctors"));
+    ASSERT_EQ(".ctors.crt", outputOf(map, "crtend.o", ".ctors"));
+  }
+
+  delete ctors;
+  delete crt;
+}
+
+TEST_F(SectionMapTest, insert_drops_results) {
+  SectionMap map;
+  map.insert(".text", ".text");
+  ASSERT_EQ("", outputOf(map, "a.o", ".foo"));
+
+  map.insert(".foo", ".foo.out");
+  ASSERT_EQ(".foo.out", outputOf(map, "a.o", ".foo"));
+  ASSERT_EQ("", outputOf(map, "a.o", ".bar"));
+
+  // take the position before the results are remembered, so that no other
+  // non-const accessor is called in between
+  SectionMap::iterator pos = map.end();
+  ASSERT_EQ("", outputOf(map, "a.o", ".bar"));
+  LDSection* bar = LDSection::Create(".bar", LDFileFormat::DATA, 0, 0);
+  map.insert(pos, bar);
+  ASSERT_EQ(".bar", outputOf(map, "a.o", ".bar"));
+  ASSERT_EQ(".text", outputOf(map, "a.o", ".text"));
+}
@@ -0,0 +1,223 @@
+//===- ShlibSymbolCacheTest.cpp -------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/ShlibSymbolCache.h"
+#include "ShlibSymbolCacheTest.h"
+
+#include "mcld/LD/SymbolBuffer.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/Path.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+static const char Triple[] = "x86_64-pc-linux-gnu";
+
+/// the .dynstr of the shared object
+static const char StrTab[] = "\0foo\0bar\0baz";
+
+// Constructor can do set-up work for all test here.
+ShlibSymbolCacheTest::ShlibSymbolCacheTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ShlibSymbolCacheTest::~ShlibSymbolCacheTest() {
+}
+
+static void writeFile(const std::string& pPath, const std::string& pContents) {
+  std::ofstream file(pPath.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(pContents.data(), pContents.size());
+}
+
+static std::string readFile(const std::string& pPath) {
+  std::ifstream file(pPath.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+/// listFiles - the regular files in pDirectory
+static std::vector<std::string> listFiles(const std::string& pDirectory) {
+  std::vector<std::string> files;
+  std::error_code ec;
+  llvm::sys::fs::directory_iterator file(pDirectory, ec), fileEnd;
+  for (; !ec && file != fileEnd; file.increment(ec))
+    files.push_back(file->path());
+  return files;
+}
+
+// SetUp() will be called immediately before each test.
+void ShlibSymbolCacheTest::SetUp() {
+  llvm::SmallString<256> prefix, dir;
+  llvm::sys::path::system_temp_directory(/*ErasedOnReboot*/ true, prefix);
+  llvm::sys::path::append(prefix, "ShlibSymbolCacheTest");
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory(prefix.str(), dir));
+  m_Directory = dir.str().str();
+
+  llvm::SmallString<256> path(dir);
+  llvm::sys::path::append(path, "cache");
+  m_CacheDir = path.str().str();
+
+  path = dir;
+  llvm::sys::path::append(path, "libfoo.so");
+  m_Shlib = path.str().str();
+  writeFile(m_Shlib, "not really a shared object");
+}
+
+// TearDown() will be called immediately after each test.
+void ShlibSymbolCacheTest::TearDown() {
+  std::vector<std::string> files = listFiles(m_CacheDir);
+  for (size_t n = 0; n < files.size(); ++n)
+    llvm::sys::fs::remove(files[n]);
+  llvm::sys::fs::remove(m_CacheDir);
+  llvm::sys::fs::remove(m_Shlib);
+  llvm::sys::fs::remove(m_Directory);
+}
+
+/// fillBuffer - foo and its weak alias baz, and bar
+static void fillBuffer(llvm::StringRef pStrTab, SymbolBuffer& pBuffer) {
+  SymbolBuffer::Entry entry;
+  entry.name = pStrTab.substr(1, 3);
+  entry.value = 0x10;
+  entry.size = 8;
+  entry.shndx = 7;
+  entry.info = (llvm::ELF::STB_WEAK << 4) | llvm::ELF::STT_FUNC;
+  entry.other = llvm::ELF::STV_DEFAULT;
+  pBuffer.append(entry);
+
+  entry.name = pStrTab.substr(5, 3);
+  entry.value = 0x20;
+  entry.size = 4;
+  entry.shndx = 8;
+  entry.info = (llvm::ELF::STB_GLOBAL << 4) | llvm::ELF::STT_OBJECT;
+  entry.other = llvm::ELF::STV_PROTECTED;
+  pBuffer.append(entry);
+
+  entry.name = pStrTab.substr(9, 3);
+  entry.value = 0x10;
+  entry.size = 8;
+  entry.shndx = 7;
+  entry.info = (llvm::ELF::STB_GLOBAL << 4) | llvm::ELF::STT_FUNC;
+  entry.other = llvm::ELF::STV_DEFAULT;
+  pBuffer.append(entry);
+
+  pBuffer.aliases().push_back(2);
+  pBuffer.aliases().push_back(0);
+  pBuffer.aliases().push_back(2);
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ShlibSymbolCacheTest, store_and_load) {
+  Input input("libfoo.so", sys::fs::Path(m_Shlib), Input::DynObj);
+  ShlibSymbolCache cache(m_CacheDir, Triple);
+  llvm::StringRef strtab(StrTab, sizeof(StrTab));
+  SymbolBuffer stored;
+  fillBuffer(strtab, stored);
+  ASSERT_TRUE(cache.store(input, strtab, stored));
+  ASSERT_EQ(1u, listFiles(m_CacheDir).size());
+
+  // the names point into the string table of the next link
+  std::string copy(StrTab, sizeof(StrTab));
+  llvm::StringRef next_strtab(copy);
+  SymbolBuffer loaded;
+  ASSERT_TRUE(cache.load(input, next_strtab, loaded));
+  ASSERT_EQ(stored.size(), loaded.size());
+  for (size_t n = 0; n < stored.size(); ++n) {
+    const SymbolBuffer::Entry& expected = stored.at(n);
+    const SymbolBuffer::Entry& entry = loaded.at(n);
+    ASSERT_TRUE(expected.name == entry.name);
+    ASSERT_TRUE(entry.name.data() >= next_strtab.begin() &&
+                entry.name.data() + entry.name.size() <= next_strtab.end());
+    ASSERT_EQ(expected.value, entry.value);
+    ASSERT_EQ(expected.size, entry.size);
+    ASSERT_EQ(expected.shndx, entry.shndx);
+    ASSERT_EQ(expected.info, entry.info);
+    ASSERT_EQ(expected.other, entry.other);
+  }
+  ASSERT_TRUE(stored.aliases() == loaded.aliases());
+}
+
+TEST_F(ShlibSymbolCacheTest, stale_file_is_rejected) {
+  Input input("libfoo.so", sys::fs::Path(m_Shlib), Input::DynObj);
+  ShlibSymbolCache cache(m_CacheDir, Triple);
+  llvm::StringRef strtab(StrTab, sizeof(StrTab));
+  SymbolBuffer stored;
+  fillBuffer(strtab, stored);
+  ASSERT_TRUE(cache.store(input, strtab, stored));
+
+  // another target and another string table
+  SymbolBuffer loaded;
+  ShlibSymbolCache other_cache(m_CacheDir, "i386-pc-linux-gnu");
+  ASSERT_FALSE(other_cache.load(input, strtab, loaded));
+  ASSERT_FALSE(cache.load(input, strtab.drop_back(), loaded));
+  ASSERT_TRUE(loaded.empty());
+
+  // the shared object is rebuilt
+  writeFile(m_Shlib, "not really a shared object, rebuilt");
+  ASSERT_FALSE(cache.load(input, strtab, loaded));
+  ASSERT_TRUE(loaded.empty());
+
+  // the symbols are decoded again and replace the stale cache file
+  ASSERT_TRUE(cache.store(input, strtab, stored));
+  ASSERT_TRUE(cache.load(input, strtab, loaded));
+  ASSERT_EQ(stored.size(), loaded.size());
+  ASSERT_EQ(1u, listFiles(m_CacheDir).size());
+}
+
+TEST_F(ShlibSymbolCacheTest, corrupt_file_is_rejected) {
+  Input input("libfoo.so", sys::fs::Path(m_Shlib), Input::DynObj);
+  ShlibSymbolCache cache(m_CacheDir, Triple);
+  llvm::StringRef strtab(StrTab, sizeof(StrTab));
+  SymbolBuffer stored;
+  fillBuffer(strtab, stored);
+  ASSERT_TRUE(cache.store(input, strtab, stored));
+
+  std::vector<std::string> files = listFiles(m_CacheDir);
+  ASSERT_EQ(1u, files.size());
+  std::string contents = readFile(files[0]);
+  ASSERT_LT(12u, contents.size());
+  SymbolBuffer loaded;
+
+  // a truncated file
+  writeFile(files[0], contents.substr(0, contents.size() - 4));
+  ASSERT_FALSE(cache.load(input, strtab, loaded));
+  ASSERT_TRUE(loaded.empty());
+  writeFile(files[0], contents.substr(0, 16));
+  ASSERT_FALSE(cache.load(input, strtab, loaded));
+
+  // an alias group with an entry out of the buffer, which is the last word
+  std::string broken(contents);
+  broken[broken.size() - 4] = 99;
+  writeFile(files[0], broken);
+  ASSERT_FALSE(cache.load(input, strtab, loaded));
+  ASSERT_TRUE(loaded.empty());
+
+  // a bad magic
+  broken = contents;
+  broken[0] = 'X';
+  writeFile(files[0], broken);
+  ASSERT_FALSE(cache.load(input, strtab, loaded));
+
+  // the symbols are decoded again and replace the corrupt cache file
+  ASSERT_TRUE(cache.store(input, strtab, stored));
+  ASSERT_TRUE(cache.load(input, strtab, loaded));
+  ASSERT_TRUE(stored.aliases() == loaded.aliases());
+}
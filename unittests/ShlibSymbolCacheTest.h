@@ -0,0 +1,46 @@
+//===- ShlibSymbolCacheTest.h ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SHLIBSYMBOLCACHE_TEST_H
+#define MCLD_SHLIBSYMBOLCACHE_TEST_H
+
+#include <gtest.h>
+
+#include <string>
+
+namespace mcldtest {
+
+/** \class ShlibSymbolCacheTest
+ *  \brief
+ *
+ *  \see ShlibSymbolCache
+ */
+class ShlibSymbolCacheTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  ShlibSymbolCacheTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ShlibSymbolCacheTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  /// a temporary directory, with the shared object and the cache files
+  std::string m_Directory;
+  std::string m_CacheDir;
+  std::string m_Shlib;
+};
+
+}  // namespace of mcldtest
+
+#endif
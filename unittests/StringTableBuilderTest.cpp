@@ -0,0 +1,139 @@
+//===- StringTableBuilderTest.cpp -----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/StringTableBuilder.h"
+#include "StringTableBuilderTest.h"
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+StringTableBuilderTest::StringTableBuilderTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+StringTableBuilderTest::~StringTableBuilderTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void StringTableBuilderTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void StringTableBuilderTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(StringTableBuilderTest, same_strings_are_kept_once) {
+  std::string copy("foo");
+  StringTableBuilder strtab(false);
+  strtab.add("foo");
+  strtab.add("bar");
+  strtab.add("");
+  strtab.add(copy);
+
+  ASSERT_EQ(9u, strtab.finalize());
+  ASSERT_EQ(3u, strtab.numOfStrings());
+  ASSERT_EQ(1u, strtab.getOffset("foo"));
+  ASSERT_EQ(5u, strtab.getOffset("bar"));
+  ASSERT_EQ(0u, strtab.getOffset(""));
+  ASSERT_EQ(1u, strtab.getOffset(copy));
+
+  char buffer[9];
+  strtab.emit(buffer);
+  ASSERT_TRUE(llvm::StringRef("\0foo\0bar\0", 9) ==
+              llvm::StringRef(buffer, 9));
+}
+
+TEST_F(StringTableBuilderTest, tail_merge_shares_suffixes) {
+  StringTableBuilder shstrtab(true);
+  shstrtab.add(".text");
+  shstrtab.add(".rela.text");
+  shstrtab.add("xt");
+  shstrtab.add(".data");
+
+  ASSERT_EQ(18u, shstrtab.finalize());
+  ASSERT_EQ(1u, shstrtab.getOffset(".rela.text"));
+  ASSERT_EQ(6u, shstrtab.getOffset(".text"));
+  ASSERT_EQ(9u, shstrtab.getOffset("xt"));
+  ASSERT_EQ(12u, shstrtab.getOffset(".data"));
+
+  char buffer[18];
+  shstrtab.emit(buffer);
+  ASSERT_TRUE(llvm::StringRef("\0.rela.text\0.data\0", 18) ==
+              llvm::StringRef(buffer, 18));
+}
+
+TEST_F(StringTableBuilderTest, lookup_in_another_order) {
+  // the symbols are sorted for .gnu.hash after the table is finalized
+  StringTableBuilder dynstr(true);
+  dynstr.add("printf");
+  dynstr.add("f");
+  dynstr.add("puts");
+  dynstr.add("libc.so.6");
+  uint64_t size = dynstr.finalize();
+
+  ASSERT_EQ(6u, dynstr.getOffset("f"));
+  ASSERT_EQ(1u, dynstr.getOffset("printf"));
+
+  std::vector<char> buffer(size);
+  dynstr.emit(buffer.data());
+  const char* names[] = { "libc.so.6", "puts", "f", "printf" };
+  for (size_t n = 0; n < 4; ++n) {
+    uint64_t offset = dynstr.append(names[n]);
+    ASSERT_TRUE(llvm::StringRef(names[n]) == &buffer[offset]);
+    ASSERT_EQ(dynstr.getOffset(names[n]), offset);
+  }
+  ASSERT_EQ(size, dynstr.size());
+}
+
+TEST_F(StringTableBuilderTest, append_after_finalize) {
+  // the stubs of relaxation are named after the table is finalized
+  StringTableBuilder strtab(false);
+  strtab.add("foo");
+  ASSERT_EQ(5u, strtab.finalize());
+
+  ASSERT_EQ(5u, strtab.append("__foo_stub"));
+  ASSERT_EQ(16u, strtab.size());
+  ASSERT_EQ(1u, strtab.append("foo"));
+  ASSERT_EQ(5u, strtab.append("__foo_stub"));
+  ASSERT_EQ(0u, strtab.append(""));
+  ASSERT_EQ(16u, strtab.size());
+  ASSERT_EQ(3u, strtab.numOfStrings());
+
+  char buffer[16];
+  strtab.emit(buffer);
+  ASSERT_TRUE(llvm::StringRef("\0foo\0__foo_stub\0", 16) ==
+              llvm::StringRef(buffer, 16));
+}
+
+TEST_F(StringTableBuilderTest, many_strings) {
+  std::vector<std::string> names;
+  for (unsigned int n = 0; n < 1000; ++n)
+    names.push_back("sym" + llvm::utostr(n % 300));
+
+  StringTableBuilder strtab(false);
+  for (size_t n = 0; n < names.size(); ++n)
+    strtab.add(names[n]);
+  uint64_t size = strtab.finalize();
+  ASSERT_EQ(300u, strtab.numOfStrings());
+
+  std::vector<char> buffer(size);
+  strtab.emit(buffer.data());
+  for (size_t n = names.size(); n > 0; --n) {
+    ASSERT_TRUE(names[n - 1] == &buffer[strtab.getOffset(names[n - 1])]);
+  }
+}
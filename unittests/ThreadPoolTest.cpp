@@ -0,0 +1,67 @@
+//===- ThreadPoolTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/ThreadPool.h"
+#include "ThreadPoolTest.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+ThreadPoolTest::ThreadPoolTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ThreadPoolTest::~ThreadPoolTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ThreadPoolTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void ThreadPoolTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ThreadPoolTest, async_and_wait) {
+  ThreadPool pool(4);
+  ASSERT_EQ(4u, pool.size());
+
+  std::atomic<unsigned int> counter(0);
+  for (unsigned int i = 0; i < 1000; ++i)
+    pool.async([&counter]() { ++counter; });
+  pool.wait();
+  ASSERT_EQ(1000u, counter.load());
+
+  // the pool can be reused after wait()
+  for (unsigned int i = 0; i < 10; ++i)
+    pool.async([&counter]() { ++counter; });
+  pool.wait();
+  ASSERT_EQ(1010u, counter.load());
+}
+
+TEST_F(ThreadPoolTest, parallelFor_visits_each_index_once) {
+  ThreadPool pool(3);
+  std::vector<unsigned int> hits(1000, 0);
+  pool.parallelFor(0, hits.size(), [&hits](size_t pIdx) { ++hits[pIdx]; }, 7);
+
+  for (size_t i = 0; i < hits.size(); ++i)
+    ASSERT_EQ(1u, hits[i]);
+}
+
+TEST_F(ThreadPoolTest, wait_on_idle_pool) {
+  ThreadPool pool(2);
+  pool.wait();
+  pool.parallelFor(5, 5, [](size_t pIdx) { FAIL(); });
+}
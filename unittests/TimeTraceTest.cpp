@@ -0,0 +1,90 @@
+//===- TimeTraceTest.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LinkContext.h"
+#include "mcld/Support/TimeTrace.h"
+#include "TimeTraceTest.h"
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+TimeTraceTest::TimeTraceTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+TimeTraceTest::~TimeTraceTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void TimeTraceTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void TimeTraceTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(TimeTraceTest, disabled_trace_records_nothing) {
+  LinkContext context;
+  LinkContext::Scope scope(context);
+  {
+    TimeTrace::Scope trace("phase");
+  }
+  ASSERT_TRUE(TimeTrace::current().events().empty());
+}
+
+TEST_F(TimeTraceTest, scopes_nest) {
+  LinkContext context;
+  LinkContext::Scope scope(context);
+  TimeTrace::current().enable();
+  {
+    TimeTrace::Scope outer("layout");
+    for (int i = 0; i < 3; ++i)
+      TimeTrace::Scope inner("doRelax");
+  }
+
+  const TimeTrace::EventList& events = TimeTrace::current().events();
+  ASSERT_EQ(4u, events.size());
+  ASSERT_EQ("layout", events[0].name);
+  ASSERT_EQ(0u, events[0].depth);
+  ASSERT_EQ("doRelax", events[3].name);
+  ASSERT_EQ(1u, events[3].depth);
+  ASSERT_LE(events[0].start, events[1].start);
+  ASSERT_GE(events[0].wall, events[3].wall);
+
+  // repeated passes are merged into one row of the summary
+  std::string summary;
+  llvm::raw_string_ostream summary_os(summary);
+  TimeTrace::current().printSummary(summary_os);
+  summary_os.flush();
+  ASSERT_NE(std::string::npos, summary.find("      3    doRelax\n"));
+}
+
+TEST_F(TimeTraceTest, json_escapes_details) {
+  LinkContext context;
+  LinkContext::Scope scope(context);
+  TimeTrace::current().enable();
+  {
+    TimeTrace::Scope trace("read", "dir\\\"a.o\"");
+  }
+
+  std::string json;
+  llvm::raw_string_ostream json_os(json);
+  TimeTrace::current().printJSON(json_os);
+  json_os.flush();
+  ASSERT_EQ(0u, json.find("{\"traceEvents\":["));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"read\""));
+  ASSERT_NE(std::string::npos, json.find("\"detail\":\"dir\\\\\\\"a.o\\\"\""));
+}
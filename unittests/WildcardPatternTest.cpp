@@ -0,0 +1,143 @@
+//===- WildcardPatternTest.cpp --------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Script/WildcardPattern.h"
+#include "WildcardPatternTest.h"
+
+#include <fnmatch.h>
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+WildcardPatternTest::WildcardPatternTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+WildcardPatternTest::~WildcardPatternTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void WildcardPatternTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void WildcardPatternTest::TearDown() {
+}
+
+static const char* g_Names[] = {
+  "",             ".text",         ".text.hot",    ".text.hot.f",
+  ".rela.text",   ".data",         ".data.rel.ro", ".ctors",
+  ".ctors.65535", "crtbegin.o",    "crtend.o",     "main.o",
+  "text",         ".t",            ".tt",          ".text.unlikely",
+  "*",            "a*b?c",         ".init_array",  ".init_array.00100"
+};
+
+/// matchesAsFnmatch - whether pPattern matches every name the way
+/// fnmatch() does
+static bool matchesAsFnmatch(const std::string& pPattern) {
+  WildcardPattern* pattern =
+      WildcardPattern::create(pPattern, WildcardPattern::SORT_NONE);
+  bool same = true;
+  for (size_t n = 0; n < sizeof(g_Names) / sizeof(g_Names[0]); ++n) {
+    bool expected = (fnmatch(pPattern.c_str(), g_Names[n], 0) == 0);
+    if (pattern->matches(g_Names[n]) != expected) {
+      ADD_FAILURE() << "pattern '" << pPattern << "' on '" << g_Names[n]
+                    << "' should be " << expected;
+      same = false;
+    }
+  }
+  return same;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(WildcardPatternTest, literal) {
+  WildcardPattern* pattern =
+      WildcardPattern::create(".text", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_LITERAL, pattern->matchKind());
+  ASSERT_TRUE(pattern->prefix() == ".text");
+  ASSERT_TRUE(matchesAsFnmatch(".text"));
+  ASSERT_TRUE(matchesAsFnmatch(""));
+}
+
+TEST_F(WildcardPatternTest, prefix) {
+  WildcardPattern* pattern =
+      WildcardPattern::create(".text.*", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_PREFIX, pattern->matchKind());
+  ASSERT_TRUE(pattern->isPrefix());
+  ASSERT_TRUE(pattern->prefix() == ".text.");
+  ASSERT_TRUE(matchesAsFnmatch(".text.*"));
+  ASSERT_TRUE(matchesAsFnmatch(".ctors*"));
+  ASSERT_TRUE(matchesAsFnmatch("crt**"));
+}
+
+TEST_F(WildcardPatternTest, suffix) {
+  WildcardPattern* pattern =
+      WildcardPattern::create("*.text", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_SUFFIX, pattern->matchKind());
+  ASSERT_TRUE(pattern->prefix().empty());
+  ASSERT_TRUE(matchesAsFnmatch("*.text"));
+  ASSERT_TRUE(matchesAsFnmatch("*.o"));
+  ASSERT_TRUE(matchesAsFnmatch("**t"));
+}
+
+TEST_F(WildcardPatternTest, contains) {
+  WildcardPattern* pattern =
+      WildcardPattern::create("*hot*", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_CONTAINS, pattern->matchKind());
+  ASSERT_FALSE(pattern->matchesAll());
+  ASSERT_TRUE(matchesAsFnmatch("*hot*"));
+  ASSERT_TRUE(matchesAsFnmatch("*.rel*"));
+
+  WildcardPattern* all =
+      WildcardPattern::create("*", WildcardPattern::SORT_NONE);
+  ASSERT_TRUE(all->matchesAll());
+  ASSERT_TRUE(matchesAsFnmatch("*"));
+  ASSERT_TRUE(matchesAsFnmatch("**"));
+}
+
+TEST_F(WildcardPatternTest, question_mark) {
+  WildcardPattern* pattern =
+      WildcardPattern::create(".?", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_GLOB, pattern->matchKind());
+  ASSERT_TRUE(pattern->prefix() == ".");
+  ASSERT_TRUE(matchesAsFnmatch(".?"));
+  ASSERT_TRUE(matchesAsFnmatch("?"));
+  ASSERT_TRUE(matchesAsFnmatch(".t?xt"));
+  ASSERT_TRUE(matchesAsFnmatch("crt???.o"));
+  ASSERT_TRUE(matchesAsFnmatch("?*"));
+}
+
+TEST_F(WildcardPatternTest, many_stars) {
+  WildcardPattern* pattern =
+      WildcardPattern::create(".text*hot*", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_GLOB, pattern->matchKind());
+  ASSERT_TRUE(pattern->prefix() == ".text");
+  ASSERT_TRUE(matchesAsFnmatch(".text*hot*"));
+  ASSERT_TRUE(matchesAsFnmatch("*.*.*"));
+  ASSERT_TRUE(matchesAsFnmatch("*t*t*"));
+  ASSERT_TRUE(matchesAsFnmatch(".*a*.0*"));
+  ASSERT_TRUE(matchesAsFnmatch("*rel*o"));
+  ASSERT_TRUE(matchesAsFnmatch("c*.*"));
+}
+
+TEST_F(WildcardPatternTest, brackets) {
+  WildcardPattern* pattern =
+      WildcardPattern::create("crt[be]*.o", WildcardPattern::SORT_NONE);
+  ASSERT_EQ(WildcardPattern::MATCH_FNMATCH, pattern->matchKind());
+  ASSERT_TRUE(pattern->prefix() == "crt");
+  ASSERT_TRUE(matchesAsFnmatch("crt[be]*.o"));
+  ASSERT_TRUE(matchesAsFnmatch(".[a-d]*"));
+  ASSERT_TRUE(matchesAsFnmatch("*[!o]"));
+  ASSERT_TRUE(matchesAsFnmatch("a\\*b?c"));
+  ASSERT_TRUE(matchesAsFnmatch("\\*"));
+}